@@ -40,6 +40,17 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 	Resources.Sort(SortByResourceType);
 	ConsumerResources.Sort(SortByResourceType);
 	MaintenanceResources.Sort(SortByResourceType);
+
+	// Give each resource its index in the sorted list
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		Resources[Index]->Data.CatalogIndex = Index;
+
+		if (!ResourcesByIdentifier.Contains(Resources[Index]->Data.Identifier))
+		{
+			ResourcesByIdentifier.Add(Resources[Index]->Data.Identifier, Resources[Index]);
+		}
+	}
 }
 
 
@@ -49,15 +60,10 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 
 FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareResourceCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareResourceCatalogEntry* const* Entry = Resources.FindByPredicate(FindByName);
-	if (Entry && *Entry)
+	UFlareResourceCatalogEntry* Entry = ResourcesByIdentifier.FindRef(Identifier);
+	if (Entry)
 	{
-		return &((*Entry)->Data);
+		return &Entry->Data;
 	}
 
 	return NULL;
@@ -65,12 +71,9 @@ FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 
 UFlareResourceCatalogEntry* UFlareResourceCatalog::GetEntry(FFlareResourceDescription* Resource) const
 {
-	for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+	if (Resource && Resources.IsValidIndex(Resource->CatalogIndex) && Resource == &Resources[Resource->CatalogIndex]->Data)
 	{
-		if(Resource == &Resources[ResourceIndex]->Data)
-		{
-			return Resources[ResourceIndex];
-		}
+		return Resources[Resource->CatalogIndex];
 	}
 	return NULL;
 }
@@ -45,6 +45,21 @@ public:
 		return Resources;
 	}
 
+	/** Get the number of resources, per-resource arrays have this size */
+	int32 GetResourceCount() const
+	{
+		return Resources.Num();
+	}
+
+protected:
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Resources by identifier */
+	TMap<FName, UFlareResourceCatalogEntry*> ResourcesByIdentifier;
+
 };
 
 inline static bool SortByResourceType(const UFlareResourceCatalogEntry& ResourceA, const UFlareResourceCatalogEntry& ResourceB)
@@ -6,7 +6,9 @@
 
 #include "../Data/FlareResourceCatalog.h"
 
+#include "../Game/FlareCompany.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareWorld.h"
 #include "../Quests/FlareQuestManager.h"
 
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
@@ -191,6 +193,8 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		return 0;
 	}
 
+	InvalidateResourceStats();
+
 	// First pass: take resource from the less full cargo
 	int32 MinQuantity = 0;
 	FFlareCargo* MinQuantityCargo = NULL;
@@ -225,16 +229,11 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			{
 				MinQuantityCargo->Resource = NULL;
 			}
-
-			if (QuantityToTake == 0)
-			{
-				return Quantity;
-			}
 		}
 	}
 
 
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() && QuantityToTake > 0; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
 		if (Cargo.Resource == Resource)
@@ -254,24 +253,30 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 				{
 					Cargo.Resource = NULL;
 				}
-
-				if (QuantityToTake == 0)
-				{
-					return Quantity;
-				}
 			}
 		}
 	}
-	return Quantity - QuantityToTake;
+
+	int32 TakenQuantity = Quantity - QuantityToTake;
+	Parent->GetCompany()->AddStockValue(Parent, Resource, -TakenQuantity);
+	if (TakenQuantity > 0)
+	{
+		Parent->SetSaveDirty();
+	}
+	return TakenQuantity;
 }
 
 void UFlareCargoBay::DumpCargo(FFlareCargo* Cargo)
 {
+	InvalidateResourceStats();
+	Parent->GetCompany()->AddStockValue(Parent, Cargo->Resource, -Cargo->Quantity);
+
 	Cargo->Quantity = 0;
 	if (Cargo->Lock == EFlareResourceLock::NoLock)
 	{
 		Cargo->Resource = NULL;
 	}
+	Parent->SetSaveDirty();
 }
 
 int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client)
@@ -283,8 +288,10 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 		return Quantity;
 	}
 
+	InvalidateResourceStats();
+
 	// First pass, fill already existing slots
-	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() && QuantityToGive > 0; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
 		if (Resource == Cargo.Resource)
@@ -301,17 +308,12 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			{
 				Cargo.Quantity += GivenQuantity;
 				QuantityToGive -= GivenQuantity;
-
-				if (QuantityToGive == 0)
-				{
-					return Quantity;
-				}
 			}
 		}
 	}
 
 	// Fill free cargo slots
-	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	for (int CargoIndex = 0 ; CargoIndex < CargoBay.Num() && QuantityToGive > 0; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
 		if (Cargo.Resource == NULL)
@@ -329,11 +331,6 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 				Cargo.Resource = Resource;
 
 				QuantityToGive -= GivenQuantity;
-
-				if (QuantityToGive == 0)
-				{
-					return Quantity;
-				}
 			}
 			else
 			{
@@ -343,7 +340,23 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 		}
 	}
 
-	return Quantity - QuantityToGive;
+	int32 GivenQuantity = Quantity - QuantityToGive;
+	Parent->GetCompany()->AddStockValue(Parent, Resource, GivenQuantity);
+	if (GivenQuantity > 0)
+	{
+		Parent->SetSaveDirty();
+	}
+	return GivenQuantity;
+}
+
+
+void UFlareCargoBay::InvalidateResourceStats()
+{
+	// Only station cargo is part of the resource stats
+	if (Parent->IsStation() && Game->GetGameWorld())
+	{
+		Game->GetGameWorld()->InvalidateResourceStats(Parent->GetCurrentSector());
+	}
 }
 
 
@@ -426,6 +439,32 @@ int32 UFlareCargoBay::GetResourceQuantity(FFlareResourceDescription* Resource, U
 
 }
 
+void UFlareCargoBay::GetResourceQuantities(TArray<int32>& Quantities, UFlareCompany* Client) const
+{
+	TArray<UFlareResourceCatalogEntry*>& Resources = Parent->GetGame()->GetResourceCatalog()->Resources;
+
+	Quantities.Reset(Resources.Num());
+	Quantities.AddZeroed(Resources.Num());
+
+	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	{
+		const FFlareCargo& Cargo = CargoBay[CargoIndex];
+		if (Cargo.Resource && CheckRestriction(&Cargo, Client))
+		{
+			Quantities[Cargo.Resource->CatalogIndex] += Cargo.Quantity;
+		}
+	}
+
+	if((Client && !Client->IsPlayerCompany())  && Parent->GetGame()->GetQuestManager() != nullptr)
+	{
+		for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+		{
+			int32 ReservedQuantity = Parent->GetGame()->GetQuestManager()->GetReservedQuantity(Parent, &Resources[ResourceIndex]->Data);
+			Quantities[ResourceIndex] = FMath::Max(0, Quantities[ResourceIndex] - ReservedQuantity);
+		}
+	}
+}
+
 int32 UFlareCargoBay::GetFreeSpaceForResource(FFlareResourceDescription* Resource, UFlareCompany* Client, bool LockOnly) const
 {
 	int32 Quantity = 0;
@@ -535,6 +574,9 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 		return false;
 	}
 
+	InvalidateResourceStats();
+	Parent->SetSaveDirty();
+
 	//Check double lock
 	for(FFlareCargo& Cargo : CargoBay)
 	{
@@ -574,6 +616,8 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 
 void UFlareCargoBay::HideUnlockedSlots()
 {
+	Parent->SetSaveDirty();
+
 	for(FFlareCargo& Cargo : CargoBay)
 	{
 		if(Cargo.Lock == EFlareResourceLock::NoLock)
@@ -586,6 +630,9 @@ void UFlareCargoBay::HideUnlockedSlots()
 
 void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 {
+	InvalidateResourceStats();
+	Parent->SetSaveDirty();
+
 	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
 	{
 		FFlareCargo& Cargo = CargoBay[CargoIndex];
@@ -615,6 +662,7 @@ void UFlareCargoBay::SetSlotRestriction(int32 SlotIndex, EFlareResourceRestricti
 		FLOGV("Invalid index %d for set slot restriction (cargo bay size: %d)", SlotIndex, CargoBay.Num());
 	}
 	CargoBay[SlotIndex].Restriction = RestrictionType;
+	Parent->SetSaveDirty();
 }
 
 bool UFlareCargoBay::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client, bool RequireStock) const
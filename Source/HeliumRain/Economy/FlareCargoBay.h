@@ -60,6 +60,9 @@ public:
 
 protected:
 
+	/** Tell the world this sector stock changed */
+	void InvalidateResourceStats();
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -95,6 +98,9 @@ public:
 	/* If client is not null, consider as not identified company*/
 	int32 GetResourceQuantity(FFlareResourceDescription* Resource, UFlareCompany* Client) const;
 
+	/* Same as GetResourceQuantity for all resources at once, by resource catalog index */
+	void GetResourceQuantities(TArray<int32>& Quantities, UFlareCompany* Client) const;
+
 	/* If client is not null, consider as not identified company*/
 	int32 GetFreeSpaceForResource(FFlareResourceDescription* Resource, UFlareCompany* Client, bool LockOnly = false) const;
 
@@ -79,6 +79,7 @@ void UFlareFactory::Simulate()
 		if (FactoryData.ProductedDuration < GetProductionTime(GetCycleData()))
 		{
 			FactoryData.ProductedDuration += 1;
+			Parent->SetSaveDirty();
 		}
 
 		if (FactoryData.ProductedDuration < GetProductionTime(GetCycleData()))
@@ -153,6 +154,8 @@ void UFlareFactory::Start()
 	}
 
 	FactoryData.Active = true;
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
@@ -162,6 +165,7 @@ void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 		FactoryData.TargetShipClass = Order.ShipClass;
 		FactoryData.TargetShipCompany = Order.Company;
 		FactoryData.ProductedDuration = 0;
+		Parent->SetSaveDirty();
 
 		Parent->GetCompany()->GiveMoney(Order.AdvancePayment, FFlareTransactionLogEntry::LogShipOrderAdvance(GetParent(), Order.Company, Order.ShipClass));
 	}
@@ -172,22 +176,29 @@ void UFlareFactory::StartShipBuilding(FFlareShipyardOrderSave& Order)
 void UFlareFactory::Pause()
 {
 	FactoryData.Active = false;
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::Stop()
 {
 	FactoryData.Active = false;
 	CancelProduction();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::SetInfiniteCycle(bool Mode)
 {
 	FactoryData.InfiniteCycle = Mode;
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::SetCycleCount(uint32 Count)
 {
 	FactoryData.CycleCount = Count;
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::SetOutputLimit(FFlareResourceDescription* Resource, uint32 MaxSlot)
@@ -210,6 +221,8 @@ void UFlareFactory::SetOutputLimit(FFlareResourceDescription* Resource, uint32 M
 		NewCargoLimit.Quantity = MaxSlot;
 		FactoryData.OutputCargoLimit.Add(NewCargoLimit);
 	}
+
+	Parent->SetSaveDirty();
 }
 
 void UFlareFactory::ClearOutputLimit(FFlareResourceDescription* Resource)
@@ -219,6 +232,7 @@ void UFlareFactory::ClearOutputLimit(FFlareResourceDescription* Resource)
 		if (FactoryData.OutputCargoLimit[CargoLimitIndex].ResourceIdentifier == Resource->Identifier)
 		{
 			FactoryData.OutputCargoLimit.RemoveAt(CargoLimitIndex);
+			Parent->SetSaveDirty();
 			return;
 		}
 	}
@@ -397,6 +411,9 @@ void UFlareFactory::BeginProduction()
 			FLOGV("Fail to take %d resource '%s' to %s", Resource->Quantity, *Resource->Resource->Data.Name.ToString(), *Parent->GetImmatriculation().ToString());
 		}
 
+		// Reserved resources are still part of the company stock
+		Parent->GetCompany()->AddStockValue(Parent, &Resource->Resource->Data, ResourceToTake);
+
 		if (AlreadyReservedCargo)
 		{
 			AlreadyReservedCargo->Quantity += ResourceToTake;
@@ -411,6 +428,7 @@ void UFlareFactory::BeginProduction()
 	}
 
 	FactoryData.CostReserved = GetProductionCost();
+	Parent->SetSaveDirty();
 }
 
 void UFlareFactory::CancelProduction()
@@ -424,6 +442,7 @@ void UFlareFactory::CancelProduction()
 		FFlareResourceDescription*Resource = Game->GetResourceCatalog()->Get(FactoryData.ResourceReserved[ReservedResourceIndex].ResourceIdentifier);
 
 		int32 GivenQuantity = Parent->GetActiveCargoBay()->GiveResources(Resource, FactoryData.ResourceReserved[ReservedResourceIndex].Quantity, Parent->GetCompany());
+		Parent->GetCompany()->AddStockValue(Parent, Resource, -GivenQuantity);
 
 		if (GivenQuantity >= FactoryData.ResourceReserved[ReservedResourceIndex].Quantity)
 		{
@@ -445,6 +464,9 @@ void UFlareFactory::CancelProduction()
 		FactoryData.Active = false;
 		Parent->UpdateShipyardProduction();
 	}
+
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 void UFlareFactory::DoProduction()
@@ -465,6 +487,9 @@ void UFlareFactory::DoProduction()
 				continue;
 			}
 
+			int32 ConsumedQuantity = FMath::Min(Resource->Quantity, FactoryData.ResourceReserved[ReservedResourceIndex].Quantity);
+			Parent->GetCompany()->AddStockValue(Parent, &Resource->Resource->Data, -ConsumedQuantity);
+
 			if (Resource->Quantity >= FactoryData.ResourceReserved[ReservedResourceIndex].Quantity)
 			{
 				FactoryData.ResourceReserved.RemoveAt(ReservedResourceIndex);
@@ -519,6 +544,9 @@ void UFlareFactory::DoProduction()
 	{
 		FactoryData.CycleCount--;
 	}
+
+	Parent->SetSaveDirty();
+	InvalidateResourceStats();
 }
 
 FFlareWorldEvent *UFlareFactory::GenerateEvent()
@@ -670,6 +698,14 @@ void UFlareFactory::NotifyNoMoreSector()
 			Data);
 }
 
+void UFlareFactory::InvalidateResourceStats()
+{
+	if (Game->GetGameWorld())
+	{
+		Game->GetGameWorld()->InvalidateResourceStats(Parent->GetCurrentSector());
+	}
+}
+
 void UFlareFactory::PerformDiscoverSectorAction(const FFlareFactoryAction* Action)
 {
 	UFlareCompany* Company = Parent->GetCompany();
@@ -777,18 +813,20 @@ void UFlareFactory::PerformBuildStationAction(const FFlareFactoryAction* Action)
 
 const FFlareProductionData& UFlareFactory::GetCycleData()
 {
+	int32 CycleLevel = Parent->IsUnderConstruction() ? 1 : Parent->GetLevel();
+
 	if (IsShipyard() && FactoryData.TargetShipClass != NAME_None)
 	{
 		return GetCycleDataForShipClass(FactoryData.TargetShipClass);
 	}
-	else if (Parent->GetLevel() == CycleCostCacheLevel)
+	else if (CycleLevel == CycleCostCacheLevel)
 	{
 		return CycleCostCache;
 	}
 	else
 	{
 
-		CycleCostCacheLevel = Parent->IsUnderConstruction() ? 1 : Parent->GetLevel();
+		CycleCostCacheLevel = CycleLevel;
 		CycleCostCache.ProductionTime = FactoryDescription->CycleCost.ProductionTime;
 		CycleCostCache.ProductionCost = FactoryDescription->CycleCost.ProductionCost * CycleCostCacheLevel;
 		CycleCostCache.InputResources = FactoryDescription->CycleCost.InputResources;
@@ -833,9 +871,7 @@ uint32 UFlareFactory::GetProductionCost(const FFlareProductionData* Data)
 	const FFlareProductionData* CycleData = Data ? Data : &GetCycleData();
 	FCHECK(CycleData);
 
-	ScaledProductionCost = CycleData->ProductionCost;
-	
-	return ScaledProductionCost;
+	return CycleData->ProductionCost;
 }
 
 int64 UFlareFactory::GetRemainingProductionDuration()
@@ -83,6 +83,9 @@ public:
 
 protected:
 
+	/** Tell the world this sector production changed */
+	void InvalidateResourceStats();
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -96,7 +99,6 @@ protected:
 
 	UFlareSimulatedSpacecraft*				 Parent;
 	FFlareWorldEvent                         NextEvent;
-	uint32                                   ScaledProductionCost;
 	FFlareProductionData CycleCostCache;
 	int32 CycleCostCacheLevel;
 
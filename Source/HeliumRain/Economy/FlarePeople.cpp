@@ -28,6 +28,9 @@
 
 UFlarePeople::UFlarePeople(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, DeferEffects(false)
+	, DeferredPopulationCheck(false)
+	, DeferredWorldMoney(0)
 {
 }
 
@@ -81,15 +84,23 @@ static float TECH_SADNESS = 1;
 
 static int32 MIN_GENERAL_STOCK = 1000;
 
-void UFlarePeople::Simulate()
+void UFlarePeople::Simulate(bool Deferred)
 {
 	if(PeopleData.Population == 0)
 	{
-		CheckPopulationDisparition();
+		// The world population is only known once every sector is done
+		if (Deferred)
+		{
+			DeferredPopulationCheck = true;
+		}
+		else
+		{
+			CheckPopulationDisparition();
+		}
 		return;
 	}
 
-
+	DeferEffects = Deferred;
 	SimulateResourcePurchase();
 
 	float Happiness = GetHappiness();
@@ -173,6 +184,27 @@ void UFlarePeople::Simulate()
 
 	Hunger = TechConsumption - EatenTech;
 	DecreaseHappiness(Hunger * TECH_SADNESS);
+
+	DeferEffects = false;
+}
+
+void UFlarePeople::ApplyDeferredEffects()
+{
+	Game->GetGameWorld()->WorldMoneyReference += DeferredWorldMoney;
+	DeferredWorldMoney = 0;
+
+	// Keep the order of the purchases, as a serial simulation would
+	for (FFlarePeoplePayment& Payment : DeferredPayments)
+	{
+		Payment.Company->GiveMoney(Payment.Amount, Payment.TransactionContext);
+	}
+	DeferredPayments.Empty();
+
+	if (DeferredPopulationCheck)
+	{
+		DeferredPopulationCheck = false;
+		CheckPopulationDisparition();
+	}
 }
 
 void UFlarePeople::SimulateResourcePurchase()
@@ -419,7 +451,19 @@ uint32 UFlarePeople::BuyInStationForCompany(FFlareResourceDescription* Resource,
 		RemainingQuantity -= TakenQuantity;
 		uint32 Price = (uint32) (ResourcePrice) * TakenQuantity;
 		PeopleData.Money -= Price;
-		Company->GiveMoney(Price, FFlareTransactionLogEntry::LogPeoplePurchase(BestStation, Resource, TakenQuantity));
+
+		if (DeferEffects)
+		{
+			FFlarePeoplePayment Payment;
+			Payment.Company = Company;
+			Payment.Amount = Price;
+			Payment.TransactionContext = FFlareTransactionLogEntry::LogPeoplePurchase(BestStation, Resource, TakenQuantity);
+			DeferredPayments.Add(Payment);
+		}
+		else
+		{
+			Company->GiveMoney(Price, FFlareTransactionLogEntry::LogPeoplePurchase(BestStation, Resource, TakenQuantity));
+		}
 
 	}
 
@@ -538,7 +582,14 @@ void UFlarePeople::GiveBirth(uint32 BirthCount)
 	// Money creation
 	uint32 NewMoney = BirthCount * MONETARY_CREATION;
 	PeopleData.Money += NewMoney;
-	Game->GetGameWorld()->WorldMoneyReference += NewMoney;
+	if (DeferEffects)
+	{
+		DeferredWorldMoney += NewMoney;
+	}
+	else
+	{
+		Game->GetGameWorld()->WorldMoneyReference += NewMoney;
+	}
 
 	IncreaseHappiness(BirthCount * 100 * 2);
 	PeopleData.HappinessPoint += BirthCount * 100 * 2; // Birth happiness bonus
@@ -594,7 +645,14 @@ void UFlarePeople::KillPeople(uint32 KillCount)
 	// Money destruction (delayed, really destroy on Pay)
 	uint32 DestroyedMoney = PeopleToKill * MONETARY_CREATION;
 	PeopleData.Dept += DestroyedMoney;
-	Game->GetGameWorld()->WorldMoneyReference -= DestroyedMoney;
+	if (DeferEffects)
+	{
+		DeferredWorldMoney -= DestroyedMoney;
+	}
+	else
+	{
+		Game->GetGameWorld()->WorldMoneyReference -= DestroyedMoney;
+	}
 
 	DecreaseHappiness(PeopleToKill * 100 * 2); // Death happiness malus
 
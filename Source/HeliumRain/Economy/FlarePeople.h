@@ -4,6 +4,7 @@
 #include "FlarePeople.generated.h"
 
 class AFlareGame;
+class UFlareCompany;
 class UFlareSimulatedSector;
 class UFlareSimulatedSpacecraft;
 struct FFlareResourceDescription;
@@ -79,6 +80,14 @@ struct FFlarePeopleSave
 	float TechConsumption;
 };
 
+/** Money given to a company by a deferred people simulation */
+struct FFlarePeoplePayment
+{
+	UFlareCompany*                           Company;
+	int64                                    Amount;
+	FFlareTransactionLogEntry                TransactionContext;
+};
+
 
 
 UCLASS()
@@ -101,7 +110,11 @@ public:
 	   Gameplay
 	----------------------------------------------------*/
 
-	void Simulate();
+	/** Simulate a day. When deferred, the changes outside of this sector are kept until ApplyDeferredEffects, so that sectors can be simulated in parallel */
+	void Simulate(bool Deferred = false);
+
+	/** Give the money kept by a deferred simulation, and check the population of a deferred empty sector */
+	void ApplyDeferredEffects();
 
 	void SimulateResourcePurchase();
 
@@ -147,6 +160,12 @@ protected:
 	AFlareGame*                              Game;
 	UFlareSimulatedSector*   				 Parent;
 
+	// Deferred simulation
+	bool                                     DeferEffects;
+	bool                                     DeferredPopulationCheck;
+	int64                                    DeferredWorldMoney;
+	TArray<FFlarePeoplePayment>              DeferredPayments;
+
 public:
 
 	/*----------------------------------------------------
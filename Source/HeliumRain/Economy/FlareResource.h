@@ -53,6 +53,9 @@ struct FFlareResourceDescription
 	/** Display sorting index */
 	UPROPERTY(EditAnywhere, Category = Content)
 	float DisplayIndex;
+
+	/** Index in the resource catalog, used to store per-resource data in arrays */
+	int32 CatalogIndex = INDEX_NONE;
 };
 
 /** Spacecraft cargo data */
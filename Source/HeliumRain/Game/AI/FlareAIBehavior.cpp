@@ -318,7 +318,8 @@ void UFlareAIBehavior::SimulatePirateBehavior()
 void UFlareAIBehavior::GenerateAffilities()
 {
 	// Reset resource affilities
-	ResourceAffilities.Empty();
+	ResourceAffilities.Empty(Game->GetResourceCatalog()->Resources.Num());
+	ResourceAffilities.AddZeroed(Game->GetResourceCatalog()->Resources.Num());
 	
 	// Default behavior
 	SetResourceAffilities(1.f);
@@ -555,13 +556,7 @@ void UFlareAIBehavior::SetResourceAffilities(float Value)
 
 void UFlareAIBehavior::SetResourceAffility(FFlareResourceDescription* Resource, float Value)
 {
-	if(ResourceAffilities.Contains(Resource)){
-		ResourceAffilities[Resource] = Value;
-	}
-	else
-	{
-		ResourceAffilities.Add(Resource, Value);
-	}
+	ResourceAffilities[Resource->CatalogIndex] = Value;
 }
 
 
@@ -636,9 +631,9 @@ float UFlareAIBehavior::GetSectorAffility(UFlareSimulatedSector* Sector)
 
 float UFlareAIBehavior::GetResourceAffility(FFlareResourceDescription* Resource)
 {
-	if(ResourceAffilities.Contains(Resource))
+	if(ResourceAffilities.IsValidIndex(Resource->CatalogIndex))
 	{
-		return ResourceAffilities[Resource];
+		return ResourceAffilities[Resource->CatalogIndex];
 	}
 	return 1.f;
 }
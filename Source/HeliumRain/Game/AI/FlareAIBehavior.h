@@ -68,7 +68,8 @@ protected:
 	UFlareScenarioTools*                   ST;
 
 
-	TMap<FFlareResourceDescription*, float> ResourceAffilities;
+	/** Affilities by resource catalog index */
+	TArray<float>                          ResourceAffilities;
 	TMap<UFlareSimulatedSector*, float> SectorAffilities;
 
 public:
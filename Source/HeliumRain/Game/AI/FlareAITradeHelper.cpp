@@ -347,8 +347,8 @@ SectorDeal AITradeHelper::FindBestDealForShipToSector(UFlareSimulatedSpacecraft*
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[Resource];
-		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[Resource];
+		struct ResourceVariation const* VariationA = &SectorVariationA->ResourceVariations[Resource->CatalogIndex];
+		struct ResourceVariation const* VariationB = &SectorVariationB->ResourceVariations[Resource->CatalogIndex];
 
 		//FLOGV("- Check for %s", *Resource->Name.ToString());
 
@@ -718,7 +718,7 @@ SectorDeal AITradeHelper::FindBestDealForShip(UFlareSimulatedSpacecraft* Ship, T
 				int32 UsedIncomingCapacity = FMath::Min(SectorBestDeal.BuyQuantity, SectorVariationA->IncomingCapacity);
 
 				SectorVariationA->IncomingCapacity -= UsedIncomingCapacity;
-				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource];
+				struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[SectorBestDeal.Resource->CatalogIndex];
 				VariationA->OwnedStock -= UsedIncomingCapacity;
 			}
 			else
@@ -850,7 +850,7 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 				{
 					// Virtualy decrease the stock for other ships in sector A
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationA->OwnedStock -= BroughtResource;
 
 
@@ -859,14 +859,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 					SectorVariationB->IncomingCapacity += BroughtResource;
 
 					// Virtualy decrease the capacity for other ships in sector B
-					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationB->OwnedCapacity -= BroughtResource;
 				}
 				else if (BroughtResource == 0)
 				{
 					// Failed to buy the promised resources, remove the deal from the list
 					SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+					struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 					VariationA->FactoryStock = 0;
 					VariationA->OwnedStock = 0;
 					VariationA->StorageStock = 0;
@@ -913,14 +913,14 @@ void AITradeHelper::ApplyDeal(UFlareSimulatedSpacecraft* Ship, SectorDeal const&
 		{
 			// Reserve the deal by virtualy decrease the stock for other ships
 			SectorVariation* SectorVariationA = &(*WorldResourceVariation)[Deal.SectorA];
-			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationA = &SectorVariationA->ResourceVariations[Deal.Resource->CatalogIndex];
 			VariationA->OwnedStock -= Deal.BuyQuantity;
 			// Virtualy say some capacity arrive in sector B
 			SectorVariation* SectorVariationB = &(*WorldResourceVariation)[Deal.SectorB];
 			SectorVariationB->IncomingCapacity += Deal.BuyQuantity;
 
 			// Virtualy decrease the capacity for other ships in sector B
-			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource];
+			struct ResourceVariation* VariationB = &SectorVariationB->ResourceVariations[Deal.Resource->CatalogIndex];
 			VariationB->OwnedCapacity -= Deal.BuyQuantity;
 		}
 	}
@@ -1004,9 +1004,9 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 #endif
 
 	SectorVariation SectorVariation;
+	SectorVariation.ResourceVariations.Reserve(Game->GetResourceCatalog()->Resources.Num());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
 		struct ResourceVariation ResourceVariation;
 		ResourceVariation.OwnedFlow = 0;
 		ResourceVariation.FactoryFlow = 0;
@@ -1024,7 +1024,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		ResourceVariation.MaintenanceMaxStock = 0;
 		ResourceVariation.HighPriority = 0;
 
-		SectorVariation.ResourceVariations.Add(Resource, ResourceVariation);
+		SectorVariation.ResourceVariations.Add(ResourceVariation);
 	}
 
 	int32 OwnedCustomerStation = 0;
@@ -1053,7 +1053,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 			int32 Stock = 0;
 			int32 Capacity = 0;
@@ -1154,7 +1154,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1195,7 +1195,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1242,7 +1242,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				Variation->ConsumerMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
 			}
@@ -1254,7 +1254,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 
 				Variation->MaintenanceMaxStock += Station->GetActiveCargoBay()->GetSlotCapacity();
@@ -1267,7 +1267,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 			for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 				int32 ResourceQuantity = Station->GetActiveCargoBay()->GetResourceQuantity(Resource, ClientCompany);
 				int32 MaxCapacity = Station->GetActiveCargoBay()->GetFreeSpaceForResource(Resource, ClientCompany);
@@ -1305,7 +1305,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 
 			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -1354,7 +1354,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 				{
 					continue;
 				}
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource];
+				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource->CatalogIndex];
 
 				Variation->IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
 			}
@@ -1365,7 +1365,7 @@ SectorVariation AITradeHelper::ComputeSectorResourceVariation(UFlareCompany* Com
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
+		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource->CatalogIndex];
 
 		for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
 		{
@@ -1687,26 +1687,63 @@ void AITradeHelper::GenerateIdleShips(AITradeIdleShips& Ships, UFlareWorld* Worl
 #define SourceFunctionCount 18
 #define IdleShipFunctionCount 12
 
+/* Position of a need in the global trading queue */
+struct AITradeNeedHandle
+{
+	int32 Pass;
+	int32 NeedIndex;
+};
+
 void AITradeHelper::ComputeGlobalTrading(UFlareWorld* World, AITradeNeeds& Needs, AITradeSources& Sources, AITradeSources& MaintenanceSources, AITradeIdleShips& IdleShips, AICompaniesMoney& CompaniesMoney)
 {
-	while(Needs.List.Num() > 0)
+	// Needs are served pass after pass, by priority then by ratio. A processed need is pushed back in the next pass,
+	// so a need is only re-keyed when its ratio or source function changed, and needs are never copied
+	auto QueuePredicate = [&Needs](const AITradeNeedHandle& A, const AITradeNeedHandle& B)
 	{
-		Needs.List.Sort(&NeedComparatorComparator);
+		if (A.Pass != B.Pass)
+		{
+			return A.Pass < B.Pass;
+		}
 
-		TArray<AITradeNeed> KeepList;
+		const AITradeNeed& NeedA = Needs.List[A.NeedIndex];
+		const AITradeNeed& NeedB = Needs.List[B.NeedIndex];
 
-		for(AITradeNeed& Need : Needs.List)
+		if (NeedComparatorComparator(NeedA, NeedB))
 		{
-			bool Keep = ProcessNeed(Need, Sources, MaintenanceSources, IdleShips, CompaniesMoney);
-
-			if(Keep)
-			{
-				KeepList.Add(Need);
-			}
+			return true;
+		}
+		else if (NeedComparatorComparator(NeedB, NeedA))
+		{
+			return false;
 		}
 
-		Needs.List = KeepList;
+		// Keep the order stable between runs
+		return A.NeedIndex < B.NeedIndex;
+	};
+
+	TArray<AITradeNeedHandle> Queue;
+	Queue.Reserve(Needs.List.Num());
+	for (int32 NeedIndex = 0; NeedIndex < Needs.List.Num(); NeedIndex++)
+	{
+		Queue.Add({0, NeedIndex});
+	}
+	Queue.Heapify(QueuePredicate);
+
+	while(Queue.Num() > 0)
+	{
+		AITradeNeedHandle Handle;
+		Queue.HeapPop(Handle, QueuePredicate, false);
+
+		bool Keep = ProcessNeed(Needs.List[Handle.NeedIndex], Sources, MaintenanceSources, IdleShips, CompaniesMoney);
+
+		if(Keep)
+		{
+			Handle.Pass++;
+			Queue.HeapPush(Handle, QueuePredicate);
+		}
 	}
+
+	Needs.List.Empty();
 }
 
 
@@ -3531,8 +3568,7 @@ AITradeSources::AITradeSources(UFlareWorld* World)
 
 	for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Resources[ResourceIndex]->Data;
-		SourcesPerResource.Add(Resource, AITradeSourcesByResource(World));
+		SourcesPerResource.Add(AITradeSourcesByResource(World));
 	}
 
 	SourceCount = 0;
@@ -3574,10 +3610,8 @@ void AITradeSources::Print()
 
 void AITradeSources::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerResource : SourcesPerResource)
-	{
-		SourcePerResource.Value.ConsumeSource(Source);
-	}
+	// A source is only registered in its own resource lists
+	SourcesPerResource[Source->Resource->CatalogIndex].ConsumeSource(Source);
 
 #if DEBUG_NEW_AI_TRADING
 	SourcesPtr.Remove(Source);
@@ -3605,8 +3639,13 @@ void AITradeSources::GenerateCache()
 {
 	for(AITradeSource& Source : Sources)
 	{
+		for (int32 SlotIndex = 0; SlotIndex < AITradeListSlot::Count; SlotIndex++)
+		{
+			Source.ListIndices[SlotIndex] = INDEX_NONE;
+		}
+
 		SourceCount++;
-		SourcesPerResource[Source.Resource].Add(&Source);
+		SourcesPerResource[Source.Resource->CatalogIndex].Add(&Source);
 #if DEBUG_NEW_AI_TRADING
 		SourcesPtr.Add(&Source);
 #endif
@@ -3636,19 +3675,19 @@ AITradeSourcesByResource::AITradeSourcesByResource(UFlareWorld* World)
 
 AITradeSourcesByResource& AITradeSources::GetSourcesPerResource(FFlareResourceDescription* Resource)
 {
-	return SourcesPerResource[Resource];
+	return SourcesPerResource[Resource->CatalogIndex];
 }
 
 void AITradeSourcesByResource::Add(AITradeSource* Source)
 {
-	SourcesPerSector[Source->Sector].Add(Source);
+	SourcesPerSector[Source->Sector].Add(Source, AITradeListSlot::SectorAll, AITradeListSlot::SectorCompany);
 
 	FName Moon = Source->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
-	SourcesPerMoon[Moon].Add(Source);
+	SourcesPerMoon[Moon].Add(Source, AITradeListSlot::MoonAll, AITradeListSlot::MoonCompany);
 
-	SourcesPerCompany[Source->Company].Add(Source);
+	SourcesPerCompany[Source->Company].Add(Source, AITradeListSlot::Company);
 
-	Sources.Add(Source);
+	Sources.Add(Source, AITradeListSlot::All);
 }
 
 AITradeSourcesByResourceLocation& AITradeSourcesByResource::GetSourcesPerSector(UFlareSimulatedSector* Sector)
@@ -3664,32 +3703,24 @@ AITradeSourcesByResourceLocation& AITradeSourcesByResource::GetSourcesPerMoon(FN
 
 TArray<AITradeSource*>& AITradeSourcesByResource::GetSourcePerCompany(UFlareCompany* Company)
 {
-	return SourcesPerCompany[Company];
+	return SourcesPerCompany[Company].Items;
 }
 
 TArray<AITradeSource*>& AITradeSourcesByResource::GetSources()
 {
-	return Sources;
+	return Sources.Items;
 }
 
 void AITradeSourcesByResource::ConsumeSource(AITradeSource* Source)
 {
-	for(auto& SourcePerSector : SourcesPerSector)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
+	SourcesPerSector[Source->Sector].ConsumeSource(Source, AITradeListSlot::SectorAll, AITradeListSlot::SectorCompany);
 
-	for(auto& SourcePerSector : SourcesPerMoon)
-	{
-		SourcePerSector.Value.ConsumeSource(Source);
-	}
+	FName Moon = Source->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
+	SourcesPerMoon[Moon].ConsumeSource(Source, AITradeListSlot::MoonAll, AITradeListSlot::MoonCompany);
 
-	for(auto& SourcePerCompany : SourcesPerCompany)
-	{
-		SourcePerCompany.Value.Remove(Source);
-	}
+	SourcesPerCompany[Source->Company].Remove(Source, AITradeListSlot::Company);
 
-	Sources.Remove(Source);
+	Sources.Remove(Source, AITradeListSlot::All);
 }
 
 AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld* World)
@@ -3701,34 +3732,31 @@ AITradeSourcesByResourceLocation::AITradeSourcesByResourceLocation(UFlareWorld*
 }
 
 
-void AITradeSourcesByResourceLocation::Add(AITradeSource* Source)
+void AITradeSourcesByResourceLocation::Add(AITradeSource* Source, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot)
 {
-	SourcesPerCompany[Source->Company].Add(Source);
+	SourcesPerCompany[Source->Company].Add(Source, CompanySlot);
 
-	Sources.Add(Source);
+	Sources.Add(Source, AllSlot);
 }
 
 
 
 TArray<AITradeSource*>& AITradeSourcesByResourceLocation::GetSourcePerCompany(UFlareCompany* Company)
 {
-	return SourcesPerCompany[Company];
+	return SourcesPerCompany[Company].Items;
 }
 
 TArray<AITradeSource*>& AITradeSourcesByResourceLocation::GetSources()
 {
-	return Sources;
+	return Sources.Items;
 }
 
 
-void AITradeSourcesByResourceLocation::ConsumeSource(AITradeSource* Source)
+void AITradeSourcesByResourceLocation::ConsumeSource(AITradeSource* Source, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot)
 {
-	for(auto& SourcePerCompany : SourcesPerCompany)
-	{
-		SourcePerCompany.Value.Remove(Source);
-	}
+	SourcesPerCompany[Source->Company].Remove(Source, CompanySlot);
 
-	Sources.Remove(Source);
+	Sources.Remove(Source, AllSlot);
 }
 
 AITradeIdleShips::AITradeIdleShips(UFlareWorld* World)
@@ -3753,9 +3781,9 @@ AITradeIdleShips::AITradeIdleShips(UFlareWorld* World)
 
 void AITradeIdleShips::Print()
 {
-	FLOGV("AITradeIdleShips : %d idle ships", ShipsPtr.Num())
+	FLOGV("AITradeIdleShips : %d idle ships", ShipsPtr.Items.Num())
 
-	for(AIIdleShip* Ship: ShipsPtr)
+	for(AIIdleShip* Ship: ShipsPtr.Items)
 	{
 		FLOGV(" - %s %s in %s: %d free space (stranded: %d, travelling: %d)",
 				*Ship->Company->GetCompanyName().ToString(),
@@ -3770,22 +3798,14 @@ void AITradeIdleShips::Print()
 
 void AITradeIdleShips::ConsumeShip(AIIdleShip* Ship)
 {
-	for(auto& ShipPerSector : ShipsPerSector)
-	{
-		ShipPerSector.Value.ConsumeShip(Ship);
-	}
+	ShipsPerSector[Ship->Sector].ConsumeShip(Ship, AITradeListSlot::SectorAll, AITradeListSlot::SectorCompany);
 
-	for(auto& ShipPerSector : ShipsPerMoon)
-	{
-		ShipPerSector.Value.ConsumeShip(Ship);
-	}
+	FName Moon = Ship->Sector->GetOrbitParameters()->CelestialBodyIdentifier;
+	ShipsPerMoon[Moon].ConsumeShip(Ship, AITradeListSlot::MoonAll, AITradeListSlot::MoonCompany);
 
-	for(auto& ShipPerCompany : ShipsPerCompany)
-	{
-		ShipPerCompany.Value.Remove(Ship);
-	}
+	ShipsPerCompany[Ship->Company].Remove(Ship, AITradeListSlot::Company);
 
-	ShipsPtr.Remove(Ship);
+	ShipsPtr.Remove(Ship, AITradeListSlot::All);
 }
 
 void AITradeIdleShips::Add(AIIdleShip const& Ship)
@@ -3797,19 +3817,24 @@ void AITradeIdleShips::GenerateCache()
 {
 	for(AIIdleShip& Ship : Ships)
 	{
-		ShipsPerSector[Ship.Sector].Add(&Ship);
+		for (int32 SlotIndex = 0; SlotIndex < AITradeListSlot::Count; SlotIndex++)
+		{
+			Ship.ListIndices[SlotIndex] = INDEX_NONE;
+		}
+
+		ShipsPerSector[Ship.Sector].Add(&Ship, AITradeListSlot::SectorAll, AITradeListSlot::SectorCompany);
 
 		FName Moon = Ship.Sector->GetOrbitParameters()->CelestialBodyIdentifier;
-		ShipsPerMoon[Moon].Add(&Ship);
+		ShipsPerMoon[Moon].Add(&Ship, AITradeListSlot::MoonAll, AITradeListSlot::MoonCompany);
 
-		ShipsPerCompany[Ship.Company].Add(&Ship);
-		ShipsPtr.Add(&Ship);
+		ShipsPerCompany[Ship.Company].Add(&Ship, AITradeListSlot::Company);
+		ShipsPtr.Add(&Ship, AITradeListSlot::All);
 	}
 }
 
 TArray<AIIdleShip*>& AITradeIdleShips::GetShips()
 {
-	return ShipsPtr;
+	return ShipsPtr.Items;
 }
 
 AITradeIdleShipsByLocation& AITradeIdleShips::GetShipsPerSector(UFlareSimulatedSector* Sector)
@@ -3824,17 +3849,17 @@ AITradeIdleShipsByLocation& AITradeIdleShips::GetShipsPerMoon(FName Moon)
 
 TArray<AIIdleShip*>& AITradeIdleShips::GetShipsPerCompany(UFlareCompany* Company)
 {
-	return ShipsPerCompany[Company];
+	return ShipsPerCompany[Company].Items;
 }
 
 TArray<AIIdleShip*>& AITradeIdleShipsByLocation::GetShipsPerCompany(UFlareCompany* Company)
 {
-	return ShipsPerCompany[Company];
+	return ShipsPerCompany[Company].Items;
 }
 
 TArray<AIIdleShip*>& AITradeIdleShipsByLocation::GetShips()
 {
-	return Ships;
+	return Ships.Items;
 }
 
 AITradeIdleShipsByLocation::AITradeIdleShipsByLocation(UFlareWorld* World)
@@ -3846,22 +3871,19 @@ AITradeIdleShipsByLocation::AITradeIdleShipsByLocation(UFlareWorld* World)
 	}
 }
 
-void AITradeIdleShipsByLocation::Add(AIIdleShip* Ship)
+void AITradeIdleShipsByLocation::Add(AIIdleShip* Ship, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot)
 {
 	//FLOGV("   - AITradeIdleShipsByLocation add ship from %s", *Ship->Company->GetIdentifier().ToString());
-	ShipsPerCompany[Ship->Company].Add(Ship);
+	ShipsPerCompany[Ship->Company].Add(Ship, CompanySlot);
 
-	Ships.Add(Ship);
+	Ships.Add(Ship, AllSlot);
 }
 
-void AITradeIdleShipsByLocation::ConsumeShip(AIIdleShip* Ship)
+void AITradeIdleShipsByLocation::ConsumeShip(AIIdleShip* Ship, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot)
 {
-	for(auto& ShipPerCompany : ShipsPerCompany)
-	{
-		ShipPerCompany.Value.Remove(Ship);
-	}
+	ShipsPerCompany[Ship->Company].Remove(Ship, CompanySlot);
 
-	Ships.Remove(Ship);
+	Ships.Remove(Ship, AllSlot);
 }
 
 void AITradeNeed::Consume(int UsedQuantity)
@@ -48,7 +48,8 @@ struct ResourceVariation
 struct SectorVariation
 {
 	int32 IncomingCapacity;
-	TMap<FFlareResourceDescription*, ResourceVariation> ResourceVariations;
+	/** Variations by resource catalog index */
+	TArray<ResourceVariation> ResourceVariations;
 };
 
 struct AITradeNeed
@@ -84,6 +85,49 @@ struct AITradeNeeds
 };
 
 
+/* Lists a trade source or idle ship is registered in */
+namespace AITradeListSlot
+{
+	enum Type
+	{
+		All,
+		Company,
+		SectorAll,
+		SectorCompany,
+		MoonAll,
+		MoonCompany,
+
+		Count
+	};
+}
+
+/* Pointer list with constant time removal : each item keeps its position in every list it belongs to, removal swaps the last item in */
+template<typename T>
+struct AITradeIndexedList
+{
+	void Add(T* Item, AITradeListSlot::Type Slot)
+	{
+		Item->ListIndices[Slot] = Items.Add(Item);
+	}
+
+	void Remove(T* Item, AITradeListSlot::Type Slot)
+	{
+		int32 Index = Item->ListIndices[Slot];
+		if (Index == INDEX_NONE)
+		{
+			return;
+		}
+
+		T* LastItem = Items.Last();
+		Items[Index] = LastItem;
+		LastItem->ListIndices[Slot] = Index;
+		Items.Pop(false);
+		Item->ListIndices[Slot] = INDEX_NONE;
+	}
+
+	TArray<T*> Items;
+};
+
 struct AITradeSource
 {
 	UFlareSimulatedSpacecraft* Ship;
@@ -94,6 +138,8 @@ struct AITradeSource
 	int32 Quantity;
 	bool Stranded;
 	bool Traveling;
+
+	int32 ListIndices[AITradeListSlot::Count];
 };
 
 inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
@@ -103,6 +149,8 @@ inline bool operator==(const AITradeSource& lhs, const AITradeSource& rhs){
 			&& lhs.Sector == rhs.Sector;
 }
 
+typedef AITradeIndexedList<AITradeSource> AITradeSourceList;
+
 struct AITradeSourcesByResourceLocation
 {
 	AITradeSourcesByResourceLocation(UFlareWorld* World);
@@ -111,12 +159,12 @@ struct AITradeSourcesByResourceLocation
 
 	TArray<AITradeSource*>& GetSources();
 
-	void ConsumeSource(AITradeSource*);
+	void ConsumeSource(AITradeSource*, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot);
 
-	void Add(AITradeSource* Source);
+	void Add(AITradeSource* Source, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot);
 
-	TMap<UFlareCompany*, TArray<AITradeSource*>> SourcesPerCompany;
-	TArray<AITradeSource*> Sources;
+	TMap<UFlareCompany*, AITradeSourceList> SourcesPerCompany;
+	AITradeSourceList Sources;
 };
 
 
@@ -138,8 +186,8 @@ struct AITradeSourcesByResource
 
 	TMap<UFlareSimulatedSector*, AITradeSourcesByResourceLocation> SourcesPerSector;
 	TMap<FName, AITradeSourcesByResourceLocation> SourcesPerMoon;
-	TMap<UFlareCompany*, TArray<AITradeSource*>> SourcesPerCompany;
-	TArray<AITradeSource*> Sources;
+	TMap<UFlareCompany*, AITradeSourceList> SourcesPerCompany;
+	AITradeSourceList Sources;
 };
 
 
@@ -166,7 +214,8 @@ struct AITradeSources
 
 
 
-	TMap<FFlareResourceDescription*, AITradeSourcesByResource> SourcesPerResource;
+	/** Sources by resource catalog index */
+	TArray<AITradeSourcesByResource> SourcesPerResource;
 };
 
 struct AIIdleShip
@@ -178,10 +227,13 @@ struct AIIdleShip
 	bool Traveling;
 	bool Stranded;
 
+	int32 ListIndices[AITradeListSlot::Count];
 };
 
 inline bool operator==(const AIIdleShip& lhs, const AIIdleShip& rhs){ return lhs.Ship == rhs.Ship;}
 
+typedef AITradeIndexedList<AIIdleShip> AIIdleShipList;
+
 struct AITradeIdleShipsByLocation
 {
 	AITradeIdleShipsByLocation(UFlareWorld* World);
@@ -190,12 +242,12 @@ struct AITradeIdleShipsByLocation
 
 	TArray<AIIdleShip*>& GetShips();
 
-	void ConsumeShip(AIIdleShip* Ship);
+	void ConsumeShip(AIIdleShip* Ship, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot);
 
-	void Add(AIIdleShip* Ship);
+	void Add(AIIdleShip* Ship, AITradeListSlot::Type AllSlot, AITradeListSlot::Type CompanySlot);
 
-	TMap<UFlareCompany*, TArray<AIIdleShip*>> ShipsPerCompany;
-	TArray<AIIdleShip*> Ships;
+	TMap<UFlareCompany*, AIIdleShipList> ShipsPerCompany;
+	AIIdleShipList Ships;
 };
 
 struct AITradeIdleShips
@@ -212,7 +264,7 @@ struct AITradeIdleShips
 
 	TMap<UFlareSimulatedSector*, AITradeIdleShipsByLocation> ShipsPerSector;
 	TMap<FName, AITradeIdleShipsByLocation> ShipsPerMoon;
-	TMap<UFlareCompany*, TArray<AIIdleShip*>> ShipsPerCompany;
+	TMap<UFlareCompany*, AIIdleShipList> ShipsPerCompany;
 
 	void Add(AIIdleShip const& Ship);
 	void GenerateCache();
@@ -221,7 +273,7 @@ struct AITradeIdleShips
 
 	TArray<AIIdleShip*>& GetShips();
 
-	TArray<AIIdleShip*> ShipsPtr;
+	AIIdleShipList ShipsPtr;
 	TArray<AIIdleShip> Ships;
 };
 
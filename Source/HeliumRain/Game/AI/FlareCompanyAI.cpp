@@ -59,6 +59,7 @@
 #define LOCTEXT_NAMESPACE "FlareCompanyAI"
 
 
+DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI PlanSimulation"), STAT_FlareCompanyAI_PlanSimulation, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI UpdateDiplomacy"), STAT_FlareCompanyAI_UpdateDiplomacy, STATGROUP_Flare);
 
 DECLARE_CYCLE_STAT(TEXT("FlareCompanyAI UpdateTrading"), STAT_FlareCompanyAI_UpdateTrading, STATGROUP_Flare);
@@ -81,6 +82,8 @@ UFlareCompanyAI::UFlareCompanyAI(const FObjectInitializer& ObjectInitializer)
 	AllBudgets.Add(EFlareBudget::Station);
 	AllBudgets.Add(EFlareBudget::Technology);
 	AllBudgets.Add(EFlareBudget::Trade);
+
+	WorldResourceVariationPlanned = false;
 }
 
 void UFlareCompanyAI::Load(UFlareCompany* ParentCompany, const FFlareCompanyAISave& Data)
@@ -105,6 +108,17 @@ void UFlareCompanyAI::Tick()
 	}
 }
 
+void UFlareCompanyAI::PlanSimulation()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareCompanyAI_PlanSimulation);
+
+	if (Game && Company != Game->GetPC()->GetCompany())
+	{
+		ComputeWorldResourceVariation();
+		WorldResourceVariationPlanned = true;
+	}
+}
+
 void UFlareCompanyAI::Simulate()
 {
 	if (Game && Company != Game->GetPC()->GetCompany())
@@ -117,20 +131,16 @@ void UFlareCompanyAI::Simulate()
 		CheckBattleResolution();
 		UpdateDiplomacy();
 
-		WorldStats = WorldHelper::ComputeWorldResourceStats(Game, true);
+		WorldStats = Game->GetGameWorld()->GetWorldResourceStats(true);
 		Shipyards = FindShipyards();
 
-		// Compute input and output ressource equation (ex: 100 + 10/ day)
-		// TODO
-		WorldResourceVariation.Empty();
-		for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+		// Compute input and output ressource equation (ex: 100 + 10/ day), unless already planned
+		if (!WorldResourceVariationPlanned)
 		{
-			UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
-			SectorVariation Variation = AITradeHelper::ComputeSectorResourceVariation(Company, Sector, true);
-
-			WorldResourceVariation.Add(Sector, Variation);
-			//DumpSectorResourceVariation(Sector, &Variation);
+			ComputeWorldResourceVariation();
 		}
+		WorldResourceVariationPlanned = false;
+
 		Behavior->Simulate();
 
 		PurchaseResearch();
@@ -166,6 +176,20 @@ void UFlareCompanyAI::Simulate()
 	}
 }
 
+void UFlareCompanyAI::ComputeWorldResourceVariation()
+{
+	// TODO
+	WorldResourceVariation.Empty();
+	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+		SectorVariation Variation = AITradeHelper::ComputeSectorResourceVariation(Company, Sector, true);
+
+		WorldResourceVariation.Add(Sector, Variation);
+		//DumpSectorResourceVariation(Sector, &Variation);
+	}
+}
+
 void UFlareCompanyAI::AutoScrap()
 {
 	int32 TotalShipCount = 0;
@@ -3112,7 +3136,7 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->CatalogIndex];
 
 
 			float Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
@@ -3151,10 +3175,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->MaintenanceResources.Num(); ResourceIndex++)
 		{
 			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
-			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource];
+			const struct ResourceVariation* Variation = &ThisSectorVariation->ResourceVariations[Resource->CatalogIndex];
 
 
-			int32 Consumption = WorldStats[Resource].Consumption / Company->GetKnownSectors().Num();
+			int32 Consumption = WorldStats[Resource->CatalogIndex].Consumption / Company->GetKnownSectors().Num();
 			//FLOGV("%s comsumption = %d", *Resource->Name.ToString(), Consumption);
 
 			float ReserveStock =  Variation->MaintenanceMaxStock;
@@ -3190,10 +3214,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.CatalogIndex].Production, WorldStats[Resource->Resource->Data.CatalogIndex].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.CatalogIndex].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3228,10 +3252,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 		{
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.CatalogIndex].Production, WorldStats[Resource->Resource->Data.CatalogIndex].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.CatalogIndex].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3268,10 +3292,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 			const FFlareFactoryResource* Resource = &FactoryDescription->CycleCost.InputResources[ResourceIndex];
 			GainPerCycle -= Sector->GetResourcePrice(&Resource->Resource->Data, EFlareResourcePriceContext::FactoryInput) * Resource->Quantity;
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.CatalogIndex].Production, WorldStats[Resource->Resource->Data.CatalogIndex].Consumption);
 			if (MaxVolume > 0)
 			{
-				float UnderflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float UnderflowRatio = WorldStats[Resource->Resource->Data.CatalogIndex].Balance / MaxVolume;
 				if (UnderflowRatio < 0)
 				{
 					float UnderflowMalus = FMath::Clamp((UnderflowRatio * 100)  / 20.f + 1.f, 0.f, 1.f);
@@ -3311,10 +3335,10 @@ float UFlareCompanyAI::ComputeConstructionScoreForStation(UFlareSimulatedSector*
 
 			//FLOGV(" ResourceAffility for %s: %f", *Resource->Resource->Data.Identifier.ToString(), ResourceAffility);
 
-			float MaxVolume = FMath::Max(WorldStats[&Resource->Resource->Data].Production, WorldStats[&Resource->Resource->Data].Consumption);
+			float MaxVolume = FMath::Max(WorldStats[Resource->Resource->Data.CatalogIndex].Production, WorldStats[Resource->Resource->Data.CatalogIndex].Consumption);
 			if (MaxVolume > 0)
 			{
-				float OverflowRatio = WorldStats[&Resource->Resource->Data].Balance / MaxVolume;
+				float OverflowRatio = WorldStats[Resource->Resource->Data.CatalogIndex].Balance / MaxVolume;
 				if (OverflowRatio > 0)
 				{
 					float OverflowMalus = FMath::Clamp(1.f - ((OverflowRatio - 0.1f) * 100)  / ResourceAffility, 0.f, 1.f);
@@ -3404,13 +3428,13 @@ float UFlareCompanyAI::ComputeStationPrice(UFlareSimulatedSector* Sector, FFlare
 
 
 
-void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* SectorVariation) const
+void UFlareCompanyAI::DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* SectorVariation) const
 {
 	FLOGV("DumpSectorResourceVariation : sector %s resource variation: ", *Sector->GetSectorName().ToString());
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		struct ResourceVariation* Variation = &(*SectorVariation)[Resource];
+		struct ResourceVariation* Variation = &(*SectorVariation)[ResourceIndex];
 		if (Variation->OwnedFlow ||
 				Variation->FactoryFlow ||
 				Variation->OwnedStock ||
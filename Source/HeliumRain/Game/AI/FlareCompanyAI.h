@@ -2,6 +2,7 @@
 
 #include "Object.h"
 #include "../FlareGameTypes.h"
+#include "../FlareWorld.h"
 #include "../FlareWorldHelper.h"
 #include "FlareAITradeHelper.h"
 #include "FlareCompanyAI.generated.h"
@@ -73,6 +74,9 @@ public:
 	/** Real-time tick */
 	virtual void Tick();
 
+	/** Compute the read-only part of the next day. Only reads the world, so companies can be planned in parallel */
+	virtual void PlanSimulation();
+
 	/** Simulate a day */
 	virtual void Simulate();
 
@@ -182,6 +186,9 @@ protected:
 
 	void AutoScrap();
 
+	/** Compute the resource flow in every known sector */
+	void ComputeWorldResourceVariation();
+
 	
 	/*----------------------------------------------------
 		Helpers
@@ -216,7 +223,7 @@ protected:
 	float ComputeStationPrice(UFlareSimulatedSector* Sector, FFlareSpacecraftDescription* StationDescription, UFlareSimulatedSpacecraft* Station) const;
 
 	/** Print the resource flow */
-	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* Variation) const;
+	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TArray<struct ResourceVariation>* Variation) const;
 
 
 protected:
@@ -233,9 +240,10 @@ protected:
 	UFlareAIBehavior*                      Behavior;
 	
 	// Cache
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
 	TArray<UFlareSimulatedSpacecraft*>       Shipyards;
 	TMap<UFlareSimulatedSector*, SectorVariation> WorldResourceVariation;
+	bool                                     WorldResourceVariationPlanned;
 
 	TArray<UFlareSimulatedSector*>            SectorWithBattle;
 
@@ -40,12 +40,13 @@ UFlareBattle::UFlareBattle(const FObjectInitializer& ObjectInitializer)
 {
 }
 
-void UFlareBattle::Load(UFlareSimulatedSector* BattleSector)
+void UFlareBattle::Load(UFlareSimulatedSector* BattleSector, const FRandomStream& BattleStream)
 {
     Game = Cast<UFlareWorld>(GetOuter())->GetGame();
     Sector = BattleSector;
     PlayerCompany = Game->GetPC()->GetCompany();
 	Catalog = Game->GetShipPartsCatalog();
+	RandomStream = BattleStream;
 
 }
 
@@ -160,7 +161,7 @@ bool UFlareBattle::SimulateTurn()
 
     while(ShipToSimulate.Num())
     {
-        int32 Index = FMath::RandRange(0, ShipToSimulate.Num() - 1);
+        int32 Index = RandomStream.RandRange(0, ShipToSimulate.Num() - 1);
         if(SimulateShipTurn(ShipToSimulate[Index]))
         {
             HasFight = true;
@@ -390,7 +391,7 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 			continue;
 		}
 
-		if (ShipCandidate->IsStation() && (!ShipCandidate->GetCompany()->IsPlayerCompany() || ShipCandidate->GetCompany()->GetRetaliation() <= 0))
+		if (ShipCandidate->IsStation() && (!ShipCandidate->GetCompany()->IsPlayerCompany() || Sector->GetPlayerRetaliation() <= 0))
 		{
 			// Ignore company without retaliation
 			continue;
@@ -480,7 +481,7 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 			StateScore *=  Preferences.IsHarpooned;
 		}
 
-		DistanceScore = FMath::FRand();
+		DistanceScore = RandomStream.FRand();
 
 		Score = StateScore * (DistanceScore);
 
@@ -506,7 +507,7 @@ bool UFlareBattle::SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 Wea
 
 	// TODO configure Fire probability
 	float FireProbability = 0.8f;
-	if(FMath::FRand() < FireProbability)
+	if(RandomStream.FRand() < FireProbability)
 	{
 		// Fire with all weapon
 		for (int32 WeaponIndex = 0; WeaponIndex <  WeaponGroup->Weapons.Num(); WeaponIndex++)
@@ -543,7 +544,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 	{
 		// Fire 5 s of ammo with a hit probability of 10% + precision * usage ratio
 		float FiringPeriod = 1.f / (WeaponDescription->WeaponCharacteristics.GunCharacteristics.AmmoRate / 60.f);
-		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * FMath::FRandRange(0.f, 1.f);
+		float DamageDelay = FMath::Square(1.f- UsageRatio) * 10 * FiringPeriod * RandomStream.FRandRange(0.f, 1.f);
 		float Delay = DamageDelay + FiringPeriod;
 
 
@@ -578,7 +579,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 		FLOGV("Fire %d ammo with a hit probability of %f", AmmoToFire, Precision);
 		for (int32 BulletIndex = 0; BulletIndex <  AmmoToFire; BulletIndex++)
 		{
-			if(FMath::FRand() < Precision)
+			if(RandomStream.FRand() < Precision)
 			{
 				// Apply bullet damage
 				SimulateBulletDamage(WeaponDescription, Target, Ship);
@@ -592,7 +593,7 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 	{
 		// Drop one bomb with a hit probabiliy of (1 + usable ratio + isUncontrollable)/3
 
-		if (FMath::FRand() < (1+UsageRatio+(Target->GetDamageSystem()->IsUncontrollable() ? 1.f:0.f)))
+		if (RandomStream.FRand() < (1+UsageRatio+(Target->GetDamageSystem()->IsUncontrollable() ? 1.f:0.f)))
 		{
 			// Apply bullet damage
 			SimulateBombDamage(WeaponDescription, Target, Ship);
@@ -623,13 +624,13 @@ void UFlareBattle::SimulateBulletDamage(FFlareSpacecraftComponentDescription* We
 	else if(WeaponDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HighExplosive)
 	{
 		// Generate fragments
-		float FragmentHitRatio = FMath::FRandRange(0.01f, 0.1f);
+		float FragmentHitRatio = RandomStream.FRandRange(0.01f, 0.1f);
 		int32 FragmentCount = WeaponDescription->WeaponCharacteristics.AmmoFragmentCount * FragmentHitRatio;
 
 
 		for(int FragmentIndex = 0; FragmentIndex < FragmentCount; FragmentIndex++)
 		{
-			float FragmentPowerEffet = FMath::FRandRange(0.f, 2.f);
+			float FragmentPowerEffet = RandomStream.FRandRange(0.f, 2.f);
 			ApplyDamage(Target, FragmentPowerEffet * WeaponDescription->WeaponCharacteristics.ExplosionPower, EFlareDamage::DAM_HighExplosive, DamageSource);
 		}
 	}
@@ -660,7 +661,7 @@ void UFlareBattle::ApplyDamage(UFlareSimulatedSpacecraft* Target, float Energy,
 	int32 ComponentIndex;
 	if(DamageType == EFlareDamage::DAM_HighExplosive)
 	{
-		ComponentIndex = FMath::RandRange(0,  Target->GetData().Components.Num()-1);
+		ComponentIndex = RandomStream.RandRange(0,  Target->GetData().Components.Num()-1);
 	}
 	else
 	{
@@ -764,7 +765,7 @@ int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpac
 		return 0;
 	}
 
-	int32 ComponentIndex = FMath::RandRange(0, ComponentSelection.Num() - 1);
+	int32 ComponentIndex = RandomStream.RandRange(0, ComponentSelection.Num() - 1);
 	return ComponentSelection[ComponentIndex];
 }
 
@@ -18,8 +18,8 @@ public:
 	  Save
 	----------------------------------------------------*/
 
-	/** Load the battle state */
-	virtual void Load(UFlareSimulatedSector* BattleSector);
+	/** Load the battle state, with the random stream of this sector */
+	virtual void Load(UFlareSimulatedSector* BattleSector, const FRandomStream& BattleStream);
 
 	/*----------------------------------------------------
 		Gameplay
@@ -55,6 +55,7 @@ protected:
 	AFlareGame*                             Game;
 	UFlareCompany*                          PlayerCompany;
 	UFlareSpacecraftComponentsCatalog*      Catalog;
+	FRandomStream                           RandomStream;
 
 public:
 
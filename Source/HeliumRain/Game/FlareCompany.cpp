@@ -24,6 +24,8 @@
 
 #define LOCTEXT_NAMESPACE "FlareCompany"
 
+#define DEBUG_COMPANY_VALUE 0
+
 
 /*----------------------------------------------------
 	Constructor
@@ -31,6 +33,8 @@
 
 UFlareCompany::UFlareCompany(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, WorldIndex(INDEX_NONE)
+	, CompanyAssetsValueValid(false)
 {
 }
 
@@ -103,6 +107,16 @@ void UFlareCompany::Load(const FFlareCompanySave& Data)
 	// Load emblem
 	SetupEmblem();
 
+	// Older saves only have the log, roll it up
+	if (CompanyData.TransactionBalances.Num() == 0)
+	{
+		for (const FFlareTransactionLogEntry& Entry : CompanyData.TransactionLog)
+		{
+			AddTransactionBalance(Entry);
+		}
+	}
+	TrimTransactionLog(TransactionLogSize);
+
 	InvalidateCompanyValueCache();
 }
 
@@ -110,6 +124,10 @@ void UFlareCompany::PostLoad()
 {
 	VisitedSectors.Empty();
 	KnownSectors.Empty();
+	for (UFlareTradeRoute* TradeRoute : CompanyTradeRoutes)
+	{
+		GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
+	}
 	CompanyTradeRoutes.Empty();
 
 	// Load all trade routes
@@ -145,45 +163,51 @@ void UFlareCompany::PostLoad()
 
 }
 
-FFlareCompanySave* UFlareCompany::Save()
+void UFlareCompany::Save(FFlareCompanySave& SaveData)
 {
-	CompanyData.Fleets.Empty();
-	CompanyData.TradeRoutes.Empty();
-	CompanyData.ShipData.Empty();
-	CompanyData.ChildStationData.Empty();
-	CompanyData.StationData.Empty();
-	CompanyData.DestroyedSpacecraftData.Empty();
-	CompanyData.SectorsKnowledge.Empty();
-	CompanyData.UnlockedTechnologies.Empty();
+	CompanyData.CompanyValue = GetCompanyValue().TotalValue;
+	CompanyData.AI = *CompanyAI->Save();
 
+	// The lists below are only read when loading : keep them out of the copy and build them in the snapshot
+	FFlareCompanySave LoadedLists;
+	SwapSaveLists(CompanyData, LoadedLists);
+	SaveData = CompanyData;
+	SwapSaveLists(CompanyData, LoadedLists);
+
+	SaveData.Fleets.Reserve(CompanyFleets.Num());
 	for (int i = 0 ; i < CompanyFleets.Num(); i++)
 	{
-		CompanyData.Fleets.Add(*CompanyFleets[i]->Save());
+		SaveData.Fleets.Add(*CompanyFleets[i]->Save());
 	}
 
+	SaveData.TradeRoutes.Reserve(CompanyTradeRoutes.Num());
 	for (int i = 0 ; i < CompanyTradeRoutes.Num(); i++)
 	{
-		CompanyData.TradeRoutes.Add(*CompanyTradeRoutes[i]->Save());
+		SaveData.TradeRoutes.Add(*CompanyTradeRoutes[i]->Save());
 	}
 
+	SaveData.ShipData.Reserve(CompanyShips.Num());
 	for (int i = 0 ; i < CompanyShips.Num(); i++)
 	{
-		CompanyData.ShipData.Add(*CompanyShips[i]->Save());
+		SaveData.ShipData.Add(*CompanyShips[i]->Save());
 	}
 
+	SaveData.ChildStationData.Reserve(CompanyChildStations.Num());
 	for (int i = 0 ; i < CompanyChildStations.Num(); i++)
 	{
-		CompanyData.ChildStationData.Add(*CompanyChildStations[i]->Save());
+		SaveData.ChildStationData.Add(*CompanyChildStations[i]->Save());
 	}
 
+	SaveData.StationData.Reserve(CompanyStations.Num());
 	for (int i = 0 ; i < CompanyStations.Num(); i++)
 	{
-		CompanyData.StationData.Add(*CompanyStations[i]->Save());
+		SaveData.StationData.Add(*CompanyStations[i]->Save());
 	}
 
+	SaveData.DestroyedSpacecraftData.Reserve(CompanyDestroyedSpacecrafts.Num());
 	for (int i = 0 ; i < CompanyDestroyedSpacecrafts.Num(); i++)
 	{
-		CompanyData.DestroyedSpacecraftData.Add(*CompanyDestroyedSpacecrafts[i]->Save());
+		SaveData.DestroyedSpacecraftData.Add(*CompanyDestroyedSpacecrafts[i]->Save());
 	}
 
 	for (int i = 0 ; i < VisitedSectors.Num(); i++)
@@ -192,7 +216,7 @@ FFlareCompanySave* UFlareCompany::Save()
 		SectorKnowledge.Knowledge = EFlareSectorKnowledge::Visited;
 		SectorKnowledge.SectorIdentifier = VisitedSectors[i]->GetIdentifier();
 
-		CompanyData.SectorsKnowledge.Add(SectorKnowledge);
+		SaveData.SectorsKnowledge.Add(SectorKnowledge);
 	}
 
 	for (int i = 0 ; i < KnownSectors.Num(); i++)
@@ -204,20 +228,68 @@ FFlareCompanySave* UFlareCompany::Save()
 			SectorKnowledge.Knowledge = EFlareSectorKnowledge::Known;
 			SectorKnowledge.SectorIdentifier = KnownSectors[i]->GetIdentifier();
 
-			CompanyData.SectorsKnowledge.Add(SectorKnowledge);
+			SaveData.SectorsKnowledge.Add(SectorKnowledge);
 		}
 	}
 
 	for (auto& Technology : UnlockedTechnologies)
 	{
-		CompanyData.UnlockedTechnologies.Add(Technology.Key);
+		SaveData.UnlockedTechnologies.Add(Technology.Key);
 	}
+}
 
-	CompanyData.CompanyValue = GetCompanyValue().TotalValue;
+void UFlareCompany::SwapSaveLists(FFlareCompanySave& A, FFlareCompanySave& B)
+{
+	Swap(A.Fleets, B.Fleets);
+	Swap(A.TradeRoutes, B.TradeRoutes);
+	Swap(A.ShipData, B.ShipData);
+	Swap(A.ChildStationData, B.ChildStationData);
+	Swap(A.StationData, B.StationData);
+	Swap(A.DestroyedSpacecraftData, B.DestroyedSpacecraftData);
+	Swap(A.SectorsKnowledge, B.SectorsKnowledge);
+	Swap(A.UnlockedTechnologies, B.UnlockedTechnologies);
+}
 
-	CompanyData.AI = *CompanyAI->Save();
+void UFlareCompany::LogTransaction(const FFlareTransactionLogEntry& TransactionContext)
+{
+	AddTransactionBalance(TransactionContext);
+	CompanyData.TransactionLog.Push(TransactionContext);
 
-	return &CompanyData;
+	// Entries are dropped by batches to keep the log append cheap
+	if (CompanyData.TransactionLog.Num() > TransactionLogSize + TransactionLogSize / 4)
+	{
+		TrimTransactionLog(TransactionLogSize);
+	}
+}
+
+void UFlareCompany::AddTransactionBalance(const FFlareTransactionLogEntry& TransactionContext)
+{
+	TArray<FFlareTransactionLogBalance>& Balances = CompanyData.TransactionBalances;
+
+	// Balances are in date order, only the last day can match
+	for (int32 BalanceIndex = Balances.Num() - 1; BalanceIndex >= 0 && Balances[BalanceIndex].Date == TransactionContext.Date; BalanceIndex--)
+	{
+		if (Balances[BalanceIndex].Type == TransactionContext.Type)
+		{
+			Balances[BalanceIndex].Amount += TransactionContext.Amount;
+			return;
+		}
+	}
+
+	FFlareTransactionLogBalance Balance;
+	Balance.Date = TransactionContext.Date;
+	Balance.Type = TransactionContext.Type;
+	Balance.Amount = TransactionContext.Amount;
+	Balances.Add(Balance);
+}
+
+void UFlareCompany::TrimTransactionLog(int32 MaxSize)
+{
+	int32 ExtraEntries = CompanyData.TransactionLog.Num() - MaxSize;
+	if (ExtraEntries > 0)
+	{
+		CompanyData.TransactionLog.RemoveAt(0, ExtraEntries, false);
+	}
 }
 
 
@@ -253,7 +325,7 @@ EFlareHostility::Type UFlareCompany::GetHostility(const UFlareCompany* TargetCom
 	{
 		return EFlareHostility::Owned;
 	}
-	else if (TargetCompany && CompanyData.HostileCompanies.Contains(TargetCompany->GetIdentifier()))
+	else if (TargetCompany && Game->GetGameWorld()->IsHostile(this, TargetCompany))
 	{
 		return EFlareHostility::Hostile;
 	}
@@ -279,12 +351,12 @@ EFlareHostility::Type UFlareCompany::GetWarState(const UFlareCompany* TargetComp
 	{
 		return EFlareHostility::Owned;
 	}
-	else if (GetHostility(TargetCompany) == EFlareHostility::Hostile || TargetCompany->GetHostility(this) == EFlareHostility::Hostile)
+	else if (TargetCompany && Game->GetGameWorld()->IsAtWar(this, TargetCompany))
 	{
 		return EFlareHostility::Hostile;
 	}
 
-	return GetHostility(TargetCompany);
+	return EFlareHostility::Neutral;
 }
 
 bool UFlareCompany::IsAtWar(const UFlareCompany* TargetCompany) const
@@ -292,6 +364,11 @@ bool UFlareCompany::IsAtWar(const UFlareCompany* TargetCompany) const
 	return GetWarState(TargetCompany) == EFlareHostility::Hostile;
 }
 
+bool UFlareCompany::IsHostileNoCache(const UFlareCompany* TargetCompany) const
+{
+	return CompanyData.HostileCompanies.Contains(TargetCompany->GetIdentifier());
+}
+
 void UFlareCompany::ClearLastWarDate()
 {
 	CompanyData.PlayerLastWarDate = 0;
@@ -320,6 +397,7 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		if (Hostile && !WasHostile)
 		{
 			CompanyData.HostileCompanies.AddUnique(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->SetHostility(this, TargetCompany, true);
 			
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 			if (TargetCompany == PlayerCompany)
@@ -356,6 +434,7 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		else if(!Hostile && WasHostile)
 		{
 			CompanyData.HostileCompanies.Remove(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->SetHostility(this, TargetCompany, false);
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
@@ -512,6 +591,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 	Fleet = NewObject<UFlareFleet>(this, UFlareFleet::StaticClass());
 	Fleet->Load(FleetData);
 	CompanyFleets.AddUnique(Fleet);
+	GetGame()->GetGameWorld()->RegisterFleet(Fleet);
 
 	//FLOGV("UFlareWorld::LoadFleet : loaded fleet '%s'", *Fleet->GetFleetName().ToString());
 
@@ -521,6 +601,7 @@ UFlareFleet* UFlareCompany::LoadFleet(const FFlareFleetSave& FleetData)
 void UFlareCompany::RemoveFleet(UFlareFleet* Fleet)
 {
 	CompanyFleets.Remove(Fleet);
+	GetGame()->GetGameWorld()->UnregisterFleet(Fleet);
 }
 
 void UFlareCompany::MoveFleetUp(UFlareFleet* Fleet)
@@ -578,6 +659,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 	TradeRoute = NewObject<UFlareTradeRoute>(this, UFlareTradeRoute::StaticClass());
 	TradeRoute->Load(TradeRouteData);
 	CompanyTradeRoutes.AddUnique(TradeRoute);
+	GetGame()->GetGameWorld()->RegisterTradeRoute(TradeRoute);
 
 	//FLOGV("UFlareCompany::LoadTradeRoute : loaded trade route '%s'", *TradeRoute->GetTradeRouteName().ToString());
 
@@ -587,6 +669,7 @@ UFlareTradeRoute* UFlareCompany::LoadTradeRoute(const FFlareTradeRouteSave& Trad
 void UFlareCompany::RemoveTradeRoute(UFlareTradeRoute* TradeRoute)
 {
 	CompanyTradeRoutes.Remove(TradeRoute);
+	GetGame()->GetGameWorld()->UnregisterTradeRoute(TradeRoute);
 }
 
 UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftSave& SpacecraftData)
@@ -638,6 +721,8 @@ UFlareSimulatedSpacecraft* UFlareCompany::LoadSpacecraft(const FFlareSpacecraftS
 				CompanySpacecrafts.AddUnique((Spacecraft));
 			}
 		}
+
+		GetGame()->GetGameWorld()->RegisterSpacecraft(Spacecraft);
 	}
 	else
 	{
@@ -680,6 +765,9 @@ void UFlareCompany::DestroySpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 	Spacecraft->SetDestroyed(true);
 
 	CompanyDestroyedSpacecrafts.Add(Spacecraft);
+	GetGame()->GetGameWorld()->RegisterDestroyedSpacecraft(Spacecraft);
+
+	InvalidateCompanyValueCache();
 }
 
 void UFlareCompany::DiscoverSector(UFlareSimulatedSector* Sector)
@@ -721,11 +809,9 @@ bool UFlareCompany::TakeMoney(int64 Amount, bool AllowDepts, FFlareTransactionLo
 		{
 			TransactionContext.Amount = -Amount;
 			TransactionContext.Date = GetGame()->GetGameWorld()->GetDate();
-			CompanyData.TransactionLog.Push(TransactionContext);
+			LogTransaction(TransactionContext);
 		}
 
-		InvalidateCompanyValueCache();
-
 		return true;
 	}
 }
@@ -750,11 +836,9 @@ void UFlareCompany::GiveMoney(int64 Amount, FFlareTransactionLogEntry Transactio
 	{
 		TransactionContext.Amount = Amount;
 		TransactionContext.Date = GetGame()->GetGameWorld()->GetDate();
-		CompanyData.TransactionLog.Push(TransactionContext);
+		LogTransaction(TransactionContext);
 	}
 
-	InvalidateCompanyValueCache();
-
 	/*if (Amount > 0)
 	{
 		FLOGV("$ %s + %lld -> %llu", *GetCompanyName().ToString(), Amount, CompanyData.Money);
@@ -1501,16 +1585,48 @@ void UFlareCompany::UnlockTechnology(FName Identifier, bool FromSave, bool Force
 
 const struct CompanyValue UFlareCompany::GetCompanyValue(UFlareSimulatedSector* SectorFilter, bool IncludeIncoming) const
 {
-	bool globalRequest = SectorFilter == nullptr;
+	if (SectorFilter)
+	{
+		return ComputeCompanyValue(SectorFilter, IncludeIncoming);
+	}
 
+	// Assets are valued once, then maintained by the events changing them. Money is always live.
+	CompanyValue CompanyValue;
+	{
+		FScopeLock Lock(&CompanyValueLock);
+		if (!CompanyAssetsValueValid)
+		{
+			CompanyAssetsValue = ComputeCompanyValue(NULL, true);
+			CompanyAssetsValueValid = true;
+		}
+		CompanyValue = CompanyAssetsValue;
+	}
 
-	if(CompanyValueCacheValid && globalRequest)
+#if DEBUG_COMPANY_VALUE
+	struct CompanyValue ComputedValue = ComputeCompanyValue(NULL, true);
+	if (ComputedValue.StockValue != CompanyValue.StockValue
+	 || ComputedValue.ShipsValue != CompanyValue.ShipsValue
+	 || ComputedValue.StationsValue != CompanyValue.StationsValue
+	 || ComputedValue.ArmyValue != CompanyValue.ArmyValue)
 	{
-		return CompanyValueCache;
+		FLOGV("WARNING: %s value drifted: stock %lld (computed %lld), ships %lld (computed %lld), stations %lld (computed %lld), army %lld (computed %lld)",
+			*GetCompanyName().ToString(),
+			CompanyValue.StockValue, ComputedValue.StockValue,
+			CompanyValue.ShipsValue, ComputedValue.ShipsValue,
+			CompanyValue.StationsValue, ComputedValue.StationsValue,
+			CompanyValue.ArmyValue, ComputedValue.ArmyValue);
 	}
+#endif
 
+	CompanyValue.MoneyValue = GetMoney();
+	CompanyValue.SpacecraftsValue = CompanyValue.ShipsValue + CompanyValue.StationsValue;
+	CompanyValue.TotalValue = CompanyValue.MoneyValue + CompanyValue.StockValue + CompanyValue.SpacecraftsValue;
 
+	return CompanyValue;
+}
 
+const struct CompanyValue UFlareCompany::ComputeCompanyValue(UFlareSimulatedSector* SectorFilter, bool IncludeIncoming) const
+{
 	// Company value is the sum of :
 	// - money
 	// - value of its spacecraft
@@ -1529,26 +1645,17 @@ const struct CompanyValue UFlareCompany::GetCompanyValue(UFlareSimulatedSector*
 	{
 		UFlareSimulatedSpacecraft* Spacecraft = CompanySpacecrafts[SpacecraftIndex];
 
-		UFlareSimulatedSector *ReferenceSector =  Spacecraft->GetCurrentSector();
-
-		if(SectorFilter && !IncludeIncoming && SectorFilter != ReferenceSector)
+		if(SectorFilter && !IncludeIncoming && SectorFilter != Spacecraft->GetCurrentSector())
 		{
 			// Not in sector filter
 			continue;
 		}
 
+		UFlareSimulatedSector *ReferenceSector = GetValueReferenceSector(Spacecraft);
 		if (!ReferenceSector)
 		{
-			if (Spacecraft->GetCurrentFleet() && Spacecraft->GetCurrentFleet()->GetCurrentTravel())
-			{
-				ReferenceSector = Spacecraft->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector();
-			}
-			else
-			{
-				FLOGV("Spacecraft %s is lost : no current sector, no travel", *Spacecraft->GetImmatriculation().ToString());
-				continue;
-			}
-
+			FLOGV("Spacecraft %s is lost : no current sector, no travel", *Spacecraft->GetImmatriculation().ToString());
+			continue;
 		}
 
 		if(SectorFilter && IncludeIncoming && SectorFilter != ReferenceSector)
@@ -1633,36 +1740,60 @@ const struct CompanyValue UFlareCompany::GetCompanyValue(UFlareSimulatedSector*
 	CompanyValue.SpacecraftsValue = CompanyValue.ShipsValue + CompanyValue.StationsValue;
 	CompanyValue.TotalValue = CompanyValue.MoneyValue + CompanyValue.StockValue + CompanyValue.SpacecraftsValue;
 
-	if(globalRequest)
+	return CompanyValue;
+}
+
+void UFlareCompany::AddStockValue(UFlareSimulatedSpacecraft* Spacecraft, FFlareResourceDescription* Resource, int32 Quantity)
+{
+	if (Quantity == 0 || !Resource)
 	{
-		CompanyValueCacheValid = true;
-		CompanyValueCache = CompanyValue;
+		return;
 	}
 
-	return CompanyValue;
+	// Complex elements are valued with their master, which owns their factories
+	if (Spacecraft->IsComplexElement() && Spacecraft->GetComplexMaster())
+	{
+		Spacecraft = Spacecraft->GetComplexMaster();
+	}
+
+	FScopeLock Lock(&CompanyValueLock);
+
+	// The next query will value everything anyway
+	if (!CompanyAssetsValueValid)
+	{
+		return;
+	}
+
+	UFlareSimulatedSector* ReferenceSector = GetValueReferenceSector(Spacecraft);
+	if (ReferenceSector)
+	{
+		CompanyAssetsValue.StockValue += ReferenceSector->GetResourcePrice(Resource, EFlareResourcePriceContext::Default) * Quantity;
+	}
 }
 
-UFlareSimulatedSpacecraft* UFlareCompany::FindSpacecraft(FName ShipImmatriculation, bool Destroyed)
+UFlareSimulatedSector* UFlareCompany::GetValueReferenceSector(UFlareSimulatedSpacecraft* Spacecraft) const
 {
-	if(!Destroyed )
+	if (Spacecraft->GetCurrentSector())
 	{
-		for (UFlareSimulatedSpacecraft* Spacecraft : CompanySpacecrafts)
-		{
-			if (Spacecraft->GetImmatriculation() == ShipImmatriculation)
-			{
-				return Spacecraft;
-			}
-		}
+		return Spacecraft->GetCurrentSector();
 	}
-	else
+	else if (Spacecraft->GetCurrentFleet() && Spacecraft->GetCurrentFleet()->GetCurrentTravel())
 	{
-		for (UFlareSimulatedSpacecraft* Spacecraft : CompanyDestroyedSpacecrafts)
-		{
-			if (Spacecraft->GetImmatriculation() == ShipImmatriculation)
-			{
-				return Spacecraft;
-			}
-		}
+		return Spacecraft->GetCurrentFleet()->GetCurrentTravel()->GetDestinationSector();
+	}
+
+	return NULL;
+}
+
+UFlareSimulatedSpacecraft* UFlareCompany::FindSpacecraft(FName ShipImmatriculation, bool Destroyed)
+{
+	UFlareWorld* World = GetGame()->GetGameWorld();
+	UFlareSimulatedSpacecraft* Spacecraft = Destroyed ? World->FindDestroyedSpacecraft(ShipImmatriculation) : World->FindAliveSpacecraft(ShipImmatriculation);
+
+	// The world indexes every company
+	if (Spacecraft && Spacecraft->GetCompany() == this)
+	{
+		return Spacecraft;
 	}
 
 	return NULL;
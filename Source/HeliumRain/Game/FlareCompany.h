@@ -35,8 +35,8 @@ public:
 	/** Post Load to perform task needing sectors to be loaded */
 	virtual void PostLoad();
 
-	/** Save the company to a save file */
-	virtual FFlareCompanySave* Save();
+	/** Save the company into a save snapshot, each spacecraft is copied once */
+	virtual void Save(FFlareCompanySave& SaveData);
 
 	/** Spawn a simulated spacecraft from save data */
 	virtual UFlareSimulatedSpacecraft* LoadSpacecraft(const FFlareSpacecraftSave& SpacecraftData);
@@ -71,6 +71,9 @@ public:
 
 	bool IsAtWar(const UFlareCompany* TargetCompany) const;
 
+	/** Check if this company declared war on the target company, from the save data */
+	bool IsHostileNoCache(const UFlareCompany* TargetCompany) const;
+
 	void ResetLastPeaceDate();
 	void SetLastWarDate();
 	void ClearLastWarDate();
@@ -196,6 +199,21 @@ public:
 
 protected:
 
+	/** Swap the spacecraft, fleet, route, knowledge and technology lists of two company saves */
+	static void SwapSaveLists(FFlareCompanySave& A, FFlareCompanySave& B);
+
+	/** Add a player transaction to the log and to the daily balances */
+	void LogTransaction(const FFlareTransactionLogEntry& TransactionContext);
+
+	/** Add a transaction to the balance of its day and category */
+	void AddTransactionBalance(const FFlareTransactionLogEntry& TransactionContext);
+
+	/** Drop the oldest log entries above MaxSize */
+	void TrimTransactionLog(int32 MaxSize);
+
+	/** Detailed transactions kept in the log, the balances keep the whole history */
+	static const int32 TransactionLogSize = 2000;
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -244,8 +262,22 @@ protected:
 	int32                                   ResearchAmount;
 	TMap<FName, FFlareTechnologyDescription*> UnlockedTechnologies;
 
-	mutable struct CompanyValue						CompanyValueCache;
-	mutable bool									CompanyValueCacheValid;
+	/** Index in the world company list, INDEX_NONE until the company is registered */
+	int32                                   WorldIndex;
+
+	/** Value of the spacecraft and stock, kept up to date by cargo changes. Money is read live on top of it */
+	mutable struct CompanyValue             CompanyAssetsValue;
+	mutable bool                            CompanyAssetsValueValid;
+
+	/** Cargo changes may come from sectors simulated in parallel */
+	mutable FCriticalSection                CompanyValueLock;
+
+	/** Sector whose prices value a spacecraft : its sector, or its travel destination */
+	UFlareSimulatedSector* GetValueReferenceSector(UFlareSimulatedSpacecraft* Spacecraft) const;
+
+	/** Full value computation, for a sector or for the whole company */
+	const struct CompanyValue ComputeCompanyValue(UFlareSimulatedSector* SectorFilter, bool IncludeIncoming) const;
+
 public:
 
 	/*----------------------------------------------------
@@ -253,11 +285,16 @@ public:
 	----------------------------------------------------*/
 
 
+	/** Spacecraft, prices or combat points changed, the assets will be valued again on the next query */
 	void InvalidateCompanyValueCache()
 	{
-		CompanyValueCacheValid = false;
+		FScopeLock Lock(&CompanyValueLock);
+		CompanyAssetsValueValid = false;
 	}
 
+	/** Quantity of a resource was added to (or removed from, if negative) a spacecraft of the company */
+	void AddStockValue(UFlareSimulatedSpacecraft* Spacecraft, FFlareResourceDescription* Resource, int32 Quantity);
+
 	/** Get the hostility text */
 	FText GetPlayerHostilityText() const;
 
@@ -468,6 +505,21 @@ public:
 		return CompanyData.TransactionLog;
 	}
 
+	TArray<FFlareTransactionLogBalance> const& GetTransactionBalances() const
+	{
+		return CompanyData.TransactionBalances;
+	}
+
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	float GetRetaliation() const
 	{
 		return CompanyData.Retaliation;
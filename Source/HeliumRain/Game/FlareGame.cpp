@@ -34,7 +34,7 @@
 #include "../Player/FlarePlayerController.h"
 
 #include "../Spacecrafts/FlareBomb.h"
-#include "../Spacecrafts/FlareShell.h"
+#include "../Spacecrafts/FlareShellManager.h"
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
 
 #include "../Quests/FlareQuestManager.h"
@@ -238,7 +238,9 @@ UFlareSimulatedSector* AFlareGame::DeactivateSector()
 
 	UFlareSimulatedSector* Sector = ActiveSector->GetSimulatedSector();
 	FLOGV("AFlareGame::DeactivateSector : %s", *Sector->GetSectorName().ToString());
-	World->Save();
+	// Sync the active sector and spacecraft into their save data
+	FFlareWorldSave WorldSave;
+	World->Save(WorldSave);
 
 	// Set last flown ship
 	UFlareSimulatedSpacecraft* PlayerShip = NULL;
@@ -939,6 +941,16 @@ bool AFlareGame::LoadGame(AFlarePlayerController* PC)
 		PC->OnLoadComplete();
 		FFlareLogWriter::InitWriter(Save->PlayerData.UUID);
 
+		// The latest autosaves were lost
+		if (Save->JournalFailed)
+		{
+			PC->Notify(LOCTEXT("JournalFailed", "Autosave lost"),
+				LOCTEXT("JournalFailedInfo", "The latest autosave of this game is corrupted, the game was restored from the previous full save."),
+				FName("journal-failed"),
+				EFlareNotification::NT_Info,
+				true);
+		}
+
 		World->ProcessIncomingPlayerEnemy();
 
 		return true;
@@ -971,7 +983,7 @@ protected:
 	void DoWork()
 	{
 		FLOG("Async save start");
-		SaveSystem->SaveGame(SaveName, SaveData);
+		SaveSystem->SaveGame(SaveName, SaveData, true);
 		FLOG("Async save end");
 	}
 
@@ -1011,7 +1023,8 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 	{
 		// Save the player
 		PC->Save(Save->PlayerData, Save->PlayerCompanyDescription);
-		Save->WorldData = *World->Save();
+		World->Save(Save->WorldData);
+		Save->SaveRevision = UFlareSaveGame::NewSaveRevision();
 		Save->CurrentImmatriculationIndex = CurrentImmatriculationIndex;
 		Save->CurrentIdentifierIndex = CurrentIdentifierIndex;
 		Save->PlayerData.QuestData = *QuestManager->Save();
@@ -1023,7 +1036,7 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 
 		// Save prototype
 
-		SaveGameSystem->PushSaveData(Save);
+		SaveGameSystem->PushSaveData(SaveName, Save);
 
 		if(Async)
 		{
@@ -1031,7 +1044,7 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async, bool Force)
 		}
 		else
 		{
-			SaveGameSystem->SaveGame(SaveName, Save);
+			return (SaveGameSystem->SaveGame(SaveName, Save) == EFlareSaveResult::Saved);
 		}
 
 		return true;
@@ -1074,7 +1087,7 @@ void AFlareGame::UnloadGame()
 	for (int32 Index = 0; Index < ActorList.Num(); Index++)
 	{
 		if (ActorList[Index]->IsA(AFlareBomb::StaticClass())
-		 || ActorList[Index]->IsA(AFlareShell::StaticClass())
+		 || ActorList[Index]->IsA(AFlareShellManager::StaticClass())
 		 || ActorList[Index]->IsA(AFlareSpacecraft::StaticClass()))
 		{
 			ActorCount++;
@@ -435,6 +435,11 @@ public:
 		return SkirmishManager;
 	}
 
+	inline UFlareSaveGameSystem* GetSaveGameSystem() const
+	{
+		return SaveGameSystem;
+	}
+
 	inline bool IsLoadedOrCreated() const
 	{
 		return LoadedOrCreated;
@@ -21,6 +21,8 @@
 #include "Quests/FlareQuestStep.h"
 #include "Quests/FlareQuestManager.h"
 
+#include "Save/FlareSaveGameSystem.h"
+
 #define LOCTEXT_NAMESPACE "FlareGameTools"
 
 bool UFlareGameTools::FastFastForward = false;
@@ -375,8 +377,8 @@ void UFlareGameTools::PrintEconomyStatus()
 	FLOG("=============");
 	FLOG("");
 
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
-	WorldStats = WorldHelper::ComputeWorldResourceStats(GetGame(), true);
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+	WorldStats = GetGame()->GetGameWorld()->GetWorldResourceStats(true);
 
 
 	TArray<UFlareResourceCatalogEntry*> ResourceEntries = GetGame()->GetResourceCatalog()->Resources;
@@ -384,19 +386,19 @@ void UFlareGameTools::PrintEconomyStatus()
 	{
 		FFlareResourceDescription* Resource = &ResourceEntries[ResourceIndex]->Data;
 
-		if (WorldStats.Contains(Resource))
+		if (WorldStats.IsValidIndex(Resource->CatalogIndex))
 		{
 			FLOGV("Resource '%s'", *Resource->Name.ToString());
-			FLOGV("- Stock: %d", WorldStats[Resource].Stock);
-			FLOGV("- Production: %.2f", WorldStats[Resource].Production);
-			FLOGV("- Consumption: %.2f", WorldStats[Resource].Consumption);
-			if(WorldStats[Resource].Balance < 0)
+			FLOGV("- Stock: %d", WorldStats[Resource->CatalogIndex].Stock);
+			FLOGV("- Production: %.2f", WorldStats[Resource->CatalogIndex].Production);
+			FLOGV("- Consumption: %.2f", WorldStats[Resource->CatalogIndex].Consumption);
+			if(WorldStats[Resource->CatalogIndex].Balance < 0)
 			{
-				FLOGV("- " RED "Balance: %.2f" RESET, WorldStats[Resource].Balance);
+				FLOGV("- " RED "Balance: %.2f" RESET, WorldStats[Resource->CatalogIndex].Balance);
 			}
 			else
 			{
-				FLOGV("- Balance: %.2f", WorldStats[Resource].Balance);
+				FLOGV("- Balance: %.2f", WorldStats[Resource->CatalogIndex].Balance);
 			}
 		}
 	}
@@ -561,6 +563,87 @@ void UFlareGameTools::SetFastFastForward(bool FFF)
 	FastFastForward = FFF;
 }
 
+void UFlareGameTools::BenchmarkSimulation(int32 SaveSlot, int32 DayCount)
+{
+	AFlareGame* Game = GetGame();
+
+	Game->ReadAllSaveSlots();
+	if (!Game->DoesSaveSlotExist(SaveSlot))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	// Leave the current game without saving it
+	if (Game->IsLoadedOrCreated())
+	{
+		Game->UnloadGame();
+	}
+
+	Game->SetCurrentSlot(SaveSlot);
+	if (!Game->LoadGame(GetPC()))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation failed: could not load slot %d", SaveSlot);
+		return;
+	}
+
+	UFlareWorld* World = GetGameWorld();
+	FFlareSimulationProfiler& Profiler = World->GetSimulationProfiler();
+	Profiler.Clear();
+	Profiler.SetHistorySize(DayCount);
+	bool Autosave = Game->AutoSave;
+	Game->AutoSave = false;
+
+	FLOGV("UFlareGameTools::BenchmarkSimulation : simulating %d days from date %lld", DayCount, World->GetDate());
+	double StartTime = FPlatformTime::Seconds();
+
+	for (int32 DayIndex = 0; DayIndex < DayCount; DayIndex++)
+	{
+		World->FastForward();
+	}
+
+	FLOGV("UFlareGameTools::BenchmarkSimulation : %d days simulated in %.3fs", DayCount, FPlatformTime::Seconds() - StartTime);
+	Profiler.PrintReport();
+
+	// Don't keep the simulated state
+	Game->UnloadGame();
+	Game->AutoSave = Autosave;
+	GetPC()->GetMenuManager()->OpenMenu(EFlareMenu::MENU_LoadGame);
+}
+
+void UFlareGameTools::ExportSave(int32 SaveSlot)
+{
+	AFlareGame* Game = GetGame();
+
+	UFlareSaveGame* Save = Game->ReadSaveSlot(SaveSlot);
+	if (!Save)
+	{
+		FLOGV("UFlareGameTools::ExportSave failed: could not read slot %d", SaveSlot);
+		return;
+	}
+
+	if (Game->GetSaveGameSystem()->ExportGame(Game->GetSaveFileName(SaveSlot), Save))
+	{
+		FLOGV("UFlareGameTools::ExportSave : slot %d exported to '%s'", SaveSlot,
+			*UFlareSaveGameSystem::GetExportPath(Game->GetSaveFileName(SaveSlot)));
+	}
+	else
+	{
+		FLOGV("UFlareGameTools::ExportSave failed: could not write slot %d", SaveSlot);
+	}
+}
+
+void UFlareGameTools::PrintSimulationProfile()
+{
+	if (!GetGameWorld())
+	{
+		FLOG("UFlareGameTools::PrintSimulationProfile failed: no loaded world");
+		return;
+	}
+
+	GetGameWorld()->GetSimulationProfiler().PrintReport();
+}
+
 /*----------------------------------------------------
 	Company tools
 ----------------------------------------------------*/
@@ -1779,7 +1862,8 @@ void UFlareGameTools::CreateMeteoriteGroup(FName SectorIdentifier, float PowerRa
 
 	UFlareSimulatedSector* ActiveSector = GetGame()->DeactivateSector();
 
-	ActiveSector->GenerateMeteoriteGroup(TargetStation, PowerRatio);
+	FRandomStream MeteoriteStream(FMath::Rand());
+	ActiveSector->GenerateMeteoriteGroup(TargetStation, PowerRatio, MeteoriteStream);
 
 	GetGame()->ActivateCurrentSector();
 }
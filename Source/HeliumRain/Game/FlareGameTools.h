@@ -95,6 +95,18 @@ public:
 	UFUNCTION(exec)
 	void SetFastFastForward(bool FFF);
 
+	/** Load a save slot, simulate some days and print per-phase timings, then unload without saving */
+	UFUNCTION(exec)
+	void BenchmarkSimulation(int32 SaveSlot, int32 DayCount);
+
+	/** Write a save slot as readable JSON next to the binary save */
+	UFUNCTION(exec)
+	void ExportSave(int32 SaveSlot);
+
+	/** Print per-phase timings of the last simulated days */
+	UFUNCTION(exec)
+	void PrintSimulationProfile();
+
 	/*----------------------------------------------------
 		Company tools
 	----------------------------------------------------*/
@@ -302,6 +302,28 @@ struct FFlareTransactionLogEntry
 	FText GetComment(AFlareGame* Game) const;
 };
 
+/** Sum of the transactions of a category during a day */
+USTRUCT()
+struct FFlareTransactionLogBalance
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 Date;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	TEnumAsByte<EFlareTransactionLogEntry::Type> Type;
+
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 Amount;
+
+	FFlareTransactionLogBalance()
+		: Date(0)
+		, Type(EFlareTransactionLogEntry::ManualResourcePurchase)
+		, Amount(0)
+	{}
+};
+
 /** Game save data */
 USTRUCT()
 struct FFlareCompanySave
@@ -398,10 +420,14 @@ struct FFlareCompanySave
 	UPROPERTY(EditAnywhere, Category = Save)
 	TArray<FName> CaptureOrders;
 
-	/** List of company transactions */
+	/** Recent company transactions, older ones only remain in the balances */
 	UPROPERTY(EditAnywhere, Category = Save)
 	TArray<FFlareTransactionLogEntry> TransactionLog;
 
+	/** Company transaction totals by day and category, in date order */
+	UPROPERTY(EditAnywhere, Category = Save)
+	TArray<FFlareTransactionLogBalance> TransactionBalances;
+
 	/** Quantity of damage deal to others companies */
 	UPROPERTY(EditAnywhere, Category = Save)
 	float Retaliation;
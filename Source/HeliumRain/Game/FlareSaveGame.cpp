@@ -7,8 +7,17 @@
 	Constructor
 ----------------------------------------------------*/
 
+int64 UFlareSaveGame::CurrentSaveRevision = 0;
+
 UFlareSaveGame::UFlareSaveGame(const class FObjectInitializer& PCIP)
 	: Super(PCIP)
+	, SaveRevision(0)
+	, JournalFailed(false)
+{
+}
+
+int64 UFlareSaveGame::NewSaveRevision()
 {
+	return ++CurrentSaveRevision;
 }
 
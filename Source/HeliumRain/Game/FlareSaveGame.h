@@ -146,5 +146,30 @@ public:
 
 	UPROPERTY(VisibleAnywhere, Category = Save)
 	bool AutoSave;
+
+
+	/*----------------------------------------------------
+		Runtime data, not saved
+	----------------------------------------------------*/
+
+	/** Revision of the game state in this snapshot, spacecrafts changed later have a higher revision */
+	int64 SaveRevision;
+
+	/** The journal of this save could not be applied, the last full save was loaded instead */
+	bool JournalFailed;
+
+	/** Take the revision of a new snapshot */
+	static int64 NewSaveRevision();
+
+	/** Revision of changes made now, they will be part of the next snapshot */
+	static int64 GetChangeRevision()
+	{
+		return CurrentSaveRevision + 1;
+	}
+
+protected:
+
+	/** Revision of the last snapshot, only changed on the game thread */
+	static int64 CurrentSaveRevision;
 };
 
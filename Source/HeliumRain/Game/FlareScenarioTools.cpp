@@ -587,6 +587,7 @@ void UFlareScenarioTools::CreateStations(FName StationClass, UFlareCompany* Comp
 			}
 
 			Station->GetData().Level = Level;
+			Station->SetSaveDirty();
 
 			if (Station->GetFactories().Num() > 0)
 			{
@@ -9,9 +9,11 @@
 
 #include "../Player/FlarePlayerController.h"
 
-#include "../Spacecrafts/FlareShell.h"
+#include "../Spacecrafts/FlareShellManager.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
 
+#include "EngineUtils.h"
+
 
 /*----------------------------------------------------
 	Constructor
@@ -22,6 +24,9 @@ UFlareSector::UFlareSector(const FObjectInitializer& ObjectInitializer)
 {
 	SectorRepartitionCache = false;
 	IsDestroyingSector = false;
+	SpatialIndexFrame = 0;
+	SpatialIndexValid = false;
+	ShellManager = NULL;
 }
 
 /*----------------------------------------------------
@@ -34,6 +39,12 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	ParentSector = Parent;
 	LocalTime = Parent->GetData()->LocalTime;
 
+	// Shells
+	FActorSpawnParameters ShellManagerParams;
+	ShellManagerParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ShellManager = GetGame()->GetWorld()->SpawnActor<AFlareShellManager>(AFlareShellManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, ShellManagerParams);
+	ShellManager->Initialize(this);
+
 	// Load asteroids
 	for (int i = 0 ; i < ParentSector->GetData()->AsteroidData.Num(); i++)
 	{
@@ -132,9 +143,10 @@ void UFlareSector::DestroySector()
 		Meteorite->Destroy();
 	}
 
-	for (int ShellIndex = 0 ; ShellIndex < SectorShells.Num(); ShellIndex++)
+	if (ShellManager)
 	{
-		SectorShells[ShellIndex]->Destroy();
+		ShellManager->Destroy();
+		ShellManager = NULL;
 	}
 
 	SectorSpacecrafts.Empty();
@@ -143,7 +155,7 @@ void UFlareSector::DestroySector()
 	SectorBombs.Empty();
 	SectorAsteroids.Empty();
 	SectorMeteorites.Empty();
-	SectorShells.Empty();
+	InvalidateSpatialIndex();
 
 	IsDestroyingSector = false;
 }
@@ -163,6 +175,7 @@ AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidDat
     Asteroid->Load(AsteroidData);
 
 	SectorAsteroids.AddUnique(Asteroid);
+	InvalidateSpatialIndex();
     return Asteroid;
 }
 
@@ -176,6 +189,7 @@ AFlareMeteorite* UFlareSector::LoadMeteorite(FFlareMeteoriteSave& MeteoriteData)
 	Meteorite->Load(&MeteoriteData, this);
 
 	SectorMeteorites.AddUnique(Meteorite);
+	InvalidateSpatialIndex();
 	return Meteorite;
 }
 
@@ -216,6 +230,7 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 			SectorShips.Add(Spacecraft);
 		}
 		SectorSpacecrafts.Add(Spacecraft);
+		InvalidateSpatialIndex();
 
 		switch (ParentSpacecraft->GetData().SpawnMode)
 		{
@@ -422,6 +437,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
                 RootComponent->SetPhysicsAngularVelocityInDegrees(BombData.AngularVelocity, false);
 
 				SectorBombs.Add(Bomb);
+				InvalidateSpatialIndex();
             }
             else
             {
@@ -444,6 +460,7 @@ AFlareBomb* UFlareSector::LoadBomb(const FFlareBombSave& BombData)
 void UFlareSector::RegisterBomb(AFlareBomb* Bomb)
 {
 	SectorBombs.AddUnique(Bomb);
+	InvalidateSpatialIndex();
 }
 
 void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
@@ -451,6 +468,7 @@ void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 	if (!IsDestroyingSector)
 	{
 		SectorBombs.Remove(Bomb);
+		InvalidateSpatialIndex();
 	}
 
 	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
@@ -459,19 +477,6 @@ void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 	}
 }
 
-void UFlareSector::RegisterShell(AFlareShell* Shell)
-{
-	SectorShells.AddUnique(Shell);
-}
-
-void UFlareSector::UnregisterShell(AFlareShell* Shell)
-{
-	if (!IsDestroyingSector)
-	{
-		SectorShells.Remove(Shell);
-	}
-}
-
 void UFlareSector::SetPause(bool Pause)
 {
 	for (int i = 0 ; i < SectorSpacecrafts.Num(); i++)
@@ -494,58 +499,49 @@ void UFlareSector::SetPause(bool Pause)
 		Meteorite->SetPause(Pause);
 	}
 
-	for (int i = 0 ; i < SectorShells.Num(); i++)
+	if (ShellManager)
 	{
-		SectorShells[i]->SetPause(Pause);
+		ShellManager->SetPause(Pause);
 	}
 }
 
 
 AActor* UFlareSector::GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize, AActor* ActorToIgnore)
 {
-	AActor* NearestCandidateActor = NULL;
-	float NearestCandidateActorDistance = 0;
-
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
+	// Body size as seen by this test
+	auto GetCandidateSize = [](AActor* Candidate)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = GetSpacecrafts()[SpacecraftIndex];
-		float Distance = FVector::Dist(SpacecraftCandidate->GetActorLocation(), Location) - SpacecraftCandidate->GetMeshScale();
-		if (SpacecraftCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+		AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Candidate);
+		if (SpacecraftCandidate)
 		{
-			NearestCandidateActor = SpacecraftCandidate;
-			NearestCandidateActorDistance = Distance;
+			return SpacecraftCandidate->GetMeshScale();
 		}
-	}
-
-	for (int32 AsteroidIndex = 0; AsteroidIndex < GetAsteroids().Num(); AsteroidIndex++)
-	{
-		AFlareAsteroid* AsteroidCandidate = GetAsteroids()[AsteroidIndex];
-
-		FBox CandidateBox = AsteroidCandidate->GetComponentsBoundingBox();
-		float CandidateSize = FMath::Max(CandidateBox.GetExtent().Size(), 1.0f);
-
-		float Distance = FVector::Dist(AsteroidCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (AsteroidCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
+		else if (Cast<AFlareAsteroid>(Candidate))
 		{
-			NearestCandidateActor = AsteroidCandidate;
-			NearestCandidateActorDistance = Distance;
+			FBox CandidateBox = Candidate->GetComponentsBoundingBox();
+			return FMath::Max(CandidateBox.GetExtent().Size(), 1.0f);
 		}
-	}
+		else
+		{
+			return Cast<UStaticMeshComponent>(Candidate->GetRootComponent())->Bounds.SphereRadius;
+		}
+	};
 
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
+	TArray<AActor*> NearestCandidates;
+	GetSpatialIndex().QueryNearest(Location, 1, EFlareSpatialBody::Spacecraft | EFlareSpatialBody::Asteroid | EFlareSpatialBody::Collider,
+		[&](AActor* Candidate, float& Distance)
 	{
-		AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
+		Distance = FVector::Dist(Candidate->GetActorLocation(), Location) - GetCandidateSize(Candidate);
+		return Candidate != ActorToIgnore;
+	}, NearestCandidates);
 
-		float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
+	AActor* NearestCandidateActor = NULL;
+	float NearestCandidateActorDistance = 0;
 
-		float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (ColliderCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
-		{
-			NearestCandidateActor = ColliderCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
+	if (NearestCandidates.Num())
+	{
+		NearestCandidateActor = NearestCandidates[0];
+		NearestCandidateActorDistance = FVector::Dist(NearestCandidateActor->GetActorLocation(), Location) - GetCandidateSize(NearestCandidateActor);
 	}
 
 	*NearestDistance = NearestCandidateActorDistance;
@@ -579,13 +575,14 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 #if !UE_BUILD_SHIPPING
 	{
 		TArray<AActor*> ColliderActorList;
-		UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
+		float SpacecraftSize = Spacecraft->GetSimpleCollisionRadius();
+		GetSpatialIndex().QueryRadius(Location, SpacecraftSize, EFlareSpatialBody::Collider, ColliderActorList);
+
 		for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
 		{
 			AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
 
 			float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
-			float SpacecraftSize = Spacecraft->GetSimpleCollisionRadius();
 			float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location);
 			
 			if (Distance < CandidateSize + SpacecraftSize)
@@ -597,12 +594,87 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 #endif
 
 	Spacecraft->SetActorLocation(Location);
+	InvalidateSpatialIndex();
 }
 
+
 /*----------------------------------------------------
-	Getters
+	Spatial queries
 ----------------------------------------------------*/
 
+FFlareSectorSpatialIndex& UFlareSector::GetSpatialIndex()
+{
+	if (!SpatialIndexValid || SpatialIndexFrame != GFrameCounter)
+	{
+		UpdateSpatialIndex();
+	}
+
+	return SpatialIndex;
+}
+
+void UFlareSector::InvalidateSpatialIndex()
+{
+	SpatialIndexValid = false;
+}
+
+int32 UFlareSector::GetIncomingBombCount(AFlareSpacecraft* Spacecraft)
+{
+	GetSpatialIndex();
+
+	int32* Count = IncomingBombCounts.Find(Spacecraft);
+	return Count ? *Count : 0;
+}
+
+void UFlareSector::UpdateSpatialIndex()
+{
+	// The bounding box extent of a rotating body changes, by up to sqrt(3) from its smallest value
+	auto GetRotatingBodyRadius = [](AActor* Body)
+	{
+		FBox Box = Body->GetComponentsBoundingBox();
+		return FMath::Max(Box.GetExtent().Size(), 1.0f) * 1.7321f;
+	};
+
+	SpatialIndex.Reset(GetGame()->GetWorld()->GetDeltaSeconds());
+	IncomingBombCounts.Reset();
+
+	// Insertion order is the order callers iterate the sector lists in
+	for (AFlareSpacecraft* Spacecraft : SectorSpacecrafts)
+	{
+		SpatialIndex.Add(Spacecraft, EFlareSpatialBody::Spacecraft, Spacecraft->GetMeshScale(), Spacecraft->Airframe->GetPhysicsLinearVelocity().Size());
+	}
+
+	for (AFlareAsteroid* Asteroid : SectorAsteroids)
+	{
+		SpatialIndex.Add(Asteroid, EFlareSpatialBody::Asteroid, GetRotatingBodyRadius(Asteroid), Asteroid->GetAsteroidComponent()->GetPhysicsLinearVelocity().Size());
+	}
+
+	for (AFlareBomb* Bomb : SectorBombs)
+	{
+		UPrimitiveComponent* RootComponent = Cast<UPrimitiveComponent>(Bomb->GetRootComponent());
+		SpatialIndex.Add(Bomb, EFlareSpatialBody::Bomb, GetRotatingBodyRadius(Bomb), RootComponent->GetPhysicsLinearVelocity().Size());
+
+		if (Bomb->IsActive() && Bomb->GetTargetSpacecraft())
+		{
+			IncomingBombCounts.FindOrAdd(Bomb->GetTargetSpacecraft())++;
+		}
+	}
+
+	for (AFlareMeteorite* Meteorite : SectorMeteorites)
+	{
+		SpatialIndex.Add(Meteorite, EFlareSpatialBody::Meteorite, GetRotatingBodyRadius(Meteorite), Meteorite->GetMeteoriteComponent()->GetPhysicsLinearVelocity().Size());
+	}
+
+	// Colliders are level actors
+	for (TActorIterator<AFlareCollider> ColliderItr(GetGame()->GetWorld()); ColliderItr; ++ColliderItr)
+	{
+		AFlareCollider* Collider = *ColliderItr;
+		SpatialIndex.Add(Collider, EFlareSpatialBody::Collider, Cast<UStaticMeshComponent>(Collider->GetRootComponent())->Bounds.SphereRadius, 0);
+	}
+
+	SpatialIndexFrame = GFrameCounter;
+	SpatialIndexValid = true;
+}
+
 TArray<AFlareSpacecraft*> UFlareSector::GetCompanyShips(UFlareCompany* Company)
 {
 	TArray<AFlareSpacecraft*> CompanyShips;
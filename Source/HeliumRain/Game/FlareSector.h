@@ -6,11 +6,13 @@
 #include "FlareAsteroid.h"
 #include "../Quests/FlareMeteorite.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSectorSpatialIndex.h"
 #include "FlareSector.generated.h"
 
 class UFlareSimulatedSector;
 class AFlareGame;
 class AFlareAsteroid;
+class AFlareShellManager;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSector : public UObject
@@ -49,18 +51,30 @@ public:
 
 	void UnregisterBomb(AFlareBomb* Bomb);
 
-	void RegisterShell(AFlareShell* Shell);
-
-	void UnregisterShell(AFlareShell* Shell);
-
 	virtual void SetPause(bool Pause);
 
 	AActor* GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize = true, AActor* ActorToIgnore = NULL);
 
 	void PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location);
 
+
+	/*----------------------------------------------------
+		Spatial queries
+	----------------------------------------------------*/
+
+	/** Get the index of spacecrafts, asteroids, bombs, meteorites and colliders, rebuilt on the first use of each frame */
+	FFlareSectorSpatialIndex& GetSpatialIndex();
+
+	/** Rebuild the spatial index on next use, when bodies are added, removed or moved outside of physics */
+	void InvalidateSpatialIndex();
+
+	/** Get the count of active bombs targeting this spacecraft */
+	int32 GetIncomingBombCount(AFlareSpacecraft* Spacecraft);
+
 protected:
 
+	void UpdateSpatialIndex();
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -84,8 +98,15 @@ protected:
 
 	UPROPERTY()
 	TArray<AFlareBomb*>            SectorBombs;
+
+	/** Gun shells of the sector */
 	UPROPERTY()
-	TArray<AFlareShell*>           SectorShells;
+	AFlareShellManager*            ShellManager;
+
+	FFlareSectorSpatialIndex       SpatialIndex;
+	uint64                         SpatialIndexFrame;
+	bool                           SpatialIndexValid;
+	TMap<AFlareSpacecraft*, int32> IncomingBombCounts;
 
 	int64						   LocalTime;
 	bool						   SectorRepartitionCache;
@@ -156,6 +177,11 @@ public:
 		return SectorMeteorites;
 	}
 
+	inline AFlareShellManager* GetShellManager()
+	{
+		return ShellManager;
+	}
+
 	inline TArray<AFlareBomb*>& GetBombs()
 	{
 		return SectorBombs;
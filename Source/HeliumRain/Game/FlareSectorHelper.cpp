@@ -935,14 +935,14 @@ int32 SectorHelper::GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UF
 }
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage)
+TArray<WorldHelper::FlareResourceStats> SectorHelper::ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage)
 {
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
 
 	// Init
+	WorldStats.Reserve(Sector->GetGame()->GetResourceCatalog()->Resources.Num());
 	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
 		WorldHelper::FlareResourceStats ResourceStats;
 		ResourceStats.Production = 0;
 		ResourceStats.Consumption = 0;
@@ -950,7 +950,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 		ResourceStats.Stock = 0;
 		ResourceStats.Capacity = 0;
 
-		WorldStats.Add(Resource, ResourceStats);
+		WorldStats.Add(ResourceStats);
 	}
 
 	for (int SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSectorSpacecrafts().Num(); SpacecraftIndex++)
@@ -973,7 +973,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 				continue;
 			}
 
-			WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Cargo.Resource];
+			WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Cargo.Resource->CatalogIndex];
 
 			FFlareResourceUsage Usage = Spacecraft->GetResourceUseType(Cargo.Resource);
 
@@ -1001,7 +1001,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 					for(const FFlareFactoryResource& FactoryResource : ProductionData->InputResources)
 					{
 						const FFlareResourceDescription* Resource = &FactoryResource.Resource->Data;
-						WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+						WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 						int64 ProductionDuration = ProductionData->ProductionTime;
 
@@ -1033,7 +1033,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 
@@ -1055,7 +1055,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
 				FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+				WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 				int64 ProductionDuration = Factory->GetProductionDuration();
 				if (ProductionDuration == 0)
@@ -1071,7 +1071,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 
 	// FS
 	FFlareResourceDescription* FleetSupply = Sector->GetGame()->GetScenarioTools()->FleetSupply;
-	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply];
+	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply->CatalogIndex];
 	FFlareFloatBuffer* Stats = &Sector->GetData()->FleetSupplyConsumptionStats;
 	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
 	FSResourceStats->Consumption += MeanConsumption;
@@ -1082,7 +1082,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for (int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 		ResourceStats->Consumption += Sector->GetPeople()->GetRessourceConsumption(Resource, false);
 	}
@@ -1091,7 +1091,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorHelper::
 	for(int32 ResourceIndex = 0; ResourceIndex < Sector->GetGame()->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Sector->GetGame()->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FlareWorld.h"
 #include "FlareWorldHelper.h"
 #include "../Economy/FlareResource.h"
 #include "../Game/FlareTradeRoute.h"
@@ -52,7 +53,7 @@ struct SectorHelper
 
 	static int32 GetCompanyArmyCombatPoints(UFlareSimulatedSector* Sector, UFlareCompany* Company, bool ReduceByDamage);
 
-	static TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage);
+	static TArray<WorldHelper::FlareResourceStats> ComputeSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage);
 
 	static int64 GetSellResourcePrice(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, FFlareResourceUsage Usage);
 
@@ -0,0 +1,269 @@
+#include "FlareSectorSpatialIndex.h"
+
+
+const float FFlareSectorSpatialIndex::CellSize = 100000; // 1km
+const float FFlareSectorSpatialIndex::MinMargin = 1000; // 10m
+const float FFlareSectorSpatialIndex::LargeBodyRadius = 200000; // 2km
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSectorSpatialIndex::FFlareSectorSpatialIndex()
+	: Bounds(ForceInit)
+	, DeltaSeconds(0)
+	, Margin(MinMargin)
+	, MaxSpacecraftSpeed(0)
+	, QueryStamp(0)
+{
+}
+
+
+/*----------------------------------------------------
+	Build
+----------------------------------------------------*/
+
+void FFlareSectorSpatialIndex::Reset(float InDeltaSeconds)
+{
+	Entries.Reset();
+	Cells.Reset();
+	LargeEntries.Reset();
+	Bounds = FBox(ForceInit);
+	DeltaSeconds = InDeltaSeconds;
+	Margin = MinMargin;
+	MaxSpacecraftSpeed = 0;
+}
+
+void FFlareSectorSpatialIndex::Add(AActor* Actor, EFlareSpatialBody::Type Type, float Radius, float Speed)
+{
+	FEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Radius = Radius;
+	Entry.Type = Type;
+	Entry.Stamp = 0;
+
+	int32 EntryIndex = Entries.Add(Entry);
+	Bounds += FBox(Entry.Location - FVector(Radius), Entry.Location + FVector(Radius));
+
+	// Queries must still find the body after it moved for a frame, from either side
+	Margin = FMath::Max(Margin, MinMargin + 2 * Speed * DeltaSeconds);
+
+	if (Type == EFlareSpatialBody::Spacecraft)
+	{
+		MaxSpacecraftSpeed = FMath::Max(MaxSpacecraftSpeed, Speed);
+	}
+
+	if (Radius > LargeBodyRadius)
+	{
+		LargeEntries.Add(EntryIndex);
+		return;
+	}
+
+	// Add the body to every cell its sphere overlaps
+	FIntVector MinCell = GetCell(Entry.Location - FVector(Radius));
+	FIntVector MaxCell = GetCell(Entry.Location + FVector(Radius));
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(EntryIndex);
+			}
+		}
+	}
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+void FFlareSectorSpatialIndex::QueryRadius(FVector Center, float Radius, int32 TypeMask, TArray<AActor*>& Result)
+{
+	Result.Reset();
+	CollectEntries(Center, Radius, TypeMask, QueryEntries);
+
+	for (int32 EntryIndex : QueryEntries)
+	{
+		Result.Add(Entries[EntryIndex].Actor);
+	}
+}
+
+void FFlareSectorSpatialIndex::QueryCone(FVector Origin, FVector Axis, float HalfAngle, float Range, int32 TypeMask, TArray<AActor*>& Result)
+{
+	Result.Reset();
+	CollectEntries(Origin, Range, TypeMask, QueryEntries);
+	Axis = Axis.GetSafeNormal();
+
+	for (int32 EntryIndex : QueryEntries)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		FVector Offset = Entry.Location - Origin;
+		float Distance = Offset.Size();
+		float Reach = Entry.Radius + Margin;
+
+		// Origin inside the body, or body within the cone, widened by its angular size
+		if (Distance <= Reach
+		 || FMath::Acos(FMath::Clamp(FVector::DotProduct(Offset / Distance, Axis), -1.f, 1.f)) <= HalfAngle + FMath::Asin(Reach / Distance))
+		{
+			Result.Add(Entry.Actor);
+		}
+	}
+}
+
+void FFlareSectorSpatialIndex::QueryNearest(FVector Location, int32 Count, int32 TypeMask, TFunctionRef<bool(AActor*, float&)> Evaluate, TArray<AActor*>& Result)
+{
+	Result.Reset();
+	if (Count <= 0 || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	typedef TPair<float, int32> FNearestCandidate;
+	TArray<FNearestCandidate> Candidates;
+	float FullSearchRadius = FVector::Dist(Location, Bounds.GetCenter()) + Bounds.GetExtent().Size();
+	float SearchRadius = CellSize;
+
+	while (true)
+	{
+		// Once the search sphere holds the bounds, every body has been seen
+		bool Complete = (SearchRadius >= FullSearchRadius);
+		CollectEntries(Location, SearchRadius, TypeMask, QueryEntries);
+
+		Candidates.Reset();
+		for (int32 EntryIndex : QueryEntries)
+		{
+			float Distance;
+			if (Evaluate(Entries[EntryIndex].Actor, Distance))
+			{
+				Candidates.Add(FNearestCandidate(Distance, EntryIndex));
+			}
+		}
+		Candidates.StableSort([](const FNearestCandidate& A, const FNearestCandidate& B)
+		{
+			return A.Key < B.Key;
+		});
+
+		// Bodies left out of the search sphere are further than SearchRadius
+		int32 FoundCount = 0;
+		while (FoundCount < Candidates.Num() && (Complete || Candidates[FoundCount].Key <= SearchRadius))
+		{
+			FoundCount++;
+		}
+
+		if (FoundCount >= Count || Complete)
+		{
+			for (int32 CandidateIndex = 0; CandidateIndex < FMath::Min(FoundCount, Count); CandidateIndex++)
+			{
+				Result.Add(Entries[Candidates[CandidateIndex].Value].Actor);
+			}
+			return;
+		}
+
+		SearchRadius *= 2;
+	}
+}
+
+
+/*----------------------------------------------------
+	Internals
+----------------------------------------------------*/
+
+void FFlareSectorSpatialIndex::CollectEntries(FVector Center, float Radius, int32 TypeMask, TArray<int32>& EntryIndices)
+{
+	EntryIndices.Reset();
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	// New stamp to visit each body once
+	QueryStamp++;
+	if (QueryStamp == 0)
+	{
+		for (FEntry& Entry : Entries)
+		{
+			Entry.Stamp = 0;
+		}
+		QueryStamp = 1;
+	}
+
+	float Reach = FMath::Min(Radius + Margin, 1e10f);
+
+	auto CheckEntry = [&](int32 EntryIndex)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		if (Entry.Stamp == QueryStamp)
+		{
+			return;
+		}
+		Entry.Stamp = QueryStamp;
+
+		if ((Entry.Type & TypeMask) && FVector::DistSquared(Entry.Location, Center) <= FMath::Square(Reach + Entry.Radius))
+		{
+			EntryIndices.Add(EntryIndex);
+		}
+	};
+
+	for (int32 EntryIndex : LargeEntries)
+	{
+		CheckEntry(EntryIndex);
+	}
+
+	// Bodies are stored in every cell they overlap, so the cells of the query box are enough
+	FIntVector MinCell = GetCell(Center - FVector(Reach));
+	FIntVector MaxCell = GetCell(Center + FVector(Reach));
+	int64 QueryCellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+	if (QueryCellCount > Cells.Num())
+	{
+		// Large query : walk the occupied cells instead
+		for (auto& Cell : Cells)
+		{
+			const FIntVector& Key = Cell.Key;
+			if (Key.X >= MinCell.X && Key.X <= MaxCell.X
+			 && Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y
+			 && Key.Z >= MinCell.Z && Key.Z <= MaxCell.Z)
+			{
+				for (int32 EntryIndex : Cell.Value)
+				{
+					CheckEntry(EntryIndex);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					TArray<int32>* CellEntries = Cells.Find(FIntVector(X, Y, Z));
+					if (CellEntries)
+					{
+						for (int32 EntryIndex : *CellEntries)
+						{
+							CheckEntry(EntryIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Keep the insertion order
+	EntryIndices.Sort();
+}
+
+FIntVector FFlareSectorSpatialIndex::GetCell(FVector Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Flare.h"
+
+
+/** Body kinds stored in the sector spatial index, used as query masks */
+namespace EFlareSpatialBody
+{
+	enum Type
+	{
+		Spacecraft = 1 << 0,
+		Asteroid = 1 << 1,
+		Bomb = 1 << 2,
+		Meteorite = 1 << 3,
+		Collider = 1 << 4,
+
+		All = Spacecraft | Asteroid | Bomb | Meteorite | Collider
+	};
+}
+
+
+/** Hashed uniform grid of the active sector bodies.
+ *  Queries are conservative : they return every body that may match, callers keep their exact test on live positions.
+ *  Results keep the insertion order, so that callers iterate candidates in the same order as the sector lists. */
+class HELIUMRAIN_API FFlareSectorSpatialIndex
+{
+public:
+
+	FFlareSectorSpatialIndex();
+
+	/** Remove all bodies. Bodies may move for DeltaSeconds before the next rebuild, queries are widened to match */
+	void Reset(float InDeltaSeconds);
+
+	/** Add a body, Radius must cover the body in any orientation. Speed is in cm/s */
+	void Add(AActor* Actor, EFlareSpatialBody::Type Type, float Radius, float Speed);
+
+	/** Bodies whose sphere may be within Radius of Center */
+	void QueryRadius(FVector Center, float Radius, int32 TypeMask, TArray<AActor*>& Result);
+
+	/** Bodies whose sphere may be within Range of Origin and within HalfAngle (radians) of Axis */
+	void QueryCone(FVector Origin, FVector Axis, float HalfAngle, float Range, int32 TypeMask, TArray<AActor*>& Result);
+
+	/** Up to Count bodies, nearest first. Evaluate rejects a body by returning false, or gives its live distance,
+	 *  which must not be lower than the distance to its center minus its radius. Ties keep the insertion order. */
+	void QueryNearest(FVector Location, int32 Count, int32 TypeMask, TFunctionRef<bool(AActor*, float&)> Evaluate, TArray<AActor*>& Result);
+
+	/** Highest speed of a spacecraft at rebuild time, in cm/s */
+	float GetMaxSpacecraftSpeed() const
+	{
+		return MaxSpacecraftSpeed;
+	}
+
+	int32 GetBodyCount() const
+	{
+		return Entries.Num();
+	}
+
+	/** Grid cell size : 1km */
+	static const float CellSize;
+
+	/** Minimal query widening, for bodies moved without physics */
+	static const float MinMargin;
+
+	/** Bodies larger than this are kept out of the grid and checked by every query */
+	static const float LargeBodyRadius;
+
+
+protected:
+
+	struct FEntry
+	{
+		AActor*                                Actor;
+		FVector                                Location;
+		float                                  Radius;
+		int32                                  Type;
+		uint32                                 Stamp;
+	};
+
+	/** Indices of the entries matching the mask whose sphere may intersect the query sphere, sorted */
+	void CollectEntries(FVector Center, float Radius, int32 TypeMask, TArray<int32>& EntryIndices);
+
+	FIntVector GetCell(FVector Location) const;
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FEntry>                             Entries;
+	TMap<FIntVector, TArray<int32>>            Cells;
+	TArray<int32>                              LargeEntries;
+	TArray<int32>                              QueryEntries;
+
+	FBox                                       Bounds;
+	float                                      DeltaSeconds;
+	float                                      Margin;
+	float                                      MaxSpacecraftSpeed;
+	uint32                                     QueryStamp;
+};
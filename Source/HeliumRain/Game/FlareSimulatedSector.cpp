@@ -22,7 +22,9 @@
 #include "FlareSectorHelper.h"
 
 #include "Engine.h"
-#include <ctime>
+
+
+#define DEBUG_PRICE_VARIATION 0
 
 
 DECLARE_CYCLE_STAT(TEXT("FlareSector SimulatePriceVariation"), STAT_FlareSector_SimulatePriceVariation, STATGROUP_Flare);
@@ -42,6 +44,12 @@ UFlareSimulatedSector::UFlareSimulatedSector(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 	PersistentStationIndex = 0;
+	WorldIndex = INDEX_NONE;
+	BattleCountsDirty = true;
+	BattleCountsFromActiveSector = false;
+	BattleCountsFrame = 0;
+	DeferWorldEffects = false;
+	DeferredRetaliation = 0;
 }
 
 void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, const FFlareSectorSave& Data, const FFlareSectorOrbitParameters& OrbitParameters)
@@ -60,6 +68,8 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 	SectorData = Data;
 	SectorDescription = Description;
 	SectorOrbitParameters = OrbitParameters;
+	WorldIndex = INDEX_NONE;
+	BattleCountsDirty = true;
 	SectorShips.Empty();
 	SectorStations.Empty();
 	SectorChildStations.Empty();
@@ -424,6 +434,12 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 	}
 
 	Spacecraft->SetCurrentSector(this);
+	InvalidateBattleState();
+
+	if (Spacecraft->IsStation())
+	{
+		Game->GetGameWorld()->InvalidateResourceStats(this);
+	}
 
 	FLOGV("UFlareSimulatedSector::CreateShip : Created ship '%s' at %s", *Spacecraft->GetImmatriculation().ToString(), *TargetPosition.ToString());
 
@@ -477,6 +493,8 @@ void UFlareSimulatedSector::AddFleet(UFlareFleet* Fleet)
 		SectorShips.AddUnique(Fleet->GetShips()[ShipIndex]);
 		SectorSpacecrafts.AddUnique(Fleet->GetShips()[ShipIndex]);
 	}
+
+	InvalidateBattleState();
 }
 
 void UFlareSimulatedSector::DisbandFleet(UFlareFleet* Fleet)
@@ -511,6 +529,12 @@ void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
 
 int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
+	if (Spacecraft->IsStation())
+	{
+		Game->GetGameWorld()->InvalidateResourceStats(this);
+	}
+
+	InvalidateBattleState();
 	SectorStations.Remove(Spacecraft);
 	SectorChildStations.Remove(Spacecraft);
 	SectorShips.Remove(Spacecraft);
@@ -787,20 +811,93 @@ void UFlareSimulatedSector::AttachStationToActor(UFlareSimulatedSpacecraft* Spac
 	Spacecraft->SetActorAttachment(AttachActorName);
 }
 
-void UFlareSimulatedSector::SimulatePriceVariation()
+/** Check that a cycle resource is not listed before this index */
+static bool IsFirstFactoryResource(UFlareFactory* Factory, int32 Index, bool Input)
 {
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	FFlareResourceDescription* Resource = Input ? Factory->GetInputResource(Index) : Factory->GetOutputResource(Index);
+
+	for (int32 PreviousIndex = 0; PreviousIndex < Index; PreviousIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		SimulatePriceVariation(Resource);
+		if ((Input ? Factory->GetInputResource(PreviousIndex) : Factory->GetOutputResource(PreviousIndex)) == Resource)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if DEBUG_PRICE_VARIATION
+/** Compare the wanted price sums to a scan of this resource alone */
+static void CheckWantedPrice(UFlareSimulatedSector* Sector, FFlareResourceDescription* Resource, float WantedPriceSum, float WantedWeightSum)
+{
+	float ReferencePriceSum = 0;
+	float ReferenceWeightSum = 0;
+
+	for (int32 CountIndex = 0 ; CountIndex < Sector->GetSectorStations().Num(); CountIndex++)
+	{
+		UFlareSimulatedSpacecraft* Station = Sector->GetSectorStations()[CountIndex];
+
+		if(Station->GetActiveCargoBay()->HasRestrictions())
+		{
+			continue;
+		}
+
+		float StockRatio = FMath::Clamp((float) Station->GetActiveCargoBay()->GetResourceQuantity(Resource, NULL) / (float) Station->GetActiveCargoBay()->GetSlotCapacity(), 0.f, 1.f);
+
+		for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
+		{
+			UFlareFactory* Factory = Station->GetFactories()[FactoryIndex];
+
+			if(!Factory->IsActive())
+			{
+				continue;
+			}
+
+			if (Factory->HasInputResource(Resource))
+			{
+				float Weight = Factory->GetInputResourceQuantity(Resource);
+				ReferencePriceSum += Weight * (1.f - StockRatio);
+				ReferenceWeightSum += Weight;
+			}
+
+			if (Factory->HasOutputResource(Resource))
+			{
+				float Weight = Factory->GetOutputResourceQuantity(Resource);
+				ReferencePriceSum += Weight * (1.f - StockRatio);
+				ReferenceWeightSum += Weight;
+			}
+		}
+
+		if(Station->HasCapability(EFlareSpacecraftCapability::Consumer) && Resource->IsConsumerResource)
+		{
+			float Weight = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+			ReferencePriceSum += Weight * (1.f - StockRatio);
+			ReferenceWeightSum += Weight;
+		}
+
+		if(Station->HasCapability(EFlareSpacecraftCapability::Maintenance) && Resource->IsMaintenanceResource)
+		{
+			ReferencePriceSum += 1.f - StockRatio;
+			ReferenceWeightSum += 1;
+		}
+	}
+
+	if (ReferencePriceSum != WantedPriceSum || ReferenceWeightSum != WantedWeightSum)
+	{
+		FLOGV("CheckWantedPrice : %s in %s differs, price sum %f / %f, weight sum %f / %f",
+			*Resource->Name.ToString(), *Sector->GetSectorName().ToString(),
+			WantedPriceSum, ReferencePriceSum, WantedWeightSum, ReferenceWeightSum);
 	}
 }
+#endif
 
-void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Resource)
+void UFlareSimulatedSector::SimulatePriceVariation()
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareSector_SimulatePriceVariation);
 
-	float OldPrice = GetPreciseResourcePrice(Resource);
+	TArray<UFlareResourceCatalogEntry*>& Resources = Game->GetResourceCatalog()->Resources;
+
 	// Prices can increase because :
 
 	//  - The input of a station is low (and less than half)
@@ -814,22 +911,33 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 	//  - Maintenance ressource is full (and more than half) (very slow decrease)
 
 
-	float WantedPriceSum = 0;
-	float WantedWeightSum = 0;
-
+	// Sum the wanted prices of all resources in one pass over the stations.
+	// Each resource gets its terms in the same order as a scan of this resource alone, so the sums are the same.
+	TArray<float> WantedPriceSums;
+	TArray<float> WantedWeightSums;
+	TArray<int32> StockQuantities;
+	WantedPriceSums.AddZeroed(Resources.Num());
+	WantedWeightSums.AddZeroed(Resources.Num());
 
-	// Prices never go below min production cost
 	for (int32 CountIndex = 0 ; CountIndex < SectorStations.Num(); CountIndex++)
 	{
 		UFlareSimulatedSpacecraft* Station = SectorStations[CountIndex];
+		UFlareCargoBay* CargoBay = Station->GetActiveCargoBay();
 
-		if(Station->GetActiveCargoBay()->HasRestrictions())
+		if(CargoBay->HasRestrictions())
 		{
 			// Not allow station with slot restriction to impact the price
 			continue;
 		}
 
-		float StockRatio = FMath::Clamp((float) Station->GetActiveCargoBay()->GetResourceQuantity(Resource, NULL) / (float) Station->GetActiveCargoBay()->GetSlotCapacity(), 0.f, 1.f);
+		CargoBay->GetResourceQuantities(StockQuantities, NULL);
+
+		auto AddWantedPrice = [&](FFlareResourceDescription* Resource, float Weight)
+		{
+			float StockRatio = FMath::Clamp((float) StockQuantities[Resource->CatalogIndex] / (float) CargoBay->GetSlotCapacity(), 0.f, 1.f);
+			WantedPriceSums[Resource->CatalogIndex] += Weight * (1.f - StockRatio);
+			WantedWeightSums[Resource->CatalogIndex] += Weight;
+		};
 
 		for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
 		{
@@ -840,146 +948,178 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 				continue;
 			}
 
-
-			if (Factory->HasInputResource(Resource))
+			// A resource listed twice by a cycle only counts once, with its first quantity
+			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
 			{
-				float Weight = Factory->GetInputResourceQuantity(Resource);
-				WantedPriceSum += Weight * (1.f - StockRatio);
-				WantedWeightSum += Weight;
+				if (IsFirstFactoryResource(Factory, ResourceIndex, true))
+				{
+					AddWantedPrice(Factory->GetInputResource(ResourceIndex), Factory->GetInputResourceQuantity(ResourceIndex));
+				}
 			}
 
-			if (Factory->HasOutputResource(Resource))
+			for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
 			{
-				float Weight = Factory->GetOutputResourceQuantity(Resource);
-				WantedPriceSum += Weight * (1.f - StockRatio);
-				WantedWeightSum += Weight;
+				if (IsFirstFactoryResource(Factory, ResourceIndex, false))
+				{
+					AddWantedPrice(Factory->GetOutputResource(ResourceIndex), Factory->GetOutputResourceQuantity(ResourceIndex));
+				}
 			}
 		}
 
-		if(Station->HasCapability(EFlareSpacecraftCapability::Consumer) && Resource->IsConsumerResource)
+		if(Station->HasCapability(EFlareSpacecraftCapability::Consumer))
 		{
-			float Weight = GetPeople()->GetRessourceConsumption(Resource, false);
-			WantedPriceSum += Weight * (1.f - StockRatio);
-			WantedWeightSum += Weight;
+			for (UFlareResourceCatalogEntry* Entry : Game->GetResourceCatalog()->ConsumerResources)
+			{
+				AddWantedPrice(&Entry->Data, GetPeople()->GetRessourceConsumption(&Entry->Data, false));
+			}
 		}
 
-		if(Station->HasCapability(EFlareSpacecraftCapability::Maintenance) && Resource->IsMaintenanceResource)
+		if(Station->HasCapability(EFlareSpacecraftCapability::Maintenance))
 		{
-			WantedPriceSum += 1.f - StockRatio;
-			WantedWeightSum += 1;
+			for (UFlareResourceCatalogEntry* Entry : Game->GetResourceCatalog()->MaintenanceResources)
+			{
+				AddWantedPrice(&Entry->Data, 1);
+			}
 		}
 	}
 
-	if(WantedWeightSum > 0)
+	// Update all prices
+	int32 NearestSectorCount = INDEX_NONE;
+
+	for(int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
 	{
-		float MeanWantedPriceRatio = WantedPriceSum / WantedWeightSum;
-		float OldPriceRatio = (OldPrice - Resource->MinPrice) / (float) (Resource->MaxPrice - Resource->MinPrice);
+		FFlareResourceDescription* Resource = &Resources[ResourceIndex]->Data;
+		float OldPrice = GetPreciseResourcePrice(Resource);
+		float WantedPriceSum = WantedPriceSums[ResourceIndex];
+		float WantedWeightSum = WantedWeightSums[ResourceIndex];
 
+#if DEBUG_PRICE_VARIATION
+		CheckWantedPrice(this, Resource, WantedPriceSum, WantedWeightSum);
+#endif
 
-		float WantedVariation = MeanWantedPriceRatio - OldPriceRatio;
+		if(WantedWeightSum > 0)
+		{
+			float MeanWantedPriceRatio = WantedPriceSum / WantedWeightSum;
+			float OldPriceRatio = (OldPrice - Resource->MinPrice) / (float) (Resource->MaxPrice - Resource->MinPrice);
 
 
-		/*FLOGV(">>> %s price in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
-		FLOGV("   WantedPriceSum %f", WantedPriceSum);
-		FLOGV("   WantedWeightSum %f", WantedWeightSum);
-		FLOGV("   MeanWantedPriceRatio %f", MeanWantedPriceRatio);
-		FLOGV("   OldPrice %f", OldPrice);
-		FLOGV("   OldPriceRatio %f", OldPriceRatio);
-		FLOGV("   WantedVariation %f", WantedVariation);*/
+			float WantedVariation = MeanWantedPriceRatio - OldPriceRatio;
 
 
+			/*FLOGV(">>> %s price in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
+			FLOGV("   WantedPriceSum %f", WantedPriceSum);
+			FLOGV("   WantedWeightSum %f", WantedWeightSum);
+			FLOGV("   MeanWantedPriceRatio %f", MeanWantedPriceRatio);
+			FLOGV("   OldPrice %f", OldPrice);
+			FLOGV("   OldPriceRatio %f", OldPriceRatio);
+			FLOGV("   WantedVariation %f", WantedVariation);*/
 
 
-		if(WantedVariation != 0.f)
-		{
 
 
+			if(WantedVariation != 0.f)
+			{
 
-			float MaxPriceVariation = 10;
-			float OldPriceRatioToVariationDirection;
 
-			if(WantedVariation > 0)
-			{
-				OldPriceRatioToVariationDirection = OldPriceRatio;
-			}
-			else
-			{
-				OldPriceRatioToVariationDirection = 1 - OldPriceRatio;
-			}
 
-			float A = (MaxPriceVariation - 2) * (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
-			float B = (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
-			float C = MaxPriceVariation / (MaxPriceVariation - 2);
+				float MaxPriceVariation = 10;
+				float OldPriceRatioToVariationDirection;
+
+				if(WantedVariation > 0)
+				{
+					OldPriceRatioToVariationDirection = OldPriceRatio;
+				}
+				else
+				{
+					OldPriceRatioToVariationDirection = 1 - OldPriceRatio;
+				}
+
+				float A = (MaxPriceVariation - 2) * (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
+				float B = (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
+				float C = MaxPriceVariation / (MaxPriceVariation - 2);
 
-			float VariationScale = (1 / (A*OldPriceRatioToVariationDirection + B)) - C;
+				float VariationScale = (1 / (A*OldPriceRatioToVariationDirection + B)) - C;
 
 
 
-			float Variation = VariationScale * WantedVariation;
+				float Variation = VariationScale * WantedVariation;
 
 
-			float NewPrice = FMath::Max(1.f, OldPrice * (1 + Variation / 100.f));
+				float NewPrice = FMath::Max(1.f, OldPrice * (1 + Variation / 100.f));
 
 
-			/*FLOGV("   VariationScale %f", VariationScale);
-			FLOGV("   Variation %f", Variation);
-			FLOGV("   NewPrice %f", NewPrice);*/
+				/*FLOGV("   VariationScale %f", VariationScale);
+				FLOGV("   Variation %f", Variation);
+				FLOGV("   NewPrice %f", NewPrice);*/
 
-			SetPreciseResourcePrice(Resource, NewPrice);
-			/*if(NewPrice > Resource->MaxPrice)
-			{
-				FLOGV("%s price at max in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
+				SetPreciseResourcePrice(Resource, NewPrice);
+				/*if(NewPrice > Resource->MaxPrice)
+				{
+					FLOGV("%s price at max in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
+				}
+				else if(NewPrice < Resource->MinPrice)
+				{
+					FLOGV("%s price at min in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
+				}
+				else
+				{
+					FLOGV("%s price in %s change from %f to %f (%f)", *Resource->Name.ToString(), *GetSectorName().ToString(), OldPrice / 100.f, NewPrice / 100.f, Variation);
+				}*/
 			}
-			else if(NewPrice < Resource->MinPrice)
+		}
+		else
+		{
+			// Find nearest sectors, they don't depend on the resource
+			if (NearestSectorCount == INDEX_NONE)
 			{
-				FLOGV("%s price at min in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
+				NearestSectorCount = GetNearestSectorCount();
 			}
-			else
+
+			float PriceSum = 0;
+			for (int32 SectorIndex = 0; SectorIndex < NearestSectorCount; SectorIndex++)
 			{
-				FLOGV("%s price in %s change from %f to %f (%f)", *Resource->Name.ToString(), *GetSectorName().ToString(), OldPrice / 100.f, NewPrice / 100.f, Variation);
-			}*/
+				PriceSum += GetPreciseResourcePrice(Resource);
+			}
+
+			float MeanNearPrice = PriceSum / NearestSectorCount;
+			SetPreciseResourcePrice(Resource, MeanNearPrice);
 		}
 	}
-	else
-	{
+}
 
-		// Find nearest sectors
+int32 UFlareSimulatedSector::GetNearestSectorCount()
+{
+	int64 MinTravelDuration = -1;
+	int32 NumSector = 0;
 
-		int64 MinTravelDuration = -1;
-		int32 NumSector = 0;
-		float PriceSum = 0;
+	for (int SectorIndex = 0; SectorIndex < GetGame()->GetGameWorld()->GetSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* SectorCandidate = GetGame()->GetGameWorld()->GetSectors()[SectorIndex];
 
-		for (int SectorIndex = 0; SectorIndex < GetGame()->GetGameWorld()->GetSectors().Num(); SectorIndex++)
+		if(SectorCandidate == this)
 		{
-			UFlareSimulatedSector* SectorCandidate = GetGame()->GetGameWorld()->GetSectors()[SectorIndex];
-
-			if(SectorCandidate == this)
-			{
-				continue;
-			}
-
-			int64 TravelDuration = UFlareTravel::ComputeTravelDuration(GetGame()->GetGameWorld(), this, SectorCandidate, NULL);
+			continue;
+		}
 
+		int64 TravelDuration = UFlareTravel::ComputeTravelDuration(GetGame()->GetGameWorld(), this, SectorCandidate, NULL);
 
-			if (MinTravelDuration == -1 || MinTravelDuration > TravelDuration)
-			{
-				MinTravelDuration = TravelDuration;
-				NumSector = 0;
-				PriceSum = 0;
-			}
 
-			if (MinTravelDuration == TravelDuration)
-			{
-				PriceSum += GetPreciseResourcePrice(Resource);
-				NumSector++;
-			}
+		if (MinTravelDuration == -1 || MinTravelDuration > TravelDuration)
+		{
+			MinTravelDuration = TravelDuration;
+			NumSector = 0;
 		}
 
-		float MeanNearPrice = PriceSum / NumSector;
-		SetPreciseResourcePrice(Resource, MeanNearPrice);
+		if (MinTravelDuration == TravelDuration)
+		{
+			NumSector++;
+		}
 	}
+
+	return NumSector;
 }
 
+
 bool UFlareSimulatedSector::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client)
 {
 	for (UFlareSimulatedSpacecraft* Station : GetSectorStations())
@@ -1114,17 +1254,29 @@ uint32 UFlareSimulatedSector::GetResourceCount(UFlareCompany* Company, FFlareRes
 
 void UFlareSimulatedSector::LoadResourcePrices()
 {
-	ResourcePrices.Empty();
-	LastResourcePrices.Empty();
+	TArray<UFlareResourceCatalogEntry*>& Resources = Game->GetResourceCatalog()->Resources;
+
+	ResourcePrices.Empty(Resources.Num());
+	LastResourcePrices.Empty(Resources.Num());
+	for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+	{
+		ResourcePrices.Add(GetDefaultResourcePrice(&Resources[ResourceIndex]->Data));
+	}
+	LastResourcePrices.AddZeroed(Resources.Num());
+
 	for (int PriceIndex = 0; PriceIndex < SectorData.ResourcePrices.Num(); PriceIndex++)
 	{
 		FFFlareResourcePrice* ResourcePrice = &SectorData.ResourcePrices[PriceIndex];
 		FFlareResourceDescription* Resource = Game->GetResourceCatalog()->Get(ResourcePrice->ResourceIdentifier);
-		float Price = ResourcePrice->Price;
-		ResourcePrices.Add(Resource, Price);
+		if (!Resource)
+		{
+			continue;
+		}
+
+		ResourcePrices[Resource->CatalogIndex] = ResourcePrice->Price;
 		FFlareFloatBuffer* Prices = &ResourcePrice->Prices;
 		Prices->Resize(50);
-		LastResourcePrices.Add(Resource, *Prices);
+		LastResourcePrices[Resource->CatalogIndex] = *Prices;
 	}
 }
 
@@ -1135,16 +1287,13 @@ void UFlareSimulatedSector::SaveResourcePrices()
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		if (ResourcePrices.Contains(Resource))
+		if (LastResourcePrices[ResourceIndex].MaxSize > 0)
 		{
 			FFFlareResourcePrice Price;
 			Price.ResourceIdentifier = Resource->Identifier;
-			Price.Price = ResourcePrices[Resource];
-			if (LastResourcePrices.Contains(Resource))
-			{
-				Price.Prices = LastResourcePrices[Resource];
-				SectorData.ResourcePrices.Add(Price);
-			}
+			Price.Price = ResourcePrices[ResourceIndex];
+			Price.Prices = LastResourcePrices[ResourceIndex];
+			SectorData.ResourcePrices.Add(Price);
 		}
 	}
 }
@@ -1220,6 +1369,8 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 		return BattleState;
 	}
 
+	UpdateBattleCounts();
+
 	// Hostiles
 	int HostileSpacecraftCount = 0;
 	int DangerousHostileSpacecraftCount = 0;
@@ -1227,92 +1378,70 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 	int DangerousHostileActiveMissileCount = 0;
 
 	// Friendlies
-	int FriendlySpacecraftCount = 0;
-	int DangerousFriendlySpacecraftCount = 0;
-	int DangerousFriendlyActiveSpacecraftCount = 0;
-	int CrippledFriendlySpacecraftCount = 0;
+	FFlareSectorBattleCounts FriendlyCounts = BattleCounts.FindRef(Company);
+	int FriendlySpacecraftCount = FriendlyCounts.ShipCount + FriendlyCounts.StationCount;
+	int DangerousFriendlySpacecraftCount = FriendlyCounts.DangerousShipCount;
+	int DangerousFriendlyActiveSpacecraftCount = FriendlyCounts.DangerousActiveShipCount;
+	int CrippledFriendlySpacecraftCount = FriendlyCounts.StrandedShipCount + FriendlyCounts.StationCount;
 	int DangerousFriendlyActiveMissileCount = 0;
 
 	// Neutrals
-	int FriendlyStationCount = 0;
-	int FriendlyStationInCaptureCount = 0;
-	int FriendlyControllableShipCount = 0;
+	int FriendlyStationCount = FriendlyCounts.StationCount;
+	int FriendlyStationInCaptureCount = FriendlyCounts.StationInCaptureCount;
+	int FriendlyControllableShipCount = FriendlyCounts.ControllableShipCount;
 
-	// Look at every spacecraft
-	for (int SpacecraftIndex = 0 ; SpacecraftIndex < GetSectorShips().Num(); SpacecraftIndex++)
+	// Companies at war have all their spacecrafts hostile. Otherwise, only contracts with the player can make some of them hostile
+	TArray<UFlareCompany*, TInlineAllocator<4>> CheckedCompanies;
+	for (auto& CompanyCounts : BattleCounts)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorShips()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
+		UFlareCompany* OtherCompany = CompanyCounts.Key;
+		const FFlareSectorBattleCounts& Counts = CompanyCounts.Value;
 
-		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		if (OtherCompany == Company)
 		{
 			continue;
 		}
-
-		if (OtherCompany == Company)
+		else if (OtherCompany->GetWarState(Company) == EFlareHostility::Hostile)
 		{
-			FriendlySpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
-			{
-				DangerousFriendlySpacecraftCount++;
-				if(!Spacecraft->IsReserve())
-				{
-					DangerousFriendlyActiveSpacecraftCount++;
-				}
-			}
-
-			if (Spacecraft->GetDamageSystem()->IsStranded())
-			{
-				CrippledFriendlySpacecraftCount++;
-			}
-
-			if(!Spacecraft->GetDamageSystem()->IsUncontrollable())
-			{
-				FriendlyControllableShipCount++;
-			}
-
+			HostileSpacecraftCount += Counts.ShipCount + Counts.StationCount;
+			DangerousHostileSpacecraftCount += Counts.DangerousShipCount;
+			DangerousHostileActiveSpacecraftCount += Counts.DangerousActiveShipCount;
 		}
-		else if (Spacecraft->IsHostile(Company))
+		else if (OtherCompany->IsPlayerCompany() || Company->IsPlayerCompany())
 		{
-			HostileSpacecraftCount++;
-			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
-			{
-				DangerousHostileSpacecraftCount++;
-				if(!Spacecraft->IsReserve())
-				{
-					DangerousHostileActiveSpacecraftCount++;
-				}
-			}
+			CheckedCompanies.Add(OtherCompany);
 		}
 	}
 
-	// Look at every station
-	for (int SpacecraftIndex = 0 ; SpacecraftIndex < GetSectorStations().Num(); SpacecraftIndex++)
+	if (CheckedCompanies.Num() > 0)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = GetSectorStations()[SpacecraftIndex];
-		UFlareCompany* OtherCompany = Spacecraft->GetCompany();
-
-		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorShips())
 		{
-			continue;
+			if (CheckedCompanies.Contains(Spacecraft->GetCompany())
+			 && Spacecraft->GetDamageSystem()->IsAlive()
+			 && Spacecraft->IsHostile(Company))
+			{
+				HostileSpacecraftCount++;
+				if (!Spacecraft->GetDamageSystem()->IsDisarmed())
+				{
+					DangerousHostileSpacecraftCount++;
+					if(!Spacecraft->IsReserve())
+					{
+						DangerousHostileActiveSpacecraftCount++;
+					}
+				}
+			}
 		}
 
-		if (OtherCompany == Company)
+		for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorStations())
 		{
-			FriendlySpacecraftCount++;
-			CrippledFriendlySpacecraftCount++;
-
-			FriendlyStationCount++;
-
-			if (Spacecraft->IsBeingCaptured())
+			if (CheckedCompanies.Contains(Spacecraft->GetCompany())
+			 && Spacecraft->GetDamageSystem()->IsAlive()
+			 && Spacecraft->IsHostile(Company))
 			{
-				FriendlyStationInCaptureCount++;
+				HostileSpacecraftCount++;
 			}
 		}
-		else if (Spacecraft->IsHostile(Company))
-		{
-			HostileSpacecraftCount++;
-		}
 	}
 
 	// Look at bombs if this is an active sector
@@ -1407,6 +1536,83 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 }
 
 
+void UFlareSimulatedSector::InvalidateBattleState()
+{
+	BattleCountsDirty = true;
+}
+
+void UFlareSimulatedSector::UpdateBattleCounts()
+{
+	// Active spacecrafts are disarmed when they leave the sector, which is only seen by looking at them
+	bool ActiveSector = (Game->GetActiveSector() && Game->GetActiveSector()->GetSimulatedSector() == this);
+	if (ActiveSector && BattleCountsFrame != GFrameCounter)
+	{
+		BattleCountsDirty = true;
+	}
+	else if (!ActiveSector && BattleCountsFromActiveSector)
+	{
+		BattleCountsDirty = true;
+	}
+
+	if (!BattleCountsDirty)
+	{
+		return;
+	}
+
+	BattleCounts.Reset();
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorShips())
+	{
+		UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Spacecraft->GetDamageSystem();
+		if (!DamageSystem->IsAlive())
+		{
+			continue;
+		}
+
+		FFlareSectorBattleCounts& Counts = BattleCounts.FindOrAdd(Spacecraft->GetCompany());
+		Counts.ShipCount++;
+
+		if (!DamageSystem->IsDisarmed())
+		{
+			Counts.DangerousShipCount++;
+			if(!Spacecraft->IsReserve())
+			{
+				Counts.DangerousActiveShipCount++;
+			}
+		}
+
+		if (DamageSystem->IsStranded())
+		{
+			Counts.StrandedShipCount++;
+		}
+
+		if(!DamageSystem->IsUncontrollable())
+		{
+			Counts.ControllableShipCount++;
+		}
+	}
+
+	for (UFlareSimulatedSpacecraft* Spacecraft : GetSectorStations())
+	{
+		if (!Spacecraft->GetDamageSystem()->IsAlive())
+		{
+			continue;
+		}
+
+		FFlareSectorBattleCounts& Counts = BattleCounts.FindOrAdd(Spacecraft->GetCompany());
+		Counts.StationCount++;
+
+		if (Spacecraft->IsBeingCaptured())
+		{
+			Counts.StationInCaptureCount++;
+		}
+	}
+
+	BattleCountsDirty = false;
+	BattleCountsFromActiveSector = ActiveSector;
+	BattleCountsFrame = GFrameCounter;
+}
+
 FText UFlareSimulatedSector::GetSectorBattleStateText(UFlareCompany* Company)
 {
 	FText BattleStatusText;
@@ -1512,49 +1718,39 @@ float UFlareSimulatedSector::GetPreciseResourcePrice(FFlareResourceDescription*
 {
 	if(Age == 0)
 	{
-
-		if (!ResourcePrices.Contains(Resource))
-		{
-			ResourcePrices.Add(Resource, GetDefaultResourcePrice(Resource));
-		}
-
-		return ResourcePrices[Resource];
+		return ResourcePrices[Resource->CatalogIndex];
 	}
 	else
 	{
-		if (!LastResourcePrices.Contains(Resource))
+		FFlareFloatBuffer& Prices = LastResourcePrices[Resource->CatalogIndex];
+		if (Prices.MaxSize == 0)
 		{
-			FFlareFloatBuffer Prices;
 			Prices.Init(50);
-			Prices.Append(GetPreciseResourcePrice(Resource, 0));
-			LastResourcePrices.Add(Resource, Prices);
+			Prices.Append(ResourcePrices[Resource->CatalogIndex]);
 		}
 
-		return LastResourcePrices[Resource].GetValue(Age);
+		return Prices.GetValue(Age);
 	}
 
 }
 
 void UFlareSimulatedSector::SwapPrices()
 {
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	for(int32 ResourceIndex = 0; ResourceIndex < ResourcePrices.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-
-		if (!LastResourcePrices.Contains(Resource))
+		FFlareFloatBuffer& Prices = LastResourcePrices[ResourceIndex];
+		if (Prices.MaxSize == 0)
 		{
-			FFlareFloatBuffer Prices;
 			Prices.Init(50);
-			LastResourcePrices.Add(Resource, Prices);
 		}
 
-		LastResourcePrices[Resource].Append(GetPreciseResourcePrice(Resource, 0));
+		Prices.Append(ResourcePrices[ResourceIndex]);
 	}
 }
 
 void UFlareSimulatedSector::SetPreciseResourcePrice(FFlareResourceDescription* Resource, float NewPrice)
 {
-	ResourcePrices[Resource] = FMath::Clamp(NewPrice, (float) Resource->MinPrice, (float) Resource->MaxPrice);
+	ResourcePrices[Resource->CatalogIndex] = FMath::Clamp(NewPrice, (float) Resource->MinPrice, (float) Resource->MaxPrice);
 }
 
 
@@ -1620,7 +1816,8 @@ static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimul
 		return Ship1.GetActiveCargoBay()->GetUsedCargoSpace() > Ship2.GetActiveCargoBay()->GetUsedCargoSpace();
 	}
 
-	return FMath::RandBool();
+	// Same order on every thread and every run, as reserve flags are saved
+	return Ship1.GetImmatriculation().Compare(Ship2.GetImmatriculation()) < 0;
 }
 
 void UFlareSimulatedSector::ProcessMeteorites()
@@ -1644,27 +1841,31 @@ void UFlareSimulatedSector::ProcessMeteorites()
 			}
 
 
-			if(GetGame()->GetQuestManager()->IsInterestingMeteorite(Meteorite))
+			FFlareMeteoriteSave MeteoriteCopy = Meteorite;
+			ApplyOrDeferEffect([this, MeteoriteCopy, PlayerTarget]() mutable
 			{
-				if(Meteorite.DaysBeforeImpact == 0)
+				if(GetGame()->GetQuestManager()->IsInterestingMeteorite(MeteoriteCopy))
 				{
-					GetGame()->GetPC()->Notify(FText::Format(LOCTEXT("MeteoriteHere", "Meteorites in {0}"), GetSectorName()),
-										FText::Format(LOCTEXT("MeteoriteHereFormat", "A meteorite group has entered {0} and threatens stations"), GetSectorName()),
-										FName("meteorite-in-sector"),
-										EFlareNotification::NT_Military,
-										false);
+					if(MeteoriteCopy.DaysBeforeImpact == 0)
+					{
+						GetGame()->GetPC()->Notify(FText::Format(LOCTEXT("MeteoriteHere", "Meteorites in {0}"), GetSectorName()),
+											FText::Format(LOCTEXT("MeteoriteHereFormat", "A meteorite group has entered {0} and threatens stations"), GetSectorName()),
+											FName("meteorite-in-sector"),
+											EFlareNotification::NT_Military,
+											false);
 
-				}
-				else if(Meteorite.DaysBeforeImpact == 1 && !GetGame()->GetPC()->GetCompany()->IsTechnologyUnlocked("early-warning") && PlayerTarget)
-				{
-					GetGame()->GetPC()->Notify(LOCTEXT("ImminentMeteoriteDetected", "Meteorites detected"),
-										FText::Format(LOCTEXT("ImminentMeteoriteDetectedFormat", "A meteorite group has been detected as potential danger at {0}"), GetSectorName()),
-										FName("meteorite-detected"),
-										EFlareNotification::NT_Military,
-										false);
-				}
+					}
+					else if(MeteoriteCopy.DaysBeforeImpact == 1 && !GetGame()->GetPC()->GetCompany()->IsTechnologyUnlocked("early-warning") && PlayerTarget)
+					{
+						GetGame()->GetPC()->Notify(LOCTEXT("ImminentMeteoriteDetected", "Meteorites detected"),
+											FText::Format(LOCTEXT("ImminentMeteoriteDetectedFormat", "A meteorite group has been detected as potential danger at {0}"), GetSectorName()),
+											FName("meteorite-detected"),
+											EFlareNotification::NT_Military,
+											false);
+					}
 
-			}
+				}
+			});
 		}
 		else
 		{
@@ -1700,16 +1901,20 @@ void UFlareSimulatedSector::ProcessMeteorites()
 				}
 
 				// Notify PC
-				if(GetGame()->GetQuestManager()->IsInterestingMeteorite(Meteorite))
+				FFlareMeteoriteSave MeteoriteCopy = Meteorite;
+				ApplyOrDeferEffect([this, MeteoriteCopy, TargetSpacecraft]() mutable
 				{
-					GetGame()->GetPC()->Notify(LOCTEXT("MeteoriteCrash", "Meteorite crashed"),
-										FText::Format(LOCTEXT("MeteoriteCrashFormat", "A meteorite crashed on {0}"), UFlareGameTools::DisplaySpacecraftName(TargetSpacecraft)),
-										FName("meteorite-crash"),
-										EFlareNotification::NT_Military,
-										false);
-				}
+					if(GetGame()->GetQuestManager()->IsInterestingMeteorite(MeteoriteCopy))
+					{
+						GetGame()->GetPC()->Notify(LOCTEXT("MeteoriteCrash", "Meteorite crashed"),
+											FText::Format(LOCTEXT("MeteoriteCrashFormat", "A meteorite crashed on {0}"), UFlareGameTools::DisplaySpacecraftName(TargetSpacecraft)),
+											FName("meteorite-crash"),
+											EFlareNotification::NT_Military,
+											false);
+					}
 
-				GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("meteorite-hit-station").PutName("sector", GetIdentifier()));
+					GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("meteorite-hit-station").PutName("sector", GetIdentifier()));
+				});
 			}
 		}
 
@@ -1722,25 +1927,25 @@ void UFlareSimulatedSector::ProcessMeteorites()
 	}
 }
 
-void UFlareSimulatedSector::GenerateMeteorites()
+void UFlareSimulatedSector::GenerateMeteorites(FRandomStream& RandomStream)
 {
 	for(UFlareSimulatedSpacecraft* Station : SectorStations)
 	{
 		float Probability = 0.0003;
-		if(FMath::FRand() >  Probability)
+		if(RandomStream.FRand() >  Probability)
 		{
 			continue;
 		}
 
 		float PowerRatio = 1 + FMath::Log2(0.002f * GetGame()->GetGameWorld()->GetDate());
-		GenerateMeteoriteGroup(Station, PowerRatio);
+		GenerateMeteoriteGroup(Station, PowerRatio, RandomStream);
 	}
 
 }
 
-void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio)
+void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio, FRandomStream& RandomStream)
 {
-	std::mt19937 e2(time(0));
+	std::mt19937 e2(RandomStream.GetUnsignedInt());
 
 	// Velocity is pick with a standard deviation and a mean increasing with the powerRatio
 
@@ -1773,7 +1978,7 @@ void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* Ta
 	std::normal_distribution<> AngularVelocityGen(0.f, 1.f);
 	std::normal_distribution<> DaysGen(20.f, 5.f);
 
-	FVector BaseLocation = TargetStation->GetData().Location + FMath::VRand() * FMath::FRandRange(1000000.f,1200000);
+	FVector BaseLocation = TargetStation->GetData().Location + RandomStream.VRand() * RandomStream.FRandRange(1000000.f,1200000);
 
 	int32 DaysBeforeImpact = FMath::Abs(DaysGen(e2)) + 1.f;
 
@@ -1788,12 +1993,12 @@ void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* Ta
 	{
 		FFlareMeteoriteSave Data;
 		Data.TargetStation = TargetStation->GetImmatriculation();
-		Data.MeteoriteMeshID = FMath::RandRange(0, MeshCount-1);
+		Data.MeteoriteMeshID = RandomStream.RandRange(0, MeshCount-1);
 		Data.IsMetal = IsMetal;
 		Data.BrokenDamage = FMath::Abs(MeteoriteResistanceGen(e2)+ 1.f);;
 		Data.LinearVelocity = VelocityVector;
-		Data.AngularVelocity = FMath::VRand() * AngularVelocityGen(e2);
-		Data.Rotation = FRotator(FMath::FRandRange(0,360), FMath::FRandRange(0,360), FMath::FRandRange(0,360));
+		Data.AngularVelocity = RandomStream.VRand() * AngularVelocityGen(e2);
+		Data.Rotation = FRotator(RandomStream.FRandRange(0,360), RandomStream.FRandRange(0,360), RandomStream.FRandRange(0,360));
 
 		Data.TargetOffset = FVector(OffsetGen(e2), OffsetGen(e2), OffsetGen(e2)) + Data.LinearVelocity.GetUnsafeNormal() * OffsetGen(e2) * 20;
 
@@ -1810,21 +2015,24 @@ void UFlareSimulatedSector::GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* Ta
 
 	float EffectivePowerRatio = (TotalEffectiveResistance / BaseResistance) * (Velocity / BaseVelocity);
 
-	if(TargetStation->GetCompany() == GetGame()->GetPC()->GetCompany())
+	ApplyOrDeferEffect([this, TargetStation, EffectivePowerRatio, Count, DaysBeforeImpact]()
 	{
-		if(GetGame()->GetPC()->GetCompany()->IsTechnologyUnlocked("early-warning"))
+		if(TargetStation->GetCompany() == GetGame()->GetPC()->GetCompany())
 		{
-			GetGame()->GetPC()->Notify(LOCTEXT("MeteoriteDetected", "Meteorites detected"),
-								FText::Format(LOCTEXT("MeteoriteDetectedFormat", "A meteorite group has been detected as potential danger for one of your stations at {0}"), GetSectorName()),
-								FName("meteorite-detected"),
-								EFlareNotification::NT_Military,
-								false);
+			if(GetGame()->GetPC()->GetCompany()->IsTechnologyUnlocked("early-warning"))
+			{
+				GetGame()->GetPC()->Notify(LOCTEXT("MeteoriteDetected", "Meteorites detected"),
+									FText::Format(LOCTEXT("MeteoriteDetectedFormat", "A meteorite group has been detected as potential danger for one of your stations at {0}"), GetSectorName()),
+									FName("meteorite-detected"),
+									EFlareNotification::NT_Military,
+									false);
+			}
 		}
-	}
-	else
-	{
-		GetGame()->GetQuestManager()->GetQuestGenerator()->GenerateMeteoriteQuest(TargetStation, EffectivePowerRatio, Count, DaysBeforeImpact);
-	}
+		else
+		{
+			GetGame()->GetQuestManager()->GetQuestGenerator()->GenerateMeteoriteQuest(TargetStation, EffectivePowerRatio, Count, DaysBeforeImpact);
+		}
+	});
 
 }
 
@@ -1916,6 +2124,50 @@ TMap<FFlareResourceDescription*, int32> UFlareSimulatedSector::DistributeResourc
 	return Resources;
 }
 
+void UFlareSimulatedSector::DeferEffects()
+{
+	DeferWorldEffects = true;
+}
+
+void UFlareSimulatedSector::ApplyOrDeferEffect(TFunction<void()> Effect)
+{
+	if (DeferWorldEffects)
+	{
+		DeferredEffects.Add(Effect);
+	}
+	else
+	{
+		Effect();
+	}
+}
+
+void UFlareSimulatedSector::AddPlayerRetaliation(float Retaliation)
+{
+	if (DeferWorldEffects)
+	{
+		DeferredRetaliation += Retaliation;
+	}
+	else
+	{
+		Game->GetPC()->GetCompany()->AddRetaliation(Retaliation);
+	}
+}
+
+void UFlareSimulatedSector::ApplyDeferredEffects()
+{
+	DeferWorldEffects = false;
+
+	Game->GetPC()->GetCompany()->AddRetaliation(DeferredRetaliation);
+	DeferredRetaliation = 0;
+
+	// Keep the order of the effects, as a serial simulation would
+	for (TFunction<void()>& Effect : DeferredEffects)
+	{
+		Effect();
+	}
+	DeferredEffects.Empty();
+}
+
 void UFlareSimulatedSector::UpdateFleetSupplyConsumptionStats()
 {
 	SectorData.FleetSupplyConsumptionStats.Append(SectorData.DailyFleetSupplyConsumption);
@@ -2185,4 +2437,10 @@ int32 UFlareSimulatedSector::GetCompanyCapturePoints(UFlareCompany* Company) con
 	}
 	return CapturePoints;
 }
+
+float UFlareSimulatedSector::GetPlayerRetaliation() const
+{
+	return Game->GetPC()->GetCompany()->GetRetaliation() + DeferredRetaliation;
+}
+
 #undef LOCTEXT_NAMESPACE
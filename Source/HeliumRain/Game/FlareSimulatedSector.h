@@ -119,6 +119,28 @@ struct FFlareSectorBattleState
 	}
 };
 
+/** Alive spacecraft counts of a company in a sector, the input of battle state queries */
+struct FFlareSectorBattleCounts
+{
+	int32 ShipCount;
+	int32 DangerousShipCount;
+	int32 DangerousActiveShipCount;
+	int32 StrandedShipCount;
+	int32 ControllableShipCount;
+	int32 StationCount;
+	int32 StationInCaptureCount;
+
+	FFlareSectorBattleCounts()
+		: ShipCount(0)
+		, DangerousShipCount(0)
+		, DangerousActiveShipCount(0)
+		, StrandedShipCount(0)
+		, ControllableShipCount(0)
+		, StationCount(0)
+		, StationInCaptureCount(0)
+	{}
+};
+
 /** Debris field settings */
 USTRUCT()
 struct FFlareDebrisFieldInfo
@@ -431,10 +453,9 @@ public:
 	void AttachStationToActor(UFlareSimulatedSpacecraft* Spacecraft, FName AttachActorName);
 	void AttachStationToComplexStation(UFlareSimulatedSpacecraft* Spacecraft, FName AttachStationName, FName AttachConnectorName);
 
+	/** Update all resource prices from the sector supply and demand */
 	void SimulatePriceVariation();
 
-	void SimulatePriceVariation(FFlareResourceDescription* Resource);
-
 	/** Can we load or buy this resource in this sector ? */
 	bool WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client);
 
@@ -450,13 +471,28 @@ public:
 	FText GetSectorBalanceText(bool ActiveOnly);
 
 	void ProcessMeteorites();
-	void GenerateMeteorites();
-	void GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio);
+	void GenerateMeteorites(FRandomStream& RandomStream);
+	void GenerateMeteoriteGroup(UFlareSimulatedSpacecraft* TargetStation, float PowerRatio, FRandomStream& RandomStream);
 
 	TMap<FFlareResourceDescription*, int32> DistributeResources(TMap<FFlareResourceDescription*, int32> Resources, UFlareSimulatedSpacecraft* Source, UFlareCompany* TargetCompany, bool DryRun);
 
+	/** Keep the effects of this sector on the rest of the world until ApplyDeferredEffects, so that sectors can be simulated in parallel */
+	void DeferEffects();
+
+	/** Apply an effect on companies, quests or the player now, or once the parallel simulation is over */
+	void ApplyOrDeferEffect(TFunction<void()> Effect);
+
+	/** Change the player retaliation. Deferred changes are still seen from this sector */
+	void AddPlayerRetaliation(float Retaliation);
+
+	/** Apply the kept effects in their original order, and stop deferring */
+	void ApplyDeferredEffects();
+
 protected:
 
+	/** Number of sectors at the shortest travel duration from this one */
+	int32 GetNearestSectorCount();
+
     /*----------------------------------------------------
         Protected data
     ----------------------------------------------------*/
@@ -481,8 +517,24 @@ protected:
 	UPROPERTY()
 	FFlareSectorOrbitParameters             SectorOrbitParameters;
 	const FFlareSectorDescription*          SectorDescription;
-	TMap<FFlareResourceDescription*, float> ResourcePrices;
-	TMap<FFlareResourceDescription*, FFlareFloatBuffer> LastResourcePrices;
+
+	/** Index in the world sector list, INDEX_NONE for travel sectors */
+	int32                                   WorldIndex;
+
+	/** Prices by resource catalog index, price histories are empty until used */
+	TArray<float>                           ResourcePrices;
+	TArray<FFlareFloatBuffer>               LastResourcePrices;
+
+	/** Battle counts by owner company. The active sector counts are rebuilt every frame at most */
+	TMap<UFlareCompany*, FFlareSectorBattleCounts> BattleCounts;
+	bool                                    BattleCountsDirty;
+	bool                                    BattleCountsFromActiveSector;
+	uint64                                  BattleCountsFrame;
+
+	// Deferred effects on the rest of the world
+	bool                                    DeferWorldEffects;
+	float                                   DeferredRetaliation;
+	TArray<TFunction<void()>>               DeferredEffects;
 
 public:
 
@@ -515,6 +567,16 @@ public:
         return SectorData.Identifier;
     }
 
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 	/** Get the description of this sector */
 	FText GetSectorDescription() const;
 
@@ -603,6 +665,12 @@ public:
 	/** Get the current battle status of a company */
 	FFlareSectorBattleState GetSectorBattleState(UFlareCompany* Company);
 
+	/** A spacecraft of the sector was added, removed, damaged, repaired, reserved or captured */
+	void InvalidateBattleState();
+
+	/** Rebuild the per-company battle counts if they are out of date */
+	void UpdateBattleCounts();
+
 	/** Get the current battle status text */
 	FText GetSectorBattleStateText(UFlareCompany* Company);
 
@@ -614,6 +682,9 @@ public:
 
 	int32 GetCompanyCapturePoints(UFlareCompany* Company) const;
 
+	/** Player retaliation as seen from this sector, with its deferred changes */
+	float GetPlayerRetaliation() const;
+
 	TArray<FFlareMeteoriteSave>& GetMeteorites()
 	{
 		return SectorData.MeteoriteData;
@@ -0,0 +1,336 @@
+#include "FlareSimulationProfiler.h"
+#include "../Flare.h"
+
+#include "FlareCompany.h"
+#include "FlareSimulatedSector.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate PlayerAutoTrade"), STAT_FlareWorld_Simulate_PlayerAutoTrade, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Battles"), STAT_FlareWorld_Simulate_Battles, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate GlobalTrading"), STAT_FlareWorld_Simulate_GlobalTrading, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate CompanyAI"), STAT_FlareWorld_Simulate_CompanyAI, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Meteorites"), STAT_FlareWorld_Simulate_Meteorites, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate MutualAssistance"), STAT_FlareWorld_Simulate_MutualAssistance, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate RepairRefill"), STAT_FlareWorld_Simulate_RepairRefill, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Capture"), STAT_FlareWorld_Simulate_Capture, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Factories"), STAT_FlareWorld_Simulate_Factories, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate People"), STAT_FlareWorld_Simulate_People, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate TradeRoutes"), STAT_FlareWorld_Simulate_TradeRoutes, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Travels"), STAT_FlareWorld_Simulate_Travels, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Prices"), STAT_FlareWorld_Simulate_Prices, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate ReserveShips"), STAT_FlareWorld_Simulate_ReserveShips, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate EndOfDay"), STAT_FlareWorld_Simulate_EndOfDay, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWorld Simulate Quests"), STAT_FlareWorld_Simulate_Quests, STATGROUP_Flare);
+
+
+#if STATS
+static TStatId GetPhaseStatId(EFlareSimulationPhase::Type Phase)
+{
+	switch (Phase)
+	{
+		case EFlareSimulationPhase::PlayerAutoTrade:   return GET_STATID(STAT_FlareWorld_Simulate_PlayerAutoTrade);
+		case EFlareSimulationPhase::Battles:           return GET_STATID(STAT_FlareWorld_Simulate_Battles);
+		case EFlareSimulationPhase::GlobalTrading:     return GET_STATID(STAT_FlareWorld_Simulate_GlobalTrading);
+		case EFlareSimulationPhase::CompanyAI:         return GET_STATID(STAT_FlareWorld_Simulate_CompanyAI);
+		case EFlareSimulationPhase::Meteorites:        return GET_STATID(STAT_FlareWorld_Simulate_Meteorites);
+		case EFlareSimulationPhase::MutualAssistance:  return GET_STATID(STAT_FlareWorld_Simulate_MutualAssistance);
+		case EFlareSimulationPhase::RepairRefill:      return GET_STATID(STAT_FlareWorld_Simulate_RepairRefill);
+		case EFlareSimulationPhase::Capture:           return GET_STATID(STAT_FlareWorld_Simulate_Capture);
+		case EFlareSimulationPhase::Factories:         return GET_STATID(STAT_FlareWorld_Simulate_Factories);
+		case EFlareSimulationPhase::People:            return GET_STATID(STAT_FlareWorld_Simulate_People);
+		case EFlareSimulationPhase::TradeRoutes:       return GET_STATID(STAT_FlareWorld_Simulate_TradeRoutes);
+		case EFlareSimulationPhase::Travels:           return GET_STATID(STAT_FlareWorld_Simulate_Travels);
+		case EFlareSimulationPhase::Prices:            return GET_STATID(STAT_FlareWorld_Simulate_Prices);
+		case EFlareSimulationPhase::ReserveShips:      return GET_STATID(STAT_FlareWorld_Simulate_ReserveShips);
+		case EFlareSimulationPhase::EndOfDay:          return GET_STATID(STAT_FlareWorld_Simulate_EndOfDay);
+		case EFlareSimulationPhase::Quests:
+		default:                                       return GET_STATID(STAT_FlareWorld_Simulate_Quests);
+	}
+}
+#endif
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+FFlareSimulationProfiler::FFlareSimulationProfiler()
+	: HistorySize(60)
+	, InDay(false)
+	, CurrentPhase(INDEX_NONE)
+	, DayStartTime(0)
+	, PhaseStartTime(0)
+{
+}
+
+
+/*----------------------------------------------------
+	Recording
+----------------------------------------------------*/
+
+void FFlareSimulationProfiler::BeginDay(int64 Date)
+{
+	if (InDay)
+	{
+		EndDay();
+	}
+
+	CurrentDay.Date = Date;
+	CurrentDay.TotalTime = 0;
+	CurrentDay.CompanyTimes.Empty();
+	CurrentDay.SectorTimes.Empty();
+	for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count; PhaseIndex++)
+	{
+		CurrentDay.PhaseTimes[PhaseIndex] = 0;
+	}
+
+	InDay = true;
+	CurrentPhase = INDEX_NONE;
+	DayStartTime = FPlatformTime::Seconds();
+}
+
+void FFlareSimulationProfiler::StartPhase(EFlareSimulationPhase::Type Phase)
+{
+	if (!InDay)
+	{
+		return;
+	}
+
+	EndPhase();
+
+	CurrentPhase = Phase;
+	PhaseStartTime = FPlatformTime::Seconds();
+
+#if STATS
+	PhaseCycleCounter.Start(GetPhaseStatId(Phase));
+#endif
+}
+
+void FFlareSimulationProfiler::EndPhase()
+{
+	if (CurrentPhase == INDEX_NONE)
+	{
+		return;
+	}
+
+#if STATS
+	PhaseCycleCounter.Stop();
+#endif
+
+	CurrentDay.PhaseTimes[CurrentPhase] += FPlatformTime::Seconds() - PhaseStartTime;
+	CurrentPhase = INDEX_NONE;
+}
+
+void FFlareSimulationProfiler::EndDay()
+{
+	if (!InDay)
+	{
+		return;
+	}
+
+	EndPhase();
+	CurrentDay.TotalTime = FPlatformTime::Seconds() - DayStartTime;
+	InDay = false;
+
+	History.Add(CurrentDay);
+	if (History.Num() > HistorySize)
+	{
+		History.RemoveAt(0, History.Num() - HistorySize);
+	}
+}
+
+void FFlareSimulationProfiler::AddCompanyTime(UFlareCompany* Company, double Seconds)
+{
+	if (InDay && Company)
+	{
+		FScopeLock Lock(&EntityTimesLock);
+		CurrentDay.CompanyTimes.FindOrAdd(Company->GetIdentifier()) += Seconds;
+	}
+}
+
+void FFlareSimulationProfiler::AddSectorTime(UFlareSimulatedSector* Sector, double Seconds)
+{
+	if (InDay && Sector)
+	{
+		FScopeLock Lock(&EntityTimesLock);
+		CurrentDay.SectorTimes.FindOrAdd(Sector->GetIdentifier()) += Seconds;
+	}
+}
+
+void FFlareSimulationProfiler::SetHistorySize(int32 NewSize)
+{
+	HistorySize = FMath::Max(1, NewSize);
+
+	if (History.Num() > HistorySize)
+	{
+		History.RemoveAt(0, History.Num() - HistorySize);
+	}
+}
+
+void FFlareSimulationProfiler::Clear()
+{
+	EndPhase();
+	History.Empty();
+	InDay = false;
+}
+
+
+/*----------------------------------------------------
+	Reporting
+----------------------------------------------------*/
+
+double FFlareSimulationProfiler::GetPhasePercentile(EFlareSimulationPhase::Type Phase, float Percentile) const
+{
+	TArray<double> Values;
+	for (const FFlareSimulationDayProfile& Day : History)
+	{
+		Values.Add(Day.PhaseTimes[Phase]);
+	}
+
+	return ComputePercentile(Values, Percentile);
+}
+
+double FFlareSimulationProfiler::GetTotalPercentile(float Percentile) const
+{
+	TArray<double> Values;
+	for (const FFlareSimulationDayProfile& Day : History)
+	{
+		Values.Add(Day.TotalTime);
+	}
+
+	return ComputePercentile(Values, Percentile);
+}
+
+void FFlareSimulationProfiler::PrintReport(int32 EntityCount) const
+{
+	if (History.Num() == 0)
+	{
+		FLOG("FFlareSimulationProfiler::PrintReport : no simulated day recorded");
+		return;
+	}
+
+	FLOGV("Simulation profile over %d days (%lld to %lld), times in ms",
+		History.Num(), History[0].Date, History.Last().Date);
+	FLOG("  phase                  p50        p90        p99        max");
+
+	for (int32 PhaseIndex = 0; PhaseIndex < EFlareSimulationPhase::Count; PhaseIndex++)
+	{
+		EFlareSimulationPhase::Type Phase = (EFlareSimulationPhase::Type) PhaseIndex;
+		FLOGV("  %-18s %10.3f %10.3f %10.3f %10.3f",
+			GetPhaseName(Phase),
+			1000 * GetPhasePercentile(Phase, 50),
+			1000 * GetPhasePercentile(Phase, 90),
+			1000 * GetPhasePercentile(Phase, 99),
+			1000 * GetPhasePercentile(Phase, 100));
+	}
+
+	FLOGV("  %-18s %10.3f %10.3f %10.3f %10.3f",
+		TEXT("Total"),
+		1000 * GetTotalPercentile(50),
+		1000 * GetTotalPercentile(90),
+		1000 * GetTotalPercentile(99),
+		1000 * GetTotalPercentile(100));
+
+	// Average entity cost over the history
+	auto PrintCostliest = [&](const TCHAR* Title, TMap<FName, double> FFlareSimulationDayProfile::* Member)
+	{
+		TMap<FName, double> Totals;
+		for (const FFlareSimulationDayProfile& Day : History)
+		{
+			for (const TPair<FName, double>& Entry : Day.*Member)
+			{
+				Totals.FindOrAdd(Entry.Key) += Entry.Value;
+			}
+		}
+
+		Totals.ValueSort([](double A, double B)
+		{
+			return A > B;
+		});
+
+		FLOGV("  Costliest %s (average ms per day)", Title);
+		int32 PrintedCount = 0;
+		for (const TPair<FName, double>& Entry : Totals)
+		{
+			if (PrintedCount++ >= EntityCount)
+			{
+				break;
+			}
+			FLOGV("  - %-24s %10.3f", *Entry.Key.ToString(), 1000 * Entry.Value / History.Num());
+		}
+	};
+
+	PrintCostliest(TEXT("companies"), &FFlareSimulationDayProfile::CompanyTimes);
+	PrintCostliest(TEXT("sectors"), &FFlareSimulationDayProfile::SectorTimes);
+}
+
+const TCHAR* FFlareSimulationProfiler::GetPhaseName(EFlareSimulationPhase::Type Phase)
+{
+	switch (Phase)
+	{
+		case EFlareSimulationPhase::PlayerAutoTrade:   return TEXT("PlayerAutoTrade");
+		case EFlareSimulationPhase::Battles:           return TEXT("Battles");
+		case EFlareSimulationPhase::GlobalTrading:     return TEXT("GlobalTrading");
+		case EFlareSimulationPhase::CompanyAI:         return TEXT("CompanyAI");
+		case EFlareSimulationPhase::Meteorites:        return TEXT("Meteorites");
+		case EFlareSimulationPhase::MutualAssistance:  return TEXT("MutualAssistance");
+		case EFlareSimulationPhase::RepairRefill:      return TEXT("RepairRefill");
+		case EFlareSimulationPhase::Capture:           return TEXT("Capture");
+		case EFlareSimulationPhase::Factories:         return TEXT("Factories");
+		case EFlareSimulationPhase::People:            return TEXT("People");
+		case EFlareSimulationPhase::TradeRoutes:       return TEXT("TradeRoutes");
+		case EFlareSimulationPhase::Travels:           return TEXT("Travels");
+		case EFlareSimulationPhase::Prices:            return TEXT("Prices");
+		case EFlareSimulationPhase::ReserveShips:      return TEXT("ReserveShips");
+		case EFlareSimulationPhase::EndOfDay:          return TEXT("EndOfDay");
+		case EFlareSimulationPhase::Quests:            return TEXT("Quests");
+		default:                                       return TEXT("Unknown");
+	}
+}
+
+double FFlareSimulationProfiler::ComputePercentile(TArray<double>& Values, float Percentile)
+{
+	if (Values.Num() == 0)
+	{
+		return 0;
+	}
+
+	// Nearest-rank percentile
+	Values.Sort();
+	int32 Rank = FMath::CeilToInt(FMath::Clamp(Percentile, 0.f, 100.f) / 100.f * Values.Num());
+	return Values[FMath::Clamp(Rank - 1, 0, Values.Num() - 1)];
+}
+
+
+/*----------------------------------------------------
+	Scope
+----------------------------------------------------*/
+
+FFlareSimulationScope::FFlareSimulationScope(FFlareSimulationProfiler& ProfilerParam, UFlareCompany* CompanyParam)
+	: Profiler(ProfilerParam)
+	, Company(CompanyParam)
+	, Sector(NULL)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FFlareSimulationScope::FFlareSimulationScope(FFlareSimulationProfiler& ProfilerParam, UFlareSimulatedSector* SectorParam)
+	: Profiler(ProfilerParam)
+	, Company(NULL)
+	, Sector(SectorParam)
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+FFlareSimulationScope::~FFlareSimulationScope()
+{
+	double Duration = FPlatformTime::Seconds() - StartTime;
+
+	if (Company)
+	{
+		Profiler.AddCompanyTime(Company, Duration);
+	}
+	else if (Sector)
+	{
+		Profiler.AddSectorTime(Sector, Duration);
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../Flare.h"
+
+
+class UFlareCompany;
+class UFlareSimulatedSector;
+
+
+/** Phases of the daily world simulation */
+namespace EFlareSimulationPhase
+{
+	enum Type
+	{
+		PlayerAutoTrade,
+		Battles,
+		GlobalTrading,
+		CompanyAI,
+		Meteorites,
+		MutualAssistance,
+		RepairRefill,
+		Capture,
+		Factories,
+		People,
+		TradeRoutes,
+		Travels,
+		Prices,
+		ReserveShips,
+		EndOfDay,
+		Quests,
+
+		Count
+	};
+}
+
+
+/** Timings of one simulated day */
+struct FFlareSimulationDayProfile
+{
+	int64                                      Date;
+	double                                     TotalTime;
+	double                                     PhaseTimes[EFlareSimulationPhase::Count];
+	TMap<FName, double>                        CompanyTimes;
+	TMap<FName, double>                        SectorTimes;
+};
+
+
+/** Rolling history of the daily simulation timings */
+class HELIUMRAIN_API FFlareSimulationProfiler
+{
+public:
+
+	FFlareSimulationProfiler();
+
+	/*----------------------------------------------------
+		Recording
+	----------------------------------------------------*/
+
+	/** Start recording a new day */
+	void BeginDay(int64 Date);
+
+	/** Close the current phase and open a new one */
+	void StartPhase(EFlareSimulationPhase::Type Phase);
+
+	/** Stop recording the current day and push it to the history */
+	void EndDay();
+
+	/** Add time spent simulating this company, from any thread */
+	void AddCompanyTime(UFlareCompany* Company, double Seconds);
+
+	/** Add time spent simulating this sector, from any thread */
+	void AddSectorTime(UFlareSimulatedSector* Sector, double Seconds);
+
+	/** Set how many days are kept in history */
+	void SetHistorySize(int32 NewSize);
+
+	/** Remove all recorded days */
+	void Clear();
+
+
+	/*----------------------------------------------------
+		Reporting
+	----------------------------------------------------*/
+
+	/** Get the time below which Percentile % of the recorded days simulated this phase */
+	double GetPhasePercentile(EFlareSimulationPhase::Type Phase, float Percentile) const;
+
+	/** Get the time below which Percentile % of the recorded days were simulated */
+	double GetTotalPercentile(float Percentile) const;
+
+	/** Log percentile timings for every phase, and the costliest companies and sectors */
+	void PrintReport(int32 EntityCount = 5) const;
+
+	static const TCHAR* GetPhaseName(EFlareSimulationPhase::Type Phase);
+
+	inline const TArray<FFlareSimulationDayProfile>& GetHistory() const
+	{
+		return History;
+	}
+
+	inline bool IsRecording() const
+	{
+		return InDay;
+	}
+
+
+protected:
+
+	void EndPhase();
+
+	static double ComputePercentile(TArray<double>& Values, float Percentile);
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FFlareSimulationDayProfile>         History;
+	FFlareSimulationDayProfile                 CurrentDay;
+	int32                                      HistorySize;
+
+	bool                                       InDay;
+	int32                                      CurrentPhase;
+	double                                     DayStartTime;
+	double                                     PhaseStartTime;
+
+	/** Companies and sectors can be simulated in parallel */
+	FCriticalSection                           EntityTimesLock;
+
+#if STATS
+	FCycleCounter                              PhaseCycleCounter;
+#endif
+
+};
+
+
+/** Time a single company or sector as long as the scope lives */
+class HELIUMRAIN_API FFlareSimulationScope
+{
+public:
+
+	FFlareSimulationScope(FFlareSimulationProfiler& Profiler, UFlareCompany* Company);
+
+	FFlareSimulationScope(FFlareSimulationProfiler& Profiler, UFlareSimulatedSector* Sector);
+
+	~FFlareSimulationScope();
+
+protected:
+
+	FFlareSimulationProfiler&                  Profiler;
+	UFlareCompany*                             Company;
+	UFlareSimulatedSector*                     Sector;
+	double                                     StartTime;
+};
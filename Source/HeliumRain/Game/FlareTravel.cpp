@@ -388,6 +388,17 @@ void UFlareTravel::GenerateTravelDuration()
 }
 
 int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company)
+{
+	if (OriginSector == DestinationSector)
+	{
+		return 0;
+	}
+
+	bool FastTravel = (Company && Company->IsTechnologyUnlocked("fast-travel"));
+	return World->GetTravelDuration(OriginSector, DestinationSector, FastTravel);
+}
+
+int64 UFlareTravel::ComputeTravelDurationNoCache(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel)
 {
 	int64 TravelDuration = 0;
 
@@ -427,7 +438,7 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 		TravelDuration = (UFlareGameTools::SECONDS_IN_DAY/2 + ComputeAltitudeTravelDuration(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude)) / UFlareGameTools::SECONDS_IN_DAY;
 	}
 
-	if(Company && Company->IsTechnologyUnlocked("fast-travel"))
+	if (FastTravel)
 	{
 		TravelDuration /= 2;
 	}
@@ -81,8 +81,12 @@ public:
 
 	FFlareSectorOrbitParameters ComputeCurrentTravelLocation();
 
+	/** Travel duration in days, from the world travel duration matrix */
 	static int64 ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company);
 
+	/** Travel duration in days, computed from the sector orbits */
+	static int64 ComputeTravelDurationNoCache(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel);
+
 	static int64 ComputePhaseTravelDuration(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase);
 
 	static int64 ComputeAltitudeTravelDuration(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude);
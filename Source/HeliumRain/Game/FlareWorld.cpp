@@ -1,19 +1,25 @@
 
 #include "FlareWorld.h"
 #include "../Flare.h"
+#include "Async/ParallelFor.h"
 
 #include "../Data/FlareSpacecraftCatalog.h"
 #include "../Data/FlareSectorCatalogEntry.h"
+#include "../Data/FlareResourceCatalog.h"
 
 #include "../Economy/FlareFactory.h"
+#include "../Economy/FlarePeople.h"
 
 #include "FlareGame.h"
 #include "FlareGameTools.h"
 #include "FlareScenarioTools.h"
 #include "FlareSector.h"
+#include "FlareSectorHelper.h"
 #include "FlareTravel.h"
 #include "FlareFleet.h"
+#include "FlareTradeRoute.h"
 #include "FlareBattle.h"
+#include "AI/FlareAIBehavior.h"
 #include "AI/FlareAITradeHelper.h"
 
 #include "../Quests/FlareQuest.h"
@@ -105,6 +111,7 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
 		LoadSector(SectorDescription, *SectorSave, OrbitParameters);
 	}
 
+	ComputeTravelDurations();
 	UpdateStorageLocks();
 
 	// Load all travels
@@ -131,7 +138,9 @@ UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
     // Create the new company
 	Company = NewObject<UFlareCompany>(this, UFlareCompany::StaticClass(), CompanyData.Identifier);
     Company->Load(CompanyData);
-    Companies.AddUnique(Company);
+    Company->SetWorldIndex(Companies.AddUnique(Company));
+    CompanyIndex.Add(Company->GetIdentifier(), Company);
+    ComputeHostilityMatrix();
 
 	//FLOGV("UFlareWorld::LoadCompany : loaded '%s'", *Company->GetCompanyName().ToString());
 
@@ -146,7 +155,8 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 	// Create the new sector
 	Sector = NewObject<UFlareSimulatedSector>(this, UFlareSimulatedSector::StaticClass(), SectorData.Identifier);
 	Sector->Load(Description, SectorData, OrbitParameters);
-	Sectors.AddUnique(Sector);
+	Sector->SetWorldIndex(Sectors.AddUnique(Sector));
+	SectorIndex.Add(Sector->GetIdentifier(), Sector);
 
 	//FLOGV("UFlareWorld::LoadSector : loaded '%s'", *Sector->GetSectorName().ToString());
 
@@ -154,6 +164,117 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 }
 
 
+void UFlareWorld::ComputeTravelDurations()
+{
+	// Sector orbits never change, all durations are known at load
+	int32 SectorCount = Sectors.Num();
+	TravelDurations.SetNumUninitialized(SectorCount * SectorCount);
+	FastTravelDurations.SetNumUninitialized(SectorCount * SectorCount);
+
+	for (int32 OriginIndex = 0; OriginIndex < SectorCount; OriginIndex++)
+	{
+		for (int32 DestinationIndex = 0; DestinationIndex < SectorCount; DestinationIndex++)
+		{
+			int32 PairIndex = OriginIndex * SectorCount + DestinationIndex;
+			TravelDurations[PairIndex] = UFlareTravel::ComputeTravelDurationNoCache(this, Sectors[OriginIndex], Sectors[DestinationIndex], false);
+			FastTravelDurations[PairIndex] = UFlareTravel::ComputeTravelDurationNoCache(this, Sectors[OriginIndex], Sectors[DestinationIndex], true);
+		}
+	}
+}
+
+int64 UFlareWorld::GetTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel)
+{
+	int32 SectorCount = Sectors.Num();
+	int32 OriginIndex = OriginSector->GetWorldIndex();
+	int32 DestinationIndex = DestinationSector->GetWorldIndex();
+
+	// Travel sectors move, and are not in the matrix
+	if (OriginIndex == INDEX_NONE || DestinationIndex == INDEX_NONE || TravelDurations.Num() != SectorCount * SectorCount)
+	{
+		return UFlareTravel::ComputeTravelDurationNoCache(this, OriginSector, DestinationSector, FastTravel);
+	}
+
+	int32 PairIndex = OriginIndex * SectorCount + DestinationIndex;
+	return FastTravel ? FastTravelDurations[PairIndex] : TravelDurations[PairIndex];
+}
+
+void UFlareWorld::ComputeHostilityMatrix()
+{
+	// Hostility lists may name companies not loaded yet, the matrix is built again with each company
+	int32 CompanyCount = Companies.Num();
+	HostilityMatrix.Init(false, CompanyCount * CompanyCount);
+	WarMatrix.Init(false, CompanyCount * CompanyCount);
+
+	for (int32 Index = 0; Index < CompanyCount; Index++)
+	{
+		for (int32 TargetIndex = 0; TargetIndex < CompanyCount; TargetIndex++)
+		{
+			if (Index != TargetIndex && Companies[Index]->IsHostileNoCache(Companies[TargetIndex]))
+			{
+				HostilityMatrix[Index * CompanyCount + TargetIndex] = true;
+				WarMatrix[Index * CompanyCount + TargetIndex] = true;
+				WarMatrix[TargetIndex * CompanyCount + Index] = true;
+			}
+		}
+	}
+}
+
+int32 UFlareWorld::GetCompanyPairIndex(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const
+{
+	int32 CompanyCount = Companies.Num();
+	int32 Index = Company->GetWorldIndex();
+	int32 TargetIndex = TargetCompany->GetWorldIndex();
+
+	if (Index == INDEX_NONE || TargetIndex == INDEX_NONE || HostilityMatrix.Num() != CompanyCount * CompanyCount)
+	{
+		return INDEX_NONE;
+	}
+
+	return Index * CompanyCount + TargetIndex;
+}
+
+bool UFlareWorld::IsHostile(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const
+{
+	int32 PairIndex = GetCompanyPairIndex(Company, TargetCompany);
+
+	// Companies being loaded are not in the matrix yet
+	if (PairIndex == INDEX_NONE)
+	{
+		return Company->IsHostileNoCache(TargetCompany);
+	}
+
+	return HostilityMatrix[PairIndex];
+}
+
+bool UFlareWorld::IsAtWar(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const
+{
+	int32 PairIndex = GetCompanyPairIndex(Company, TargetCompany);
+
+	if (PairIndex == INDEX_NONE)
+	{
+		return Company->IsHostileNoCache(TargetCompany) || TargetCompany->IsHostileNoCache(Company);
+	}
+
+	return WarMatrix[PairIndex];
+}
+
+void UFlareWorld::SetHostility(const UFlareCompany* Company, const UFlareCompany* TargetCompany, bool Hostile)
+{
+	int32 PairIndex = GetCompanyPairIndex(Company, TargetCompany);
+	int32 ReversePairIndex = GetCompanyPairIndex(TargetCompany, Company);
+
+	if (PairIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	HostilityMatrix[PairIndex] = Hostile;
+
+	bool AtWar = HostilityMatrix[PairIndex] || HostilityMatrix[ReversePairIndex];
+	WarMatrix[PairIndex] = AtWar;
+	WarMatrix[ReversePairIndex] = AtWar;
+}
+
 UFlareTravel* UFlareWorld::LoadTravel(const FFlareTravelSave& TravelData)
 {
 	UFlareTravel* Travel = NULL;
@@ -169,42 +290,37 @@ UFlareTravel* UFlareWorld::LoadTravel(const FFlareTravelSave& TravelData)
 }
 
 
-FFlareWorldSave* UFlareWorld::Save()
+void UFlareWorld::Save(FFlareWorldSave& SaveData)
 {
-	WorldData.CompanyData.Empty();
-	WorldData.SectorData.Empty();
-	WorldData.TravelData.Empty();
+	SaveData.Date = WorldData.Date;
 
 	// Companies
+	SaveData.CompanyData.SetNum(Companies.Num());
 	for (int i = 0; i < Companies.Num(); i++)
 	{
-		UFlareCompany* Company = Companies[i];
-
-		//FLOGV("UFlareWorld::Save : saving company ('%s')", *Company->GetName());
-		FFlareCompanySave* TempData = Company->Save();
-		WorldData.CompanyData.Add(*TempData);
+		//FLOGV("UFlareWorld::Save : saving company ('%s')", *Companies[i]->GetName());
+		Companies[i]->Save(SaveData.CompanyData[i]);
 	}
 
 	// Sectors
+	SaveData.SectorData.Reset(Sectors.Num());
 	for (int i = 0; i < Sectors.Num(); i++)
 	{
 		UFlareSimulatedSector* Sector = Sectors[i];
 		//FLOGV("UFlareWorld::Save : saving sector ('%s')", *Sector->GetName());
 
-		WorldData.SectorData.Add(*Sector->Save());
+		SaveData.SectorData.Add(*Sector->Save());
 	}
 
 	// Travels
+	SaveData.TravelData.Reset(Travels.Num());
 	for (int i = 0; i < Travels.Num(); i++)
 	{
 		UFlareTravel* Travel = Travels[i];
 
 		//FLOGV("UFlareWorld::Save : saving travel for ('%s')", *Travel->GetFleet()->GetFleetName().ToString());
-		FFlareTravelSave* TempData = Travel->Save();
-		WorldData.TravelData.Add(*TempData);
+		SaveData.TravelData.Add(*Travel->Save());
 	}
-
-	return &WorldData;
 }
 
 
@@ -423,11 +539,18 @@ void UFlareWorld::Simulate()
 	 *  End previous day
 	 */
 	FLOGV("** Simulate day %d", WorldData.Date);
+	SimulationProfiler.BeginDay(WorldData.Date);
 
 	FLOG("* Simulate > Player autotrade");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::PlayerAutoTrade);
 	AITradeHelper::CompanyAutoTrade(PlayerCompany);
 
 	FLOG("* Simulate > Battles");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Battles);
+	// Battles are fought in parallel, each from the random stream of its sector. Their effects on the rest of the world are then applied in sector order
+	TArray<UFlareBattle*> Battles;
+	Battles.SetNumZeroed(Sectors.Num());
+
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
@@ -461,10 +584,25 @@ void UFlareWorld::Simulate()
 
 		if (HasBattle)
 		{
-			UFlareBattle* Battle = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
-			Battle->Load(Sector);
-			Battle->Simulate();
+			Battles[SectorIndex] = NewObject<UFlareBattle>(this, UFlareBattle::StaticClass());
+			Battles[SectorIndex]->Load(Sector, GetSectorRandomStream(Sector, EFlareSimulationPhase::Battles));
+			Sector->DeferEffects();
 		}
+	}
+
+	ParallelFor(Sectors.Num(), [this, &Battles](int32 SectorIndex)
+	{
+		if (Battles[SectorIndex])
+		{
+			FFlareSimulationScope SectorScope(SimulationProfiler, Sectors[SectorIndex]);
+			Battles[SectorIndex]->Simulate();
+		}
+	});
+
+	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+		Sector->ApplyDeferredEffects();
 
 		// Remove destroyed spacecraft
 		TArray<UFlareSimulatedSpacecraft*> SpacecraftToRemove;
@@ -487,6 +625,7 @@ void UFlareWorld::Simulate()
 	}
 
 	FLOG("* Simulate > AI");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::GlobalTrading);
 
 	HasTotalWorldCombatPointCache = false;
 
@@ -543,35 +682,63 @@ void UFlareWorld::Simulate()
 	IdleShips.Print();
 #endif
 
-	// AI. Play them in random order
+	// AI. Plan them in parallel from the same world state, sharing one resource stats snapshot
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::CompanyAI);
+	InvalidateResourceStats();
+	PrepareCompanyAIPlanning();
+
+	ParallelFor(Companies.Num(), [this](int32 CompanyIndex)
+	{
+		Companies[CompanyIndex]->GetAI()->PlanSimulation();
+	});
+
+	// Then play them in a random order that only depends on the date
+	FRandomStream CompanyOrderStream(GetTypeHash(WorldData.Date));
 	TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
 	while(CompaniesToSimulateAI.Num())
 	{
-		int32 Index = FMath::RandRange(0, CompaniesToSimulateAI.Num() - 1);
-		CompaniesToSimulateAI[Index]->SimulateAI();
+		int32 Index = CompanyOrderStream.RandRange(0, CompaniesToSimulateAI.Num() - 1);
+		{
+			FFlareSimulationScope CompanyScope(SimulationProfiler, CompaniesToSimulateAI[Index]);
+			CompaniesToSimulateAI[Index]->SimulateAI();
+		}
 		CompaniesToSimulateAI.RemoveAt(Index);
 	}
 
-	// Clear bombs
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	// Clear bombs, and process meteorites. Impacts only damage the sector, notifications and quest events are applied in sector order
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Meteorites);
+	for (UFlareSimulatedSector* Sector : Sectors)
 	{
-		Sectors[SectorIndex]->ClearBombs();
+		Sector->DeferEffects();
 	}
 
+	ParallelFor(Sectors.Num(), [this](int32 SectorIndex)
+	{
+		FFlareSimulationScope SectorScope(SimulationProfiler, Sectors[SectorIndex]);
+		Sectors[SectorIndex]->ClearBombs();
+		Sectors[SectorIndex]->ProcessMeteorites();
+	});
 
-	// Process meteorites
-	for (UFlareSimulatedSector* Sector :Sectors)
+	for (UFlareSimulatedSector* Sector : Sectors)
 	{
-		Sector->ProcessMeteorites();
+		Sector->ApplyDeferredEffects();
+		Sector->DeferEffects();
 	}
 
-	// GenerateMeteorites
-	for (UFlareSimulatedSector* Sector :Sectors)
+	// GenerateMeteorites, from the random stream of each sector
+	ParallelFor(Sectors.Num(), [this](int32 SectorIndex)
 	{
-		Sector->GenerateMeteorites();
+		FRandomStream MeteoriteStream = GetSectorRandomStream(Sectors[SectorIndex], EFlareSimulationPhase::Meteorites);
+		Sectors[SectorIndex]->GenerateMeteorites(MeteoriteStream);
+	});
+
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		Sector->ApplyDeferredEffects();
 	}
 
 
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::MutualAssistance);
 	CompanyMutualAssistance();
 	CheckIntegrity();
 
@@ -579,6 +746,7 @@ void UFlareWorld::Simulate()
 	 *  Begin day
 	 */
 	FLOG("* Simulate > New day");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::RepairRefill);
 
 	WorldData.Date++;
 
@@ -695,11 +863,13 @@ void UFlareWorld::Simulate()
 	}
 
 	// Spacrecraft capture
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Capture);
 	ProcessShipCapture();
 	ProcessStationCapture();
 
 	// Factories
 	FLOG("* Simulate > Factories");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Factories);
 	for (UFlareFactory* Factory: Factories)
 	{
 		if(Factory->IsShipyard())
@@ -716,13 +886,23 @@ void UFlareWorld::Simulate()
 
 	// Peoples
 	FLOG("* Simulate > Peoples");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::People);
+	// Sectors are simulated in parallel, the company payments and world money changes are then applied in sector order
+	InvalidateResourceStats();
+	ParallelFor(Sectors.Num(), [this](int32 SectorIndex)
+	{
+		FFlareSimulationScope SectorScope(SimulationProfiler, Sectors[SectorIndex]);
+		Sectors[SectorIndex]->GetPeople()->Simulate(true);
+	});
+
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
-		Sectors[SectorIndex]->GetPeople()->Simulate();
+		Sectors[SectorIndex]->GetPeople()->ApplyDeferredEffects();
 	}
 
 
 	FLOG("* Simulate > Trade routes");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::TradeRoutes);
 
 	// Trade routes
 	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
@@ -735,6 +915,7 @@ void UFlareWorld::Simulate()
 		}
 	}
 	FLOG("* Simulate > Travels");
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Travels);
 
 	// Undock and make move AI ships
 	for (UFlareSimulatedSector* Sector : Sectors)
@@ -758,30 +939,27 @@ void UFlareWorld::Simulate()
 	}
 	
 	FLOG("* Simulate > Prices");
-	// Price variation.
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Prices);
+	// Price variation, and swap prices. Prices only depend on the sector itself, and the money migration doesn't read them
+	ParallelFor(Sectors.Num(), [this](int32 SectorIndex)
 	{
+		FFlareSimulationScope SectorScope(SimulationProfiler, Sectors[SectorIndex]);
 		Sectors[SectorIndex]->SimulatePriceVariation();
-	}
+		Sectors[SectorIndex]->SwapPrices();
+	});
 
 	// People money migration
 	SimulatePeopleMoneyMigration();
 
-	// Process events
-
-	// Swap Prices.
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
-	{
-		Sectors[SectorIndex]->SwapPrices();
-	}
-	
 	// Update reserve ships
-	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::ReserveShips);
+	ParallelFor(Sectors.Num(), [this](int32 SectorIndex)
 	{
 		Sectors[SectorIndex]->UpdateReserveShips();
-	}
+	});
 
 	// Update storage station reservation
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::EndOfDay);
 	UpdateStorageLocks();
 
 	// Player being attacked ?
@@ -795,10 +973,14 @@ void UFlareWorld::Simulate()
 		Company->InvalidateCompanyValueCache();
 	}
 
+	// Population, damages and fleet supply stats changed during the day
+	InvalidateResourceStats();
+
 	
 	double EndTs = FPlatformTime::Seconds();
 	FLOGV("** Simulate day %d done in %.6fs", WorldData.Date-1, EndTs- StartTs);
 
+	SimulationProfiler.StartPhase(EFlareSimulationPhase::Quests);
 	Game->GetQuestManager()->OnNextDay();
 
 	GameLog::DaySimulated(WorldData.Date);
@@ -876,6 +1058,8 @@ void UFlareWorld::Simulate()
 	 {
 		 GetGame()->GetPC()->SetAchievementProgression("ACHIEVEMENT_ALL_SHIPS", 1);
 	 }
+
+	 SimulationProfiler.EndDay();
 }
 
 void UFlareWorld::CheckAIBattleState()
@@ -1654,11 +1838,144 @@ void UFlareWorld::ClearFactories(UFlareSimulatedSpacecraft *ParentSpacecraft)
 			Factories.RemoveAt(FactoryIndex);
 		}
 	}
+
+	InvalidateResourceStats(ParentSpacecraft->GetCurrentSector());
 }
 
 void UFlareWorld::AddFactory(UFlareFactory* Factory)
 {
 	Factories.Add(Factory);
+
+	InvalidateResourceStats(Factory->GetParent()->GetCurrentSector());
+}
+
+
+void UFlareWorld::PrepareCompanyAIPlanning()
+{
+	// Resolve lazily computed state so that the planning threads only read the world
+	GetWorldResourceStats(true);
+
+	for (UFlareCompany* Company : Companies)
+	{
+		Company->GetAI()->GetBehavior()->Load(Company);
+		Company->GetCompanyValue();
+	}
+
+	for (UFlareFactory* Factory : Factories)
+	{
+		Factory->GetCycleData();
+	}
+
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		Sector->UpdateBattleCounts();
+
+		for (UFlareResourceCatalogEntry* Resource : Game->GetResourceCatalog()->Resources)
+		{
+			Sector->GetPreciseResourcePrice(&Resource->Data);
+			Sector->GetPeople()->GetRessourceConsumption(&Resource->Data, false);
+		}
+
+		for (UFlareSimulatedSpacecraft* Spacecraft : Sector->GetSectorSpacecrafts())
+		{
+			Spacecraft->GetDamageSystem()->GetSubsystemHealth(EFlareSubsystem::SYS_LifeSupport);
+		}
+	}
+
+	for (UFlareTravel* Travel : Travels)
+	{
+		for (UFlareSimulatedSpacecraft* Ship : Travel->GetFleet()->GetShips())
+		{
+			Ship->GetDamageSystem()->GetSubsystemHealth(EFlareSubsystem::SYS_LifeSupport);
+		}
+	}
+}
+
+FRandomStream UFlareWorld::GetSectorRandomStream(UFlareSimulatedSector* Sector, EFlareSimulationPhase::Type Phase) const
+{
+	// Hash the identifier string, name hashes change from a run to another
+	uint32 Seed = HashCombine(GetTypeHash(WorldData.Date), GetTypeHash(Sector->GetIdentifier().ToString()));
+	return FRandomStream(HashCombine(Seed, GetTypeHash((int32) Phase)));
+}
+
+
+/*----------------------------------------------------
+	Resource stats
+----------------------------------------------------*/
+
+const TArray<WorldHelper::FlareResourceStats>& UFlareWorld::GetWorldResourceStats(bool IncludeStorage)
+{
+	return UpdateResourceStats(IncludeStorage).WorldStats;
+}
+
+const TArray<WorldHelper::FlareResourceStats>& UFlareWorld::GetSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage)
+{
+	return UpdateResourceStats(IncludeStorage).SectorStats[Sector];
+}
+
+void UFlareWorld::InvalidateResourceStats(UFlareSimulatedSector* Sector)
+{
+	if (!Sector)
+	{
+		return;
+	}
+
+	for (FFlareResourceStatsSnapshot& Snapshot : ResourceStatsSnapshots)
+	{
+		if (Snapshot.Valid)
+		{
+			Snapshot.DirtySectors.Add(Sector);
+		}
+	}
+}
+
+void UFlareWorld::InvalidateResourceStats()
+{
+	for (FFlareResourceStatsSnapshot& Snapshot : ResourceStatsSnapshots)
+	{
+		Snapshot.Valid = false;
+	}
+}
+
+FFlareResourceStatsSnapshot& UFlareWorld::UpdateResourceStats(bool IncludeStorage)
+{
+	FFlareResourceStatsSnapshot& Snapshot = ResourceStatsSnapshots[IncludeStorage ? 1 : 0];
+
+	if (!Snapshot.Valid)
+	{
+		// Full scan, every sector gets an entry so that references stay valid until the next full scan
+		Snapshot.SectorStats.Empty(Sectors.Num());
+		for (UFlareSimulatedSector* Sector : Sectors)
+		{
+			Snapshot.SectorStats.Add(Sector, SectorHelper::ComputeSectorResourceStats(Sector, IncludeStorage));
+		}
+
+		Snapshot.DirtySectors.Empty();
+		Snapshot.WorldStatsDirty = true;
+		Snapshot.Valid = true;
+	}
+	else if (Snapshot.DirtySectors.Num() > 0)
+	{
+		for (UFlareSimulatedSector* Sector : Snapshot.DirtySectors)
+		{
+			TArray<WorldHelper::FlareResourceStats>* Stats = Snapshot.SectorStats.Find(Sector);
+			if (Stats)
+			{
+				*Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeStorage);
+			}
+		}
+
+		Snapshot.DirtySectors.Empty();
+		Snapshot.WorldStatsDirty = true;
+	}
+
+	if (Snapshot.WorldStatsDirty)
+	{
+		Snapshot.WorldStats = WorldHelper::ComputeWorldResourceStats(Game, Snapshot.SectorStats);
+		Snapshot.WorldStatsDirty = false;
+	}
+
+	return Snapshot;
 }
 
 
@@ -1748,21 +2065,76 @@ void UFlareWorld::DeleteTravel(UFlareTravel* Travel)
 }
 
 /*----------------------------------------------------
-	Getters
+	Lookup index
 ----------------------------------------------------*/
 
-UFlareCompany* UFlareWorld::FindCompany(FName Identifier) const
+void UFlareWorld::RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
-	for (int i = 0; i < Companies.Num(); i++)
+	if (Spacecraft->IsDestroyed())
 	{
-		UFlareCompany* Company = Companies[i];
-		if (Company->GetIdentifier() == Identifier)
-		{
-			return Company;
-		}
+		RegisterDestroyedSpacecraft(Spacecraft);
+	}
+	else if (!Spacecraft->IsComplexElement())
+	{
+		// Complex elements are only reachable through their complex
+		SpacecraftIndex.Add(Spacecraft->GetImmatriculation(), Spacecraft);
+	}
+}
+
+void UFlareWorld::RegisterDestroyedSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
+{
+	FName Immatriculation = Spacecraft->GetImmatriculation();
+
+	UFlareSimulatedSpacecraft** AliveSpacecraft = SpacecraftIndex.Find(Immatriculation);
+	if (AliveSpacecraft && *AliveSpacecraft == Spacecraft)
+	{
+		SpacecraftIndex.Remove(Immatriculation);
 	}
 
-	return NULL;
+	// Keep the first destroyed spacecraft with this immatriculation
+	if (!DestroyedSpacecraftIndex.Contains(Immatriculation))
+	{
+		DestroyedSpacecraftIndex.Add(Immatriculation, Spacecraft);
+	}
+}
+
+void UFlareWorld::RegisterFleet(UFlareFleet* Fleet)
+{
+	FleetIndex.Add(Fleet->GetIdentifier(), Fleet);
+}
+
+void UFlareWorld::UnregisterFleet(UFlareFleet* Fleet)
+{
+	UFlareFleet** IndexedFleet = FleetIndex.Find(Fleet->GetIdentifier());
+	if (IndexedFleet && *IndexedFleet == Fleet)
+	{
+		FleetIndex.Remove(Fleet->GetIdentifier());
+	}
+}
+
+void UFlareWorld::RegisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	TradeRouteIndex.Add(TradeRoute->GetIdentifier(), TradeRoute);
+}
+
+void UFlareWorld::UnregisterTradeRoute(UFlareTradeRoute* TradeRoute)
+{
+	UFlareTradeRoute** IndexedTradeRoute = TradeRouteIndex.Find(TradeRoute->GetIdentifier());
+	if (IndexedTradeRoute && *IndexedTradeRoute == TradeRoute)
+	{
+		TradeRouteIndex.Remove(TradeRoute->GetIdentifier());
+	}
+}
+
+
+/*----------------------------------------------------
+	Getters
+----------------------------------------------------*/
+
+UFlareCompany* UFlareWorld::FindCompany(FName Identifier) const
+{
+	UFlareCompany* const* Company = CompanyIndex.Find(Identifier);
+	return Company ? *Company : NULL;
 }
 
 UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
@@ -1782,84 +2154,54 @@ UFlareCompany* UFlareWorld::FindCompanyByShortName(FName CompanyShortName) const
 
 UFlareSimulatedSector* UFlareWorld::FindSector(FName Identifier) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
-	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		if (Sector->GetIdentifier() == Identifier)
-		{
-			return Sector;
-		}
-	}
-
-	return NULL;
+	UFlareSimulatedSector* const* Sector = SectorIndex.Find(Identifier);
+	return Sector ? *Sector : NULL;
 }
 
-UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
+UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName ShipImmatriculation) const
 {
-	for (int i = 0; i < Sectors.Num(); i++)
+	UFlareSimulatedSpacecraft* Spacecraft = FindAliveSpacecraft(ShipImmatriculation);
+	if (Spacecraft && Spacecraft->GetCurrentSector() && !Spacecraft->GetCurrentSector()->IsTravelSector())
 	{
-		UFlareSimulatedSector* Sector = Sectors[i];
-		for (int j = 0; j < Sector->GetSectorSpacecrafts().Num(); j++)
-		{
-			if (Sector->GetSectorSpacecrafts()[j]->GetDescription()->Identifier == SpacecraftIdentifier)
-			{
-				return Sector;
-			}
-		}
+		return Spacecraft->GetCurrentSector();
 	}
 	return NULL;
 }
 
 UFlareFleet* UFlareWorld::FindFleet(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareFleet* Fleet = Company->FindFleet(Identifier);
-		if (Fleet)
-		{
-			return Fleet;
-		}
-	}
-	return NULL;
+	UFlareFleet* const* Fleet = FleetIndex.Find(Identifier);
+	return Fleet ? *Fleet : NULL;
 }
 
 UFlareTradeRoute* UFlareWorld::FindTradeRoute(FName Identifier) const
 {
-	for (int i = 0; i < Companies.Num(); i++)
-	{
-		UFlareCompany* Company = Companies[i];
-		UFlareTradeRoute* TradeRoute = Company->FindTradeRoute(Identifier);
-		if (TradeRoute)
-		{
-			return TradeRoute;
-		}
-	}
-	return NULL;
+	UFlareTradeRoute* const* TradeRoute = TradeRouteIndex.Find(Identifier);
+	return TradeRoute ? *TradeRoute : NULL;
 }
 
 UFlareSimulatedSpacecraft* UFlareWorld::FindSpacecraft(FName ShipImmatriculation)
 {
-	for (UFlareCompany* Company : Companies)
+	UFlareSimulatedSpacecraft* Spacecraft = FindAliveSpacecraft(ShipImmatriculation);
+	if (Spacecraft)
 	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
+		return Spacecraft;
 	}
 
 	// Now check destroyed ships
-	for (UFlareCompany* Company : Companies)
-	{
-		UFlareSimulatedSpacecraft* Spacecraft = Company->FindSpacecraft(ShipImmatriculation, true);
-		if (Spacecraft)
-		{
-			return Spacecraft;
-		}
-	}
+	return FindDestroyedSpacecraft(ShipImmatriculation);
+}
 
-	return NULL;
+UFlareSimulatedSpacecraft* UFlareWorld::FindAliveSpacecraft(FName ShipImmatriculation) const
+{
+	UFlareSimulatedSpacecraft* const* Spacecraft = SpacecraftIndex.Find(ShipImmatriculation);
+	return Spacecraft ? *Spacecraft : NULL;
+}
+
+UFlareSimulatedSpacecraft* UFlareWorld::FindDestroyedSpacecraft(FName ShipImmatriculation) const
+{
+	UFlareSimulatedSpacecraft* const* Spacecraft = DestroyedSpacecraftIndex.Find(ShipImmatriculation);
+	return Spacecraft ? *Spacecraft : NULL;
 }
 
 
@@ -4,6 +4,8 @@
 #include "Object.h"
 #include "FlareGameTypes.h"
 #include "FlareTravel.h"
+#include "FlareSimulationProfiler.h"
+#include "FlareWorldHelper.h"
 #include "Planetarium/FlareSimulatedPlanetarium.h"
 #include "FlareWorld.generated.h"
 
@@ -99,6 +101,16 @@ struct IncomingValue
 	int32 CombatValue = 0;
 };
 
+/** Resource stats shared by every reader until the world changes */
+struct FFlareResourceStatsSnapshot
+{
+	bool                                                                                   Valid = false;
+	bool                                                                                   WorldStatsDirty = true;
+	TSet<UFlareSimulatedSector*>                                                           DirtySectors;
+	TMap<UFlareSimulatedSector*, TArray<WorldHelper::FlareResourceStats>>                  SectorStats;
+	TArray<WorldHelper::FlareResourceStats>                                                WorldStats;
+};
+
 
 
 UCLASS()
@@ -118,8 +130,8 @@ public:
 	/** Loading is done */
 	virtual void PostLoad();
 
-	/** Save the company to a save file */
-	virtual FFlareWorldSave* Save();
+	/** Save the world into a save snapshot, each company, sector and spacecraft is copied once */
+	virtual void Save(FFlareWorldSave& SaveData);
 
 	/** Spawn a company from save data */
 	virtual UFlareCompany* LoadCompany(const FFlareCompanySave& CompanyData);
@@ -171,6 +183,59 @@ public:
 	/** Add a factory to world */
 	void AddFactory(UFlareFactory* Factory);
 
+
+	/*----------------------------------------------------
+		Resource stats
+	----------------------------------------------------*/
+
+	/** Get the world resource stats, only the sectors changed since the last call are scanned again */
+	const TArray<WorldHelper::FlareResourceStats>& GetWorldResourceStats(bool IncludeStorage);
+
+	/** Get the resource stats of a sector from the shared snapshot */
+	const TArray<WorldHelper::FlareResourceStats>& GetSectorResourceStats(UFlareSimulatedSector* Sector, bool IncludeStorage);
+
+	/** Cargo or factories changed in this sector */
+	void InvalidateResourceStats(UFlareSimulatedSector* Sector);
+
+	/** Drop the whole snapshot */
+	void InvalidateResourceStats();
+
+	/** Travel duration in days between two sectors, computed when a sector is not in the matrix */
+	int64 GetTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, bool FastTravel);
+
+
+	/*----------------------------------------------------
+		Diplomacy
+	----------------------------------------------------*/
+
+	/** Check if a company declared war on the target company */
+	bool IsHostile(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const;
+
+	/** Check if one of the two companies declared war on the other */
+	bool IsAtWar(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const;
+
+	/** The hostility of a company toward the target company changed */
+	void SetHostility(const UFlareCompany* Company, const UFlareCompany* TargetCompany, bool Hostile);
+
+
+	/*----------------------------------------------------
+		Lookup index
+	----------------------------------------------------*/
+
+	/** A spacecraft was loaded or created */
+	void RegisterSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	/** A spacecraft was destroyed, it is now found in the destroyed index */
+	void RegisterDestroyedSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
+
+	void RegisterFleet(UFlareFleet* Fleet);
+
+	void UnregisterFleet(UFlareFleet* Fleet);
+
+	void RegisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
+	void UnregisterTradeRoute(UFlareTradeRoute* TradeRoute);
+
 protected:
 
 	/*----------------------------------------------------
@@ -200,8 +265,47 @@ protected:
 
 	AFlareGame*                             Game;
 
+	/** Daily simulation timings */
+	FFlareSimulationProfiler                SimulationProfiler;
+
+	/** Identifier indices, kept up to date by the companies */
+	TMap<FName, UFlareCompany*>             CompanyIndex;
+	TMap<FName, UFlareSimulatedSector*>     SectorIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> SpacecraftIndex;
+	TMap<FName, UFlareSimulatedSpacecraft*> DestroyedSpacecraftIndex;
+	TMap<FName, UFlareFleet*>               FleetIndex;
+	TMap<FName, UFlareTradeRoute*>          TradeRouteIndex;
+
+	/** Travel durations in days between world sectors, by origin then destination index */
+	TArray<int64>                           TravelDurations;
+	TArray<int64>                           FastTravelDurations;
+
+	/** Declared hostility and war state between companies, by company then target company index */
+	TBitArray<>                             HostilityMatrix;
+	TBitArray<>                             WarMatrix;
+
+	/** Resource stats, without and with storage stations */
+	FFlareResourceStatsSnapshot             ResourceStatsSnapshots[2];
+
 	bool WorldMoneyReferenceInit;
 
+	FFlareResourceStatsSnapshot& UpdateResourceStats(bool IncludeStorage);
+
+	/** Fill the travel duration matrices from the sector orbits */
+	void ComputeTravelDurations();
+
+	/** Fill the diplomacy matrices from the company hostility lists */
+	void ComputeHostilityMatrix();
+
+	/** Index of a company pair in the diplomacy matrices, INDEX_NONE if a company is not in them */
+	int32 GetCompanyPairIndex(const UFlareCompany* Company, const UFlareCompany* TargetCompany) const;
+
+	/** Compute cached world state before the parallel company AI planning */
+	void PrepareCompanyAIPlanning();
+
+	/** Random stream of a sector for a simulation phase. It only depends on the date, so that sectors can be simulated in any order */
+	FRandomStream GetSectorRandomStream(UFlareSimulatedSector* Sector, EFlareSimulationPhase::Type Phase) const;
+
 public:
 	int64 WorldMoneyReference;
 
@@ -245,13 +349,19 @@ public:
 		return WorldData.Date;
 	}
 
+	inline FFlareSimulationProfiler& GetSimulationProfiler()
+	{
+		return SimulationProfiler;
+	}
+
 	UFlareCompany* FindCompany(FName Identifier) const;
 
 	UFlareCompany* FindCompanyByShortName(FName CompanyShortName) const;
 
 	UFlareSimulatedSector* FindSector(FName Identifier) const;
 
-	UFlareSimulatedSector* FindSectorBySpacecraft(FName SpacecraftIdentifier) const;
+	/** Find the sector a spacecraft is in, NULL if it is traveling */
+	UFlareSimulatedSector* FindSectorBySpacecraft(FName ShipImmatriculation) const;
 
 	UFlareFleet* FindFleet(FName Identifier) const;
 
@@ -259,6 +369,11 @@ public:
 
 	UFlareSimulatedSpacecraft* FindSpacecraft(FName ShipImmatriculation);
 
+	/** Find a spacecraft that is not destroyed. Complex elements are not indexed */
+	UFlareSimulatedSpacecraft* FindAliveSpacecraft(FName ShipImmatriculation) const;
+
+	UFlareSimulatedSpacecraft* FindDestroyedSpacecraft(FName ShipImmatriculation) const;
+
 	inline const TArray<UFlareCompany*>& GetCompanies() const
 	{
 		return Companies;
@@ -15,17 +15,30 @@
 DECLARE_CYCLE_STAT(TEXT("WorldHelper ComputeWorldResourceStats"), STAT_WorldHelper_ComputeWorldResourceStats, STATGROUP_Flare);
 
 
-TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage)
+TArray<WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage)
+{
+	TMap<UFlareSimulatedSector*, TArray<WorldHelper::FlareResourceStats>> SectorStats;
+
+	for (int SectorIndex = 0; SectorIndex < Game->GetGameWorld()->GetSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Game->GetGameWorld()->GetSectors()[SectorIndex];
+		SectorStats.Add(Sector, SectorHelper::ComputeSectorResourceStats(Sector, IncludeStorage));
+	}
+
+	return ComputeWorldResourceStats(Game, SectorStats);
+}
+
+TArray<WorldHelper::FlareResourceStats> WorldHelper::ComputeWorldResourceStats(AFlareGame* Game, const TMap<UFlareSimulatedSector*, TArray<FlareResourceStats>>& SectorStats)
 {
 	SCOPE_CYCLE_COUNTER(STAT_WorldHelper_ComputeWorldResourceStats);
 
 
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
 
 	// Init
+	WorldStats.Reserve(Game->GetResourceCatalog()->Resources.Num());
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
 		WorldHelper::FlareResourceStats ResourceStats;
 		ResourceStats.Production = 0;
 		ResourceStats.Consumption = 0;
@@ -33,31 +46,29 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::C
 		ResourceStats.Stock = 0;
 		ResourceStats.Capacity = 0;
 
-		WorldStats.Add(Resource, ResourceStats);
+		WorldStats.Add(ResourceStats);
 	}
 
+	// Sum in sector order so that the result does not depend on which sectors were updated
 	for (int SectorIndex = 0; SectorIndex < Game->GetGameWorld()->GetSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Game->GetGameWorld()->GetSectors()[SectorIndex];
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> SectorStats;
-
-		SectorStats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeStorage);
-
+		const TArray<WorldHelper::FlareResourceStats>* Stats = SectorStats.Find(Sector);
+		if (!Stats)
+		{
+			continue;
+		}
 
 		for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
-			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-
-			WorldHelper::FlareResourceStats& SectorResourceStats = SectorStats[Resource];
-			WorldHelper::FlareResourceStats& ResourceStats = WorldStats[Resource];
+			const WorldHelper::FlareResourceStats& SectorResourceStats = (*Stats)[ResourceIndex];
+			WorldHelper::FlareResourceStats& ResourceStats = WorldStats[ResourceIndex];
 			ResourceStats.Production += SectorResourceStats.Production;
 			ResourceStats.Consumption += SectorResourceStats.Consumption;
 			ResourceStats.Balance += SectorResourceStats.Balance;
 			ResourceStats.Stock += SectorResourceStats.Stock;
 			ResourceStats.Capacity += SectorResourceStats.Capacity;
-
-			WorldStats.Add(Resource, ResourceStats);
 		}
 	}
 
@@ -66,7 +77,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::C
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource];
+		WorldHelper::FlareResourceStats *ResourceStats = &WorldStats[Resource->CatalogIndex];
 
 		ResourceStats->Balance = ResourceStats->Production - ResourceStats->Consumption;
 
@@ -1,6 +1,10 @@
 #pragma once
 #include "../Economy/FlareResource.h"
-#include "FlareWorld.h"
+
+
+class AFlareGame;
+class UFlareSimulatedSector;
+
 
 struct WorldHelper
 {
@@ -13,7 +17,10 @@ struct WorldHelper
 		int32 Capacity;
 	};
 
-	static TMap<FFlareResourceDescription*, FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage);
+	static TArray<FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game, bool IncludeStorage);
+
+	/** Sum per-sector stats into world stats */
+	static TArray<FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game, const TMap<UFlareSimulatedSector*, TArray<FlareResourceStats>>& SectorStats);
 
 
 private:
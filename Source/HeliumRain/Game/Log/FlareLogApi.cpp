@@ -227,6 +227,12 @@ void CombatLog::BombDestroyed(FName BombIdentifier)
 
 void CombatLog::SpacecraftDamaged(UFlareSimulatedSpacecraft* Spacecraft, float Energy, float Radius, FVector RelativeLocation, EFlareDamage::Type DamageType, UFlareCompany* DamageSource, FString DamageCauser)
 {
+	// Fired for each hit, skip the formatting when nothing is logged
+	if (!FFlareLogWriter::IsWriterActive())
+	{
+		return;
+	}
+
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SPACECRAFT_DAMAGED;
@@ -285,6 +291,12 @@ void CombatLog::SpacecraftDamaged(UFlareSimulatedSpacecraft* Spacecraft, float E
 
 void CombatLog::SpacecraftComponentDamaged(UFlareSimulatedSpacecraft* Spacecraft, FFlareSpacecraftComponentSave* ComponentData, FFlareSpacecraftComponentDescription* ComponentDescription, float Energy, float EffectiveEnergy, EFlareDamage::Type DamageType, float InitialDamageRatio, float TerminalDamageRatio)
 {
+	// Fired for each hit, skip the formatting when nothing is logged
+	if (!FFlareLogWriter::IsWriterActive())
+	{
+		return;
+	}
+
 	FlareLogMessage Message;
 	Message.Target = EFlareLogTarget::Combat;
 	Message.Event = EFlareLogEvent::SPACECRAFT_COMPONENT_DAMAGED;
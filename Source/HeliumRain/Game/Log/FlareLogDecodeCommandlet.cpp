@@ -0,0 +1,45 @@
+#include "FlareLogDecodeCommandlet.h"
+#include "../../Flare.h"
+#include "FlareLogReader.h"
+
+
+UFlareLogDecodeCommandlet::UFlareLogDecodeCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlareLogDecodeCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Files;
+	TArray<FString> Switches;
+	ParseCommandLine(*Params, Files, Switches);
+
+	bool Csv = Switches.Contains(TEXT("csv"));
+	int32 Errors = 0;
+
+	for (const FString& File : Files)
+	{
+		FString Output;
+		if (!FFlareLogReader::DecodeFile(File, Csv, Output))
+		{
+			Errors++;
+			continue;
+		}
+
+		FString OutputFile = FPaths::ChangeExtension(File, Csv ? TEXT("csv") : TEXT("log"));
+		if (FFileHelper::SaveStringToFile(Output, *OutputFile))
+		{
+			FLOGV("UFlareLogDecodeCommandlet::Main : decoded '%s' to '%s'", *File, *OutputFile);
+		}
+		else
+		{
+			FLOGV("UFlareLogDecodeCommandlet::Main : fail to write '%s'", *OutputFile);
+			Errors++;
+		}
+	}
+
+	return Errors;
+}
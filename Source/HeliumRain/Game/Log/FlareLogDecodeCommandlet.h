@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlareLogDecodeCommandlet.generated.h"
+
+
+/** Offline decoder for binary logs :
+ *  HeliumRain -run=FlareLogDecode <log files> [-csv]
+ *  Each file is decoded next to itself, as .log or .csv
+ */
+UCLASS()
+class UFlareLogDecodeCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+
+};
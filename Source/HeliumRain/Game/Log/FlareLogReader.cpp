@@ -0,0 +1,158 @@
+#include "FlareLogReader.h"
+#include "../../Flare.h"
+#include "../Save/FlareSaveWriter.h"
+
+
+bool FFlareLogReader::DecodeFile(const FString& Filename, bool Csv, FString& Output)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent))
+	{
+		FLOGV("FFlareLogReader::DecodeFile : fail to read '%s'", *Filename);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	if (FileData.Num() >= FlareLogBinary::HeaderSize)
+	{
+		FMemory::Memcpy(&Magic, FileData.GetData(), sizeof(Magic));
+		FMemory::Memcpy(&Version, FileData.GetData() + sizeof(Magic), sizeof(Version));
+	}
+
+	if (Magic != FlareLogBinary::Magic || Version > FlareLogBinary::FormatVersion)
+	{
+		FLOGV("FFlareLogReader::DecodeFile : '%s' is not a binary log", *Filename);
+		return false;
+	}
+
+	if (Csv)
+	{
+		Output += TEXT("date,event,params\n");
+	}
+
+	int32 Offset = FlareLogBinary::HeaderSize;
+	while (Offset + (int32) sizeof(uint16) <= FileData.Num())
+	{
+		uint16 RecordSize;
+		FMemory::Memcpy(&RecordSize, FileData.GetData() + Offset, sizeof(RecordSize));
+		Offset += sizeof(RecordSize);
+
+		if (Offset + RecordSize > FileData.Num())
+		{
+			FLOGV("FFlareLogReader::DecodeFile : '%s' ends with a truncated record", *Filename);
+			break;
+		}
+
+		if (!DecodeRecord(FileData.GetData() + Offset, RecordSize, Csv, Output))
+		{
+			FLOGV("FFlareLogReader::DecodeFile : invalid record at offset %d in '%s'", Offset, *Filename);
+			return false;
+		}
+
+		Offset += RecordSize;
+	}
+
+	return true;
+}
+
+bool FFlareLogReader::DecodeRecord(const uint8* Data, int32 Size, bool Csv, FString& Output)
+{
+	int32 Offset = 0;
+	auto Read = [&](void* Value, int32 ValueSize)
+	{
+		if (Offset + ValueSize > Size)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Value, Data + Offset, ValueSize);
+		Offset += ValueSize;
+		return true;
+	};
+
+	int64 Ticks;
+	uint8 Event;
+	uint8 ParamCount;
+	if (!Read(&Ticks, sizeof(Ticks)) || !Read(&Event, sizeof(Event)) || !Read(&ParamCount, sizeof(ParamCount)))
+	{
+		return false;
+	}
+
+	Output += FString::Printf(Csv ? TEXT("%s,%s") : TEXT("%s %s"),
+		*FDateTime(Ticks).ToString(TEXT("%Y-%m-%dT%H:%M:%S.%s")),
+		*UFlareSaveWriter::FormatEnum<EFlareLogEvent::Type>("EFlareLogEvent", (EFlareLogEvent::Type) Event));
+
+	for (int32 ParamIndex = 0; ParamIndex < ParamCount; ParamIndex++)
+	{
+		uint8 Type;
+		if (!Read(&Type, sizeof(Type)))
+		{
+			return false;
+		}
+
+		switch (Type)
+		{
+			case EFlareLogParam::String:
+			{
+				uint16 Length;
+				if (!Read(&Length, sizeof(Length)) || Offset + Length > Size)
+				{
+					return false;
+				}
+
+				FUTF8ToTCHAR Utf8Value(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+				FString Value(Utf8Value.Length(), Utf8Value.Get());
+				Offset += Length;
+
+				if (Csv)
+				{
+					Value.ReplaceInline(TEXT("\""), TEXT("\"\""));
+				}
+				Output += ",\"" + Value + "\"";
+			}
+			break;
+
+			case EFlareLogParam::Integer:
+			{
+				int64 Value;
+				if (!Read(&Value, sizeof(Value)))
+				{
+					return false;
+				}
+				Output += "," + UFlareSaveWriter::FormatInt64(Value);
+			}
+			break;
+
+			case EFlareLogParam::Float:
+			{
+				double Value;
+				if (!Read(&Value, sizeof(Value)))
+				{
+					return false;
+				}
+				Output += FString::Printf(TEXT(",%f"), Value);
+			}
+			break;
+
+			case EFlareLogParam::Vector3:
+			{
+				FVector Value;
+				if (!Read(&Value.X, sizeof(float)) || !Read(&Value.Y, sizeof(float)) || !Read(&Value.Z, sizeof(float)))
+				{
+					return false;
+				}
+
+				// Keep vectors in one CSV column
+				FString Format = Csv ? TEXT(",\"%s\"") : TEXT(",(%s)");
+				Output += FString::Printf(*Format, *UFlareSaveWriter::FormatVector(Value));
+			}
+			break;
+
+			default:
+				return false;
+		}
+	}
+
+	Output += "\n";
+	return true;
+}
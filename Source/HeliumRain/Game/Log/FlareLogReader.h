@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../../Flare.h"
+#include "FlareLogWriter.h"
+
+
+/** Decoder for the binary game and combat logs */
+class HELIUMRAIN_API FFlareLogReader
+{
+public:
+
+	/** Decode a binary log to text lines or CSV rows. A truncated last record is ignored. */
+	static bool DecodeFile(const FString& Filename, bool Csv, FString& Output);
+
+protected:
+
+	/** Decode one record, return false if it's invalid */
+	static bool DecodeRecord(const uint8* Data, int32 Size, bool Csv, FString& Output);
+
+};
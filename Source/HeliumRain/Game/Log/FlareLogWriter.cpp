@@ -2,7 +2,6 @@
 #include "FlareLogWriter.h"
 #include "../../Flare.h"
 #include "FlareLogApi.h"
-#include "../Save/FlareSaveWriter.h"
 
 //***********************************************************
 //Thread Worker Starts as NULL, prior to being instanced
@@ -12,15 +11,113 @@ FFlareLogWriter* FFlareLogWriter::Runnable = NULL;
 
 static int ThreadIndex = 0;
 
+/** Wait at most this long before writing queued messages */
+static const uint32 FlushInterval = 100;
+
+
+/*----------------------------------------------------
+	Ring buffer
+----------------------------------------------------*/
+
+FFlareLogRingBuffer::FFlareLogRingBuffer()
+	: EnqueuePosition(0)
+	, DequeuePosition(0)
+{
+	static_assert((SlotCount & (SlotCount - 1)) == 0, "Slot count must be a power of two");
+
+	Slots = new FSlot[SlotCount];
+	for (int32 SlotIndex = 0; SlotIndex < SlotCount; SlotIndex++)
+	{
+		Slots[SlotIndex].Sequence = SlotIndex;
+		Slots[SlotIndex].Size = 0;
+	}
+}
+
+FFlareLogRingBuffer::~FFlareLogRingBuffer()
+{
+	delete[] Slots;
+}
+
+bool FFlareLogRingBuffer::Push(const uint8* Data, int32 Size)
+{
+	FCHECK(Size <= SlotSize);
+
+	// Reserve a slot
+	int64 Position = FPlatformAtomics::AtomicRead(&EnqueuePosition);
+	FSlot* Slot;
+	while (true)
+	{
+		Slot = &Slots[Position & (SlotCount - 1)];
+		int64 Sequence = FPlatformAtomics::AtomicRead(&Slot->Sequence);
+		int64 Difference = Sequence - Position;
+
+		if (Difference == 0)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&EnqueuePosition, Position + 1, Position) == Position)
+			{
+				break;
+			}
+		}
+		else if (Difference < 0)
+		{
+			// Full
+			return false;
+		}
+
+		Position = FPlatformAtomics::AtomicRead(&EnqueuePosition);
+	}
+
+	// Fill and publish it
+	FMemory::Memcpy(Slot->Data, Data, Size);
+	Slot->Size = Size;
+	FPlatformMisc::MemoryBarrier();
+	FPlatformAtomics::InterlockedExchange(&Slot->Sequence, Position + 1);
+
+	return true;
+}
+
+bool FFlareLogRingBuffer::Pop(TArray<uint8>& Out)
+{
+	FSlot* Slot = &Slots[DequeuePosition & (SlotCount - 1)];
+	if (FPlatformAtomics::AtomicRead(&Slot->Sequence) != DequeuePosition + 1)
+	{
+		return false;
+	}
+
+	FPlatformMisc::MemoryBarrier();
+	Out.Append(Slot->Data, Slot->Size);
+	FPlatformAtomics::InterlockedExchange(&Slot->Sequence, DequeuePosition + SlotCount);
+	DequeuePosition++;
+
+	return true;
+}
+
+int32 FFlareLogRingBuffer::GetCount() const
+{
+	return FPlatformAtomics::AtomicRead(&EnqueuePosition) - FPlatformAtomics::AtomicRead(&DequeuePosition);
+}
+
+
+/*----------------------------------------------------
+	Writer
+----------------------------------------------------*/
+
 FFlareLogWriter::FFlareLogWriter(FName UUID)
 	: StopTaskCounter(0),
+	  NewMessageEvent(NULL),
 	  GameUUID(UUID)
 
 {
 	FString Name = TEXT("FFlareLogWriter-") + FString::FromInt(ThreadIndex);
 
-	GameLogFile = NULL;
-	CombatLogFile = NULL;
+	LogFiles[EFlareLogTarget::Game].BaseName = TEXT("Game");
+	LogFiles[EFlareLogTarget::Combat].BaseName = TEXT("Combat");
+	for (FFlareLogFile& LogFile : LogFiles)
+	{
+		LogFile.Handle = NULL;
+		LogFile.Size = 0;
+		LogFile.Index = 0;
+	}
 
 	Thread = FRunnableThread::Create(this, *Name, 0, TPri_BelowNormal); //windows default = 8mb for thread, could specify more
 	ThreadIndex++;
@@ -53,20 +150,14 @@ uint32 FFlareLogWriter::Run()
 	// Open log files
 	InitLogFiles();
 
-
-	//While not told to stop this thread
-	//		and not yet finished finding Prime Numbers
+	// Messages are written in batches, when the queue fills up or after some time
 	while (StopTaskCounter.GetValue() == 0)
 	{
-		NewMessageEvent->Wait();
-
-		FlareLogMessage Message;
-		while (MessageQueue.Dequeue(Message))
-		{
-			WriteMessage(Message);
-		}
+		NewMessageEvent->Wait(FlushInterval);
+		FlushMessages();
 	}
 
+	FlushMessages();
 	CloseLogFiles();
 
 	return 0;
@@ -108,128 +199,262 @@ void FFlareLogWriter::Shutdown()
 	{
 		GameLog::GameUnloaded();
 		Runnable->EnsureCompletion();
+
+		if (Runnable->TotalDroppedMessages.GetValue() > 0)
+		{
+			FLOGV("FFlareLogWriter::Shutdown : %d log messages dropped", Runnable->TotalDroppedMessages.GetValue());
+		}
+
 		delete Runnable;
 		Runnable = NULL;
 	}
 }
 
-void FFlareLogWriter::InitLogFiles()
+int32 FFlareLogWriter::GetDroppedMessageCount()
 {
-	if(!GameLogFile)
-	{
-		GameLogFile = InitLogFile("Game");
-	}
+	return Runnable ? Runnable->TotalDroppedMessages.GetValue() : 0;
+}
 
-	if(!CombatLogFile)
+void FFlareLogWriter::InitLogFiles()
+{
+	for (FFlareLogFile& LogFile : LogFiles)
 	{
-		CombatLogFile = InitLogFile("Combat");
+		if (!LogFile.Handle)
+		{
+			// Continue the last rotated file. Rotation deletes the first files, so look for the highest index left
+			LogFile.Index = 0;
+			FString Prefix = FString::Printf(TEXT("%s-%s-"), *LogFile.BaseName, *GameUUID.ToString());
+			TArray<FString> ExistingFiles;
+			IFileManager::Get().FindFiles(ExistingFiles, *FString::Printf(TEXT("%s/SaveGames/%s*.hrlog"), *FPaths::ProjectSavedDir(), *Prefix), true, false);
+
+			for (const FString& ExistingFile : ExistingFiles)
+			{
+				FString IndexString = FPaths::GetBaseFilename(ExistingFile).Mid(Prefix.Len());
+				if (IndexString.Len() > 0 && IndexString.IsNumeric())
+				{
+					LogFile.Index = FMath::Max(LogFile.Index, FCString::Atoi(*IndexString));
+				}
+			}
+
+			OpenLogFile(LogFile);
+		}
 	}
 }
 
 void FFlareLogWriter::CloseLogFiles()
 {
-	if (GameLogFile)
-	{
-		delete GameLogFile;
-		GameLogFile = NULL;
-	}
-
-	if (CombatLogFile)
+	for (FFlareLogFile& LogFile : LogFiles)
 	{
-		delete CombatLogFile;
-		CombatLogFile = NULL;
+		if (LogFile.Handle)
+		{
+			delete LogFile.Handle;
+			LogFile.Handle = NULL;
+		}
 	}
 }
 
-IFileHandle* FFlareLogWriter::InitLogFile(FString BaseName)
+void FFlareLogWriter::OpenLogFile(FFlareLogFile& LogFile)
 {
-	FString FileName = FString::Printf(TEXT("%s/SaveGames/%s-%s.log"), *FPaths::ProjectSavedDir(), *BaseName, *GameUUID.ToString());
+	FString FileName = GetLogFileName(LogFile.BaseName, LogFile.Index);
 
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
 	FLOGV("Init log file '%s'", *FileName);
-	IFileHandle* FileHandle = PlatformFile.OpenWrite(*FileName, true);
+	int64 ExistingSize = PlatformFile.FileSize(*FileName);
+	LogFile.Handle = PlatformFile.OpenWrite(*FileName, true);
+	LogFile.Size = 0;
 
-	if (!FileHandle)
+	if (!LogFile.Handle)
 	{
-		FLOGV("Fail to init log file '%s' for base name '%s'", *FileName, *BaseName);
+		FLOGV("Fail to init log file '%s' for base name '%s'", *FileName, *LogFile.BaseName);
+		return;
 	}
 
-	return FileHandle;
+	// Appending to an existing file, keep counting from its size for the rotation
+	LogFile.Size = FMath::Max<int64>(ExistingSize, 0);
+
+	// New file
+	if (LogFile.Size == 0)
+	{
+		uint8 Header[FlareLogBinary::HeaderSize];
+		uint32 Magic = FlareLogBinary::Magic;
+		uint16 Version = FlareLogBinary::FormatVersion;
+		uint8 Target = (&LogFile - LogFiles);
+		FMemory::Memcpy(Header, &Magic, sizeof(Magic));
+		FMemory::Memcpy(Header + sizeof(Magic), &Version, sizeof(Version));
+		Header[sizeof(Magic) + sizeof(Version)] = Target;
+
+		LogFile.Handle->Write(Header, FlareLogBinary::HeaderSize);
+		LogFile.Size = FlareLogBinary::HeaderSize;
+	}
 }
 
-void FFlareLogWriter::WriteLine(IFileHandle* FileHandle, FString& Line)
+FString FFlareLogWriter::GetLogFileName(const FString& BaseName, int32 Index) const
 {
-	FileHandle->Write((const uint8*)TCHAR_TO_ANSI(*Line), Line.Len());
+	return FString::Printf(TEXT("%s/SaveGames/%s-%s-%03d.hrlog"), *FPaths::ProjectSavedDir(), *BaseName, *GameUUID.ToString(), Index);
 }
 
-void FFlareLogWriter::WriteMessage(FlareLogMessage& Message)
+void FFlareLogWriter::FlushMessages()
 {
-	FString MessageString = FormatMessage(Message);
+	TArray<uint8> Record;
+	while (MessageQueue.Pop(Record))
+	{
+		AppendRecord(Record.GetData(), Record.Num());
+		Record.Reset();
+	}
 
-	switch (Message.Target) {
-	case EFlareLogTarget::Game:
-		if (GameLogFile)
-		{
-			WriteLine(GameLogFile, MessageString);
-		}
-	break;
-	case EFlareLogTarget::Combat:
-		if (CombatLogFile)
+	for (int32 Target = 0; Target <= EFlareLogTarget::Combat; Target++)
+	{
+		// Report dropped messages in their log
+		int32 Dropped = DroppedMessages[Target].Set(0);
+		if (Dropped > 0)
 		{
-			WriteLine(CombatLogFile, MessageString);
+			FlareLogMessage Message;
+			Message.Date = FDateTime::UtcNow();
+			Message.Target = (EFlareLogTarget::Type) Target;
+			Message.Event = EFlareLogEvent::LOG_MESSAGES_DROPPED;
+
+			FlareLogMessageParam Param;
+			Param.Type = EFlareLogParam::Integer;
+			Param.IntValue = Dropped;
+			Message.Params.Add(Param);
+
+			uint8 DropRecord[FFlareLogRingBuffer::SlotSize];
+			AppendRecord(DropRecord, EncodeMessage(Message, DropRecord, FFlareLogRingBuffer::SlotSize));
 		}
-		break;
 
-	default:
-		break;
+		WriteBuffer(LogFiles[Target]);
 	}
 }
 
-FString FFlareLogWriter::FormatMessage(FlareLogMessage& Message)
+void FFlareLogWriter::AppendRecord(const uint8* Record, int32 Size)
 {
+	// The target follows the date, it selects the file and isn't written
+	uint8 Target = Record[sizeof(int64)];
+	if (Target > EFlareLogTarget::Combat)
+	{
+		return;
+	}
+
+	TArray<uint8>& Buffer = LogFiles[Target].Buffer;
+	uint16 RecordSize = Size - 1;
+	Buffer.Append(reinterpret_cast<const uint8*>(&RecordSize), sizeof(RecordSize));
+	Buffer.Append(Record, sizeof(int64));
+	Buffer.Append(Record + sizeof(int64) + 1, RecordSize - sizeof(int64));
+}
+
+void FFlareLogWriter::WriteBuffer(FFlareLogFile& LogFile)
+{
+	if (LogFile.Buffer.Num() == 0)
+	{
+		return;
+	}
+
+	// Rotate
+	if (LogFile.Handle && LogFile.Size > FlareLogBinary::HeaderSize && LogFile.Size + LogFile.Buffer.Num() > FlareLogBinary::MaxFileSize)
+	{
+		delete LogFile.Handle;
+		LogFile.Handle = NULL;
+		LogFile.Index++;
 
-	FString MessageString = FString::Printf(
-				TEXT("%s %s"),
-				*Message.Date.ToString(TEXT("%Y-%m-%dT%H:%M:%S.%s")),
-				*UFlareSaveWriter::FormatEnum<EFlareLogEvent::Type>("EFlareLogEvent", Message.Event));
+		if (LogFile.Index >= FlareLogBinary::MaxFileCount)
+		{
+			IFileManager::Get().Delete(*GetLogFileName(LogFile.BaseName, LogFile.Index - FlareLogBinary::MaxFileCount), false, false, true);
+		}
+
+		OpenLogFile(LogFile);
+	}
 
-	for(int32 ParamIndex = 0; ParamIndex < Message.Params.Num(); ParamIndex++)
+	if (LogFile.Handle)
 	{
-		MessageString += "," + FormatParam(&Message.Params[ParamIndex]);
+		LogFile.Handle->Write(LogFile.Buffer.GetData(), LogFile.Buffer.Num());
+		LogFile.Size += LogFile.Buffer.Num();
 	}
 
-	MessageString += "\n";
-	return MessageString;
+	LogFile.Buffer.Reset();
 }
 
-FString FFlareLogWriter::FormatParam(FlareLogMessageParam* Param)
+int32 FFlareLogWriter::EncodeMessage(const FlareLogMessage& Message, uint8* Record, int32 MaxSize)
 {
-	switch (Param->Type) {
-	case EFlareLogParam::String:
-		return "\""+Param->StringValue+"\"";
-		break;
-	case EFlareLogParam::Integer:
-		return UFlareSaveWriter::FormatInt64(Param->IntValue);
-		break;
-	case EFlareLogParam::Float:
-		return  FString::Printf(TEXT("%f"), Param->FloatValue);
-		break;
-	case EFlareLogParam::Vector3:
-		return "("+UFlareSaveWriter::FormatVector(Param->Vector3Value)+")";
-		break;
-	default:
-		FLOGV("Invalid log param type %d", (Param->Type + 0));
-		break;
+	int32 Size = 0;
+	auto Write = [&](const void* Data, int32 DataSize)
+	{
+		FMemory::Memcpy(Record + Size, Data, DataSize);
+		Size += DataSize;
+	};
+
+	// Header
+	int64 Ticks = Message.Date.GetTicks();
+	uint8 Target = Message.Target;
+	uint8 Event = Message.Event;
+	uint8 ParamCount = 0;
+	Write(&Ticks, sizeof(Ticks));
+	Write(&Target, sizeof(Target));
+	Write(&Event, sizeof(Event));
+	int32 ParamCountOffset = Size;
+	Write(&ParamCount, sizeof(ParamCount));
+
+	// Params, as long as they fit
+	for (const FlareLogMessageParam& Param : Message.Params)
+	{
+		uint8 Type = Param.Type;
+		int32 Remaining = MaxSize - Size - (int32) sizeof(Type);
+
+		if (Param.Type == EFlareLogParam::String && Remaining >= (int32) sizeof(uint16))
+		{
+			FTCHARToUTF8 Utf8Value(*Param.StringValue);
+			uint16 Length = FMath::Min<int32>(Utf8Value.Length(), Remaining - (int32) sizeof(uint16));
+			Write(&Type, sizeof(Type));
+			Write(&Length, sizeof(Length));
+			Write(Utf8Value.Get(), Length);
+		}
+		else if (Param.Type == EFlareLogParam::Integer && Remaining >= (int32) sizeof(int64))
+		{
+			Write(&Type, sizeof(Type));
+			Write(&Param.IntValue, sizeof(int64));
+		}
+		else if (Param.Type == EFlareLogParam::Float && Remaining >= (int32) sizeof(double))
+		{
+			Write(&Type, sizeof(Type));
+			Write(&Param.FloatValue, sizeof(double));
+		}
+		else if (Param.Type == EFlareLogParam::Vector3 && Remaining >= (int32) (3 * sizeof(float)))
+		{
+			Write(&Type, sizeof(Type));
+			Write(&Param.Vector3Value.X, sizeof(float));
+			Write(&Param.Vector3Value.Y, sizeof(float));
+			Write(&Param.Vector3Value.Z, sizeof(float));
+		}
+		else
+		{
+			break;
+		}
+
+		ParamCount++;
 	}
-	return "";
+
+	Record[ParamCountOffset] = ParamCount;
+	return Size;
 }
 
 void FFlareLogWriter::PushMessage(FlareLogMessage& Message)
 {
 	Message.Date = FDateTime::UtcNow();
-	MessageQueue.Enqueue(Message);
-	NewMessageEvent->Trigger();
+
+	uint8 Record[FFlareLogRingBuffer::SlotSize];
+	int32 RecordSize = EncodeMessage(Message, Record, FFlareLogRingBuffer::SlotSize);
+
+	if (!MessageQueue.Push(Record, RecordSize))
+	{
+		DroppedMessages[Message.Target].Increment();
+		TotalDroppedMessages.Increment();
+	}
+
+	// Wake up the writer early when the queue fills up
+	if (NewMessageEvent && MessageQueue.GetCount() > FFlareLogRingBuffer::SlotCount / 4)
+	{
+		NewMessageEvent->Trigger();
+	}
 }
 
 void FFlareLogWriter::PushWriterMessage(FlareLogMessage& Message)
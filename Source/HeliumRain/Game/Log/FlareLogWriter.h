@@ -33,7 +33,10 @@ namespace EFlareLogEvent
 		BOMB_DESTROYED,
 		SPACECRAFT_DAMAGED,
 		SPACECRAFT_COMPONENT_DAMAGED,
-		SPACECRAFT_HARPOONED
+		SPACECRAFT_HARPOONED,
+
+		// Writer event
+		LOG_MESSAGES_DROPPED
 	};
 }
 
@@ -68,6 +71,61 @@ struct FlareLogMessage
 };
 
 
+/** Binary log file layout :
+ *  - header : magic, format version, target
+ *  - records : size, date ticks, event, param count, then for each param its type and value
+ *    Strings are stored as UTF-8 with their size, vectors as three floats.
+ */
+namespace FlareLogBinary
+{
+	static const uint32 Magic = 0x474C5248; // "HRLG"
+	static const uint16 FormatVersion = 1;
+	static const int32 HeaderSize = sizeof(uint32) + sizeof(uint16) + sizeof(uint8);
+
+	/** Rotate a log file when it gets bigger than this */
+	static const int64 MaxFileSize = 16 * 1024 * 1024;
+
+	/** Rotated files kept for each log */
+	static const int32 MaxFileCount = 8;
+}
+
+
+/** Bounded lock-free queue of encoded log records. Many producers, one consumer. */
+class FFlareLogRingBuffer
+{
+public:
+
+	static const int32 SlotCount = 4096;
+	static const int32 SlotSize = 248;
+
+	FFlareLogRingBuffer();
+
+	~FFlareLogRingBuffer();
+
+	/** Copy a record to the queue, return false if the queue is full */
+	bool Push(const uint8* Data, int32 Size);
+
+	/** Append the oldest record to Out, return false if the queue is empty. Consumer thread only. */
+	bool Pop(TArray<uint8>& Out);
+
+	/** Records waiting in the queue */
+	int32 GetCount() const;
+
+private:
+
+	struct FSlot
+	{
+		volatile int64 Sequence;
+		int32 Size;
+		uint8 Data[SlotSize];
+	};
+
+	FSlot*                  Slots;
+	volatile int64          EnqueuePosition;
+	volatile int64          DequeuePosition;
+};
+
+
 //~~~~~ Multi Threading ~~~
 class FFlareLogWriter : public FRunnable
 {
@@ -81,26 +139,41 @@ class FFlareLogWriter : public FRunnable
 	FThreadSafeCounter StopTaskCounter;
 
 
+	/** Rotating log file of a target */
+	struct FFlareLogFile
+	{
+		FString				BaseName;
+		IFileHandle*		Handle;
+		int64				Size;
+		int32				Index;
+		TArray<uint8>		Buffer;
+	};
+
 	void InitLogFiles();
 
 	void CloseLogFiles();
 
-	IFileHandle* InitLogFile(FString BaseName);
+	void OpenLogFile(FFlareLogFile& LogFile);
+
+	FString GetLogFileName(const FString& BaseName, int32 Index) const;
 
-	void WriteLine(IFileHandle* FileHandle, FString& Line);
+	/** Move all queued records to the file buffers, then write each buffer at once */
+	void FlushMessages();
 
-	void WriteMessage(FlareLogMessage& Message);
+	/** Add an encoded record to the buffer of its target */
+	void AppendRecord(const uint8* Record, int32 Size);
 
-	FString FormatMessage(FlareLogMessage& Message);
+	void WriteBuffer(FFlareLogFile& LogFile);
 
-	FString FormatParam(FlareLogMessageParam* Param);
+	/** Encode a message as a binary record, strings are truncated to fit in a queue slot */
+	static int32 EncodeMessage(const FlareLogMessage& Message, uint8* Record, int32 MaxSize);
 
 private:
-	int32					PrimesFoundCount;
 	FEvent*					NewMessageEvent;
-	TQueue<FlareLogMessage>	MessageQueue;
-	IFileHandle*			GameLogFile;
-	IFileHandle*			CombatLogFile;
+	FFlareLogRingBuffer		MessageQueue;
+	FThreadSafeCounter		DroppedMessages[EFlareLogTarget::Combat + 1];
+	FThreadSafeCounter		TotalDroppedMessages;
+	FFlareLogFile			LogFiles[EFlareLogTarget::Combat + 1];
 	FName					GameUUID;
 
 public:
@@ -137,6 +210,15 @@ public:
 	static FFlareLogWriter* InitWriter(FName UUID);
 	static void PushWriterMessage(FlareLogMessage& Message);
 
+	/** A writer is running, messages can be skipped otherwise */
+	static bool IsWriterActive()
+	{
+		return Runnable != NULL;
+	}
+
+	/** Messages dropped because the queue was full */
+	static int32 GetDroppedMessageCount();
+
 	/** Shuts down the thread. Static so it can easily be called from outside the thread context */
 	static void Shutdown();
 
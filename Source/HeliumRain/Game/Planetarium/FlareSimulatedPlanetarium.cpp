@@ -88,12 +88,31 @@ void UFlareSimulatedPlanetarium::Load()
 		Nema.Sattelites.Add(Adena);
 	}
 	Sun.Sattelites.Add(Nema);
+
+	// Sattelites are copied into their parent, index them once the tree is final
+	BodyIndex.Empty();
+	ParentIndex.Empty();
+	IndexCelestialBody(&Sun, NULL);
+}
+
+void UFlareSimulatedPlanetarium::IndexCelestialBody(FFlareCelestialBody* Body, FFlareCelestialBody* Parent)
+{
+	if (!BodyIndex.Contains(Body->Identifier))
+	{
+		BodyIndex.Add(Body->Identifier, Body);
+	}
+	ParentIndex.Add(Body, Parent);
+
+	for (int SatteliteIndex = 0; SatteliteIndex < Body->Sattelites.Num(); SatteliteIndex++)
+	{
+		IndexCelestialBody(&Body->Sattelites[SatteliteIndex], Body);
+	}
 }
 
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FName BodyIdentifier)
 {
-	return FindCelestialBody(&Sun, BodyIdentifier);
+	return BodyIndex.FindRef(BodyIdentifier);
 }
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FFlareCelestialBody* Body, FName BodyIdentifier)
@@ -118,12 +137,7 @@ FFlareCelestialBody* UFlareSimulatedPlanetarium::FindCelestialBody(FFlareCelesti
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindParent(FFlareCelestialBody* Body)
 {
-	if (&Sun == Body)
-	{
-		return NULL;
-	}
-
-	return FindParent(Body, &Sun);
+	return ParentIndex.FindRef(Body);
 }
 
 FFlareCelestialBody* UFlareSimulatedPlanetarium::FindParent(FFlareCelestialBody* Body, FFlareCelestialBody* Root)
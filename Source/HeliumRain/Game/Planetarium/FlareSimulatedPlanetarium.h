@@ -241,13 +241,13 @@ public:
 	/** Get relative location of a body orbiting around its parent */
 	virtual FPreciseVector GetRelativeLocation(FFlareCelestialBody* ParentBody, int64 Time, float SmoothTime, double OrbitDistance, double Mass, double InitialPhase);
 
-	/** Return the celestial body with the given identifier */
+	/** Return the celestial body with the given identifier, from the body index */
 	FFlareCelestialBody* FindCelestialBody(FName BodyIdentifier);
 
 	/** Return the celestial body with the given identifier in the given body tree */
 	FFlareCelestialBody* FindCelestialBody(FFlareCelestialBody* Body, FName BodyIdentifier);
 
-	/** Return the parent of the given celestial body */
+	/** Return the parent of the given celestial body, from the body index */
 	FFlareCelestialBody* FindParent(FFlareCelestialBody* Body);
 
 	/** Return the parent of the given celestial body in the given root tree*/
@@ -262,6 +262,9 @@ protected:
 
 	void ComputeCelestialBodyLocation(FFlareCelestialBody* ParentBody, FFlareCelestialBody* Body, int64 time, float SmoothTime);
 
+	/** Add a body and its sattelites to the body index */
+	void IndexCelestialBody(FFlareCelestialBody* Body, FFlareCelestialBody* Parent);
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
@@ -270,6 +273,10 @@ protected:
 
 	FFlareCelestialBody           Sun;
 
+	/** Bodies by identifier and parents by body, built once the body tree is complete */
+	TMap<FName, FFlareCelestialBody*>                  BodyIndex;
+	TMap<FFlareCelestialBody*, FFlareCelestialBody*>   ParentIndex;
+
 public:
 
 	/*----------------------------------------------------
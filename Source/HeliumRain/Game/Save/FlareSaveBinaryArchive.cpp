@@ -0,0 +1,256 @@
+#include "FlareSaveBinaryArchive.h"
+
+#include "HAL/PlatformFilemanager.h"
+
+
+/*----------------------------------------------------
+	Writer
+----------------------------------------------------*/
+
+FFlareSaveBinaryWriter::FFlareSaveBinaryWriter(const FString& InFilename, int32 FormatVersion, uint32 Magic)
+	: Filename(InFilename)
+	, TempFilename(InFilename + TEXT(".tmp"))
+	, UncompressedSize(0)
+{
+	ArIsSaving = true;
+	ArIsPersistent = true;
+
+	// Write to a temporary file so that an interrupted save never replaces a valid one
+	FileWriter = IFileManager::Get().CreateFileWriter(*TempFilename);
+	if (!FileWriter)
+	{
+		FLOGV("FFlareSaveBinaryWriter : fail to open '%s'", *TempFilename);
+		ArIsError = true;
+		return;
+	}
+
+	// Size is patched on close
+	int64 Placeholder = 0;
+	*FileWriter << Magic;
+	*FileWriter << FormatVersion;
+	*FileWriter << Placeholder;
+
+	Chunk.Reserve(FlareSaveBinary::ChunkSize);
+}
+
+FFlareSaveBinaryWriter::~FFlareSaveBinaryWriter()
+{
+	if (FileWriter)
+	{
+		delete FileWriter;
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+	}
+}
+
+bool FFlareSaveBinaryWriter::Close()
+{
+	if (!FileWriter)
+	{
+		return false;
+	}
+
+	FlushChunk();
+
+	// End marker
+	int32 EndMarker = 0;
+	*FileWriter << EndMarker;
+	*FileWriter << EndMarker;
+
+	FileWriter->Seek(sizeof(uint32) + sizeof(int32));
+	*FileWriter << UncompressedSize;
+
+	bool Success = FileWriter->Close() && !FileWriter->IsError() && !IsError();
+	delete FileWriter;
+	FileWriter = NULL;
+
+	if (Success)
+	{
+		Success = IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+	}
+
+	if (!Success)
+	{
+		FLOGV("FFlareSaveBinaryWriter : fail to write '%s'", *Filename);
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+	}
+
+	return Success;
+}
+
+void FFlareSaveBinaryWriter::Serialize(void* Data, int64 Num)
+{
+	if (!FileWriter || IsError())
+	{
+		return;
+	}
+
+	const uint8* Source = static_cast<const uint8*>(Data);
+	UncompressedSize += Num;
+
+	while (Num > 0)
+	{
+		int64 CopySize = FMath::Min<int64>(Num, FlareSaveBinary::ChunkSize - Chunk.Num());
+		Chunk.Append(Source, CopySize);
+		Source += CopySize;
+		Num -= CopySize;
+
+		if (Chunk.Num() >= FlareSaveBinary::ChunkSize)
+		{
+			FlushChunk();
+		}
+	}
+}
+
+void FFlareSaveBinaryWriter::FlushChunk()
+{
+	if (Chunk.Num() == 0 || IsError())
+	{
+		return;
+	}
+
+	int32 ChunkUncompressedSize = Chunk.Num();
+	int32 ChunkCompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, ChunkUncompressedSize);
+	CompressedChunk.SetNumUninitialized(ChunkCompressedSize, false);
+
+	if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedChunk.GetData(), ChunkCompressedSize, Chunk.GetData(), ChunkUncompressedSize))
+	{
+		FLOGV("FFlareSaveBinaryWriter : fail to compress chunk of %d bytes for '%s'", ChunkUncompressedSize, *Filename);
+		ArIsError = true;
+		return;
+	}
+
+	*FileWriter << ChunkUncompressedSize;
+	*FileWriter << ChunkCompressedSize;
+	FileWriter->Serialize(CompressedChunk.GetData(), ChunkCompressedSize);
+
+	Chunk.Reset();
+}
+
+
+/*----------------------------------------------------
+	Reader
+----------------------------------------------------*/
+
+FFlareSaveBinaryReader::FFlareSaveBinaryReader(const uint8* InData, int64 InSize, uint32 ExpectedMagic)
+	: Data(InData)
+	, Size(InSize)
+	, ReadOffset(FlareSaveBinary::HeaderSize)
+	, ChunkStart(0)
+	, ChunkOffset(0)
+	, ValidSave(false)
+	, FormatVersion(0)
+	, UncompressedSize(0)
+{
+	ArIsLoading = true;
+	ArIsPersistent = true;
+
+	if (!Data || Size < FlareSaveBinary::HeaderSize)
+	{
+		ArIsError = true;
+		return;
+	}
+
+	uint32 Magic;
+	FMemory::Memcpy(&Magic, Data, sizeof(uint32));
+	FMemory::Memcpy(&FormatVersion, Data + sizeof(uint32), sizeof(int32));
+	FMemory::Memcpy(&UncompressedSize, Data + sizeof(uint32) + sizeof(int32), sizeof(int64));
+
+	ValidSave = (Magic == ExpectedMagic && UncompressedSize > 0);
+	if (!ValidSave)
+	{
+		ArIsError = true;
+	}
+}
+
+void FFlareSaveBinaryReader::Serialize(void* Dest, int64 Num)
+{
+	uint8* Target = static_cast<uint8*>(Dest);
+
+	while (Num > 0)
+	{
+		if (IsError() || (ChunkOffset >= Chunk.Num() && !ReadChunk()))
+		{
+			// Truncated or corrupted save
+			ArIsError = true;
+			FMemory::Memzero(Target, Num);
+			return;
+		}
+
+		int64 CopySize = FMath::Min<int64>(Num, Chunk.Num() - ChunkOffset);
+		FMemory::Memcpy(Target, Chunk.GetData() + ChunkOffset, CopySize);
+		ChunkOffset += CopySize;
+		Target += CopySize;
+		Num -= CopySize;
+	}
+}
+
+bool FFlareSaveBinaryReader::ReadChunk()
+{
+	if (ReadOffset + FlareSaveBinary::ChunkHeaderSize > Size)
+	{
+		return false;
+	}
+
+	int32 ChunkUncompressedSize;
+	int32 ChunkCompressedSize;
+	FMemory::Memcpy(&ChunkUncompressedSize, Data + ReadOffset, sizeof(int32));
+	FMemory::Memcpy(&ChunkCompressedSize, Data + ReadOffset + sizeof(int32), sizeof(int32));
+	ReadOffset += FlareSaveBinary::ChunkHeaderSize;
+
+	if (ChunkUncompressedSize <= 0 || ChunkUncompressedSize > FlareSaveBinary::ChunkSize
+		|| ChunkCompressedSize <= 0 || ReadOffset + ChunkCompressedSize > Size)
+	{
+		return false;
+	}
+
+	ChunkStart += Chunk.Num();
+	ChunkOffset = 0;
+	Chunk.SetNumUninitialized(ChunkUncompressedSize, false);
+
+	if (!FCompression::UncompressMemory(COMPRESS_ZLIB, Chunk.GetData(), ChunkUncompressedSize, Data + ReadOffset, ChunkCompressedSize))
+	{
+		FLOGV("FFlareSaveBinaryReader : fail to uncompress chunk at offset %lld", ReadOffset);
+		Chunk.Reset();
+		return false;
+	}
+
+	ReadOffset += ChunkCompressedSize;
+	return true;
+}
+
+
+/*----------------------------------------------------
+	File
+----------------------------------------------------*/
+
+FFlareSaveBinaryFile::FFlareSaveBinaryFile()
+	: Data(NULL)
+	, Size(0)
+{
+}
+
+bool FFlareSaveBinaryFile::Open(const FString& Filename)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+
+	if (MappedFile.IsValid())
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = MappedRegion->GetMappedPtr();
+		Size = MappedRegion->GetMappedSize();
+		return true;
+	}
+	else if (FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent))
+	{
+		Data = FileData.GetData();
+		Size = FileData.Num();
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../../Flare.h"
+
+
+/** Binary save file layout :
+ *  - header : magic, format version, total uncompressed size
+ *  - chunks : uncompressed size, compressed size, zlib data
+ *  - a last empty chunk
+ */
+namespace FlareSaveBinary
+{
+	static const uint32 Magic = 0x42535248; // "HRSB"
+	static const uint32 JournalMagic = 0x4A535248; // "HRSJ"
+	static const int32 HeaderSize = sizeof(uint32) + sizeof(int32) + sizeof(int64);
+	static const int32 ChunkHeaderSize = 2 * sizeof(int32);
+	static const int32 ChunkSize = 1024 * 1024;
+}
+
+
+/** Streaming writer : data is compressed chunk by chunk to a temporary file, the full save is never held in memory.
+ *  The temporary file replaces the target on close. */
+class HELIUMRAIN_API FFlareSaveBinaryWriter : public FArchive
+{
+public:
+
+	FFlareSaveBinaryWriter(const FString& InFilename, int32 FormatVersion, uint32 Magic = FlareSaveBinary::Magic);
+
+	virtual ~FFlareSaveBinaryWriter();
+
+	/** Flush the last chunk, close the file and move it in place, return false if anything failed */
+	bool Close();
+
+	virtual void Serialize(void* Data, int64 Num) override;
+
+	virtual int64 Tell() override
+	{
+		return UncompressedSize;
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return Filename;
+	}
+
+protected:
+
+	void FlushChunk();
+
+	FString                                    Filename;
+	FString                                    TempFilename;
+	FArchive*                                  FileWriter;
+	TArray<uint8>                              Chunk;
+	TArray<uint8>                              CompressedChunk;
+	int64                                      UncompressedSize;
+};
+
+
+/** Reader over a mapped save file : chunks are decompressed one at a time as the structs are decoded */
+class HELIUMRAIN_API FFlareSaveBinaryReader : public FArchive
+{
+public:
+
+	/** Data must stay mapped while the reader is used */
+	FFlareSaveBinaryReader(const uint8* InData, int64 InSize, uint32 ExpectedMagic = FlareSaveBinary::Magic);
+
+	/** Header was valid */
+	bool IsValidSave() const
+	{
+		return ValidSave;
+	}
+
+	int32 GetFormatVersion() const
+	{
+		return FormatVersion;
+	}
+
+	virtual void Serialize(void* Data, int64 Num) override;
+
+	virtual int64 Tell() override
+	{
+		return ChunkStart + ChunkOffset;
+	}
+
+	virtual int64 TotalSize() override
+	{
+		return UncompressedSize;
+	}
+
+protected:
+
+	bool ReadChunk();
+
+	const uint8*                               Data;
+	int64                                      Size;
+	int64                                      ReadOffset;
+
+	TArray<uint8>                              Chunk;
+	int64                                      ChunkStart;
+	int32                                      ChunkOffset;
+
+	bool                                       ValidSave;
+	int32                                      FormatVersion;
+	int64                                      UncompressedSize;
+};
+
+
+/** Save file content, mapped when the platform allows it, else read to memory */
+class HELIUMRAIN_API FFlareSaveBinaryFile
+{
+public:
+
+	FFlareSaveBinaryFile();
+
+	/** Return false if the file can't be read */
+	bool Open(const FString& Filename);
+
+	const uint8* GetData() const
+	{
+		return Data;
+	}
+
+	int64 GetSize() const
+	{
+		return Size;
+	}
+
+protected:
+
+	TUniquePtr<IMappedFileHandle>              MappedFile;
+	TUniquePtr<IMappedFileRegion>              MappedRegion;
+	TArray<uint8>                              FileData;
+
+	const uint8*                               Data;
+	int64                                      Size;
+};
@@ -0,0 +1,918 @@
+#include "FlareSaveBinarySerializer.h"
+#include "../../Flare.h"
+
+#include "FlareSaveBinaryArchive.h"
+#include "FlareSaveWriter.h"
+
+#include "../FlareSaveGame.h"
+
+
+/** Spacecraft lists of a company, journaled as separate records */
+static TArray<FFlareSpacecraftSave> FFlareCompanySave::* const SpacecraftLists[] =
+{
+	&FFlareCompanySave::ShipData,
+	&FFlareCompanySave::ChildStationData,
+	&FFlareCompanySave::StationData,
+	&FFlareCompanySave::DestroyedSpacecraftData
+};
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+UFlareSaveBinarySerializer::UFlareSaveBinarySerializer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, LoadedFormatVersion(FormatVersion)
+{
+}
+
+bool UFlareSaveBinarySerializer::SaveGame(UFlareSaveGame* Data, const FString& Filename, FFlareSaveBinaryBase* Base)
+{
+	FFlareSaveBinaryWriter Writer(Filename, FormatVersion);
+	if (Writer.IsError())
+	{
+		return false;
+	}
+
+	FGuid SaveId = FGuid::NewGuid();
+	Writer << SaveId;
+	SerializeGame(Writer, Data);
+
+	if (!Writer.Close())
+	{
+		return false;
+	}
+
+	if (Base)
+	{
+		*Base = FFlareSaveBinaryBase();
+		Base->SaveId = SaveId;
+		Base->SaveRevision = Data->SaveRevision;
+		ComputeBase(Data, *Base);
+	}
+
+	return true;
+}
+
+bool UFlareSaveBinarySerializer::SaveJournal(UFlareSaveGame* Data, const FString& Filename, const FFlareSaveBinaryBase& Base, int32& ChangedRecords, int32& TotalRecords)
+{
+	ChangedRecords = 0;
+	TotalRecords = 0;
+
+	FFlareSaveBinaryWriter Writer(Filename, FormatVersion, FlareSaveBinary::JournalMagic);
+	if (Writer.IsError())
+	{
+		return false;
+	}
+
+	FGuid BaseId = Base.SaveId;
+	Writer << BaseId;
+
+	// Small data is always written
+	SerializeGameHeader(Writer, Data);
+	Writer << Data->WorldData.Date;
+	SerializeArray(Writer, Data->WorldData.TravelData, &UFlareSaveBinarySerializer::SerializeTravel);
+
+	// Companies and sectors change every day, spacecrafts are only written if they changed since the base
+	int32 CompanyCount = Data->WorldData.CompanyData.Num();
+	Writer << CompanyCount;
+	for (FFlareCompanySave& Company : Data->WorldData.CompanyData)
+	{
+		FFlareCompanySave Lists;
+		SwapSpacecraftLists(Company, Lists);
+		WriteJournalRecord(Writer, Company.Identifier, Company, &UFlareSaveBinarySerializer::SerializeCompany, true, ChangedRecords);
+		SwapSpacecraftLists(Company, Lists);
+		TotalRecords++;
+
+		for (TArray<FFlareSpacecraftSave> FFlareCompanySave::* List : SpacecraftLists)
+		{
+			int32 SpacecraftCount = (Company.*List).Num();
+			Writer << SpacecraftCount;
+			for (FFlareSpacecraftSave& Spacecraft : Company.*List)
+			{
+				bool Changed = (Spacecraft.SaveRevision > Base.SaveRevision || !Base.SpacecraftKeys.Contains(Spacecraft.Immatriculation));
+				WriteJournalRecord(Writer, Spacecraft.Immatriculation, Spacecraft, &UFlareSaveBinarySerializer::SerializeSpacecraft, Changed, ChangedRecords);
+				TotalRecords++;
+			}
+		}
+	}
+
+	// Sectors
+	int32 SectorCount = Data->WorldData.SectorData.Num();
+	Writer << SectorCount;
+	for (FFlareSectorSave& Sector : Data->WorldData.SectorData)
+	{
+		WriteJournalRecord(Writer, Sector.Identifier, Sector, &UFlareSaveBinarySerializer::SerializeSector, true, ChangedRecords);
+		TotalRecords++;
+	}
+
+	return Writer.Close();
+}
+
+UFlareSaveGame* UFlareSaveBinarySerializer::LoadGame(const FString& Filename, const FString& JournalFilename)
+{
+	FFlareSaveBinaryFile File;
+	if (!File.Open(Filename))
+	{
+		return NULL;
+	}
+
+	FFlareSaveBinaryReader Reader(File.GetData(), File.GetSize());
+	if (!Reader.IsValidSave())
+	{
+		FLOGV("UFlareSaveBinarySerializer::LoadGame : '%s' is not a binary save", *Filename);
+		return NULL;
+	}
+
+	if (Reader.GetFormatVersion() > FormatVersion)
+	{
+		FLOGV("WARNING: Invalid save version. Save format is '%d' ('%d' excepted)", Reader.GetFormatVersion(), FormatVersion);
+		return NULL;
+	}
+	LoadedFormatVersion = Reader.GetFormatVersion();
+
+	// Saves before version 2 have no identifier and no journal
+	FGuid SaveId;
+	if (Reader.GetFormatVersion() >= 2)
+	{
+		Reader << SaveId;
+	}
+
+	UFlareSaveGame* SaveGame = NewObject<UFlareSaveGame>(this, UFlareSaveGame::StaticClass());
+	SerializeGame(Reader, SaveGame);
+
+	if (Reader.IsError())
+	{
+		FLOGV("WARNING: Fail to decode save '%s'. Save corrupted", *Filename);
+		return NULL;
+	}
+
+	// Apply the journal written since this save
+	FFlareSaveBinaryFile JournalFile;
+	if (SaveId.IsValid() && JournalFilename.Len() && JournalFile.Open(JournalFilename))
+	{
+		FFlareSaveBinaryReader JournalReader(JournalFile.GetData(), JournalFile.GetSize(), FlareSaveBinary::JournalMagic);
+		FGuid BaseId;
+		if (JournalReader.IsValidSave() && JournalReader.GetFormatVersion() == Reader.GetFormatVersion())
+		{
+			JournalReader << BaseId;
+		}
+
+		if (BaseId != SaveId)
+		{
+			FLOGV("UFlareSaveBinarySerializer::LoadGame : journal '%s' was not written for this save, ignored", *JournalFilename);
+		}
+		else if (!ApplyJournal(JournalReader, SaveGame))
+		{
+			// The save was partially replaced, decode it again without the journal
+			FLOGV("ERROR: Fail to apply journal '%s'. Journal corrupted, loading the last full save", *JournalFilename);
+			SaveGame = LoadGame(Filename, FString());
+			if (SaveGame)
+			{
+				SaveGame->JournalFailed = true;
+			}
+		}
+	}
+
+	return SaveGame;
+}
+
+
+/*----------------------------------------------------
+	Serializers
+----------------------------------------------------*/
+
+void UFlareSaveBinarySerializer::SerializeGame(FArchive& Ar, UFlareSaveGame* Data)
+{
+	SerializeGameHeader(Ar, Data);
+	SerializeWorld(Ar, Data->WorldData);
+}
+
+void UFlareSaveBinarySerializer::SerializeGameHeader(FArchive& Ar, UFlareSaveGame* Data)
+{
+	Ar << Data->AutoSave;
+
+	SerializePlayer(Ar, Data->PlayerData);
+	SerializeCompanyDescription(Ar, Data->PlayerCompanyDescription);
+	Ar << Data->CurrentImmatriculationIndex;
+	Ar << Data->CurrentIdentifierIndex;
+}
+
+void UFlareSaveBinarySerializer::SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data)
+{
+	SerializeName(Ar, Data.UUID);
+	Ar << Data.ScenarioId;
+	Ar << Data.PlayerEmblemIndex;
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeName(Ar, Data.PlayerFleetIdentifier);
+	SerializeName(Ar, Data.LastFlownShipIdentifier);
+	SerializeQuest(Ar, Data.QuestData);
+	SerializeNameArray(Ar, Data.UnlockedScannables);
+}
+
+void UFlareSaveBinarySerializer::SerializeQuest(FArchive& Ar, FFlareQuestSave& Data)
+{
+	SerializeName(Ar, Data.SelectedQuest);
+	Ar << Data.PlayTutorial;
+	Ar << Data.NextGeneratedQuestIndex;
+
+	SerializeArray(Ar, Data.QuestProgresses, &UFlareSaveBinarySerializer::SerializeQuestProgress);
+	SerializeNameArray(Ar, Data.SuccessfulQuests);
+	SerializeNameArray(Ar, Data.AbandonedQuests);
+	SerializeNameArray(Ar, Data.FailedQuests);
+	SerializeArray(Ar, Data.GeneratedQuests, &UFlareSaveBinarySerializer::SerializeGeneratedQuest);
+}
+
+void UFlareSaveBinarySerializer::SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data)
+{
+	SerializeName(Ar, Data.QuestIdentifier);
+	SerializeEnum(Ar, Data.Status);
+	Ar << Data.AvailableDate;
+	Ar << Data.AcceptationDate;
+	SerializeBundle(Ar, Data.Data);
+
+	SerializeNameArray(Ar, Data.SuccessfullSteps);
+	SerializeArray(Ar, Data.CurrentStepProgress, &UFlareSaveBinarySerializer::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.TriggerConditionsSave, &UFlareSaveBinarySerializer::SerializeQuestStepProgress);
+	SerializeArray(Ar, Data.ExpirationConditionsSave, &UFlareSaveBinarySerializer::SerializeQuestStepProgress);
+}
+
+void UFlareSaveBinarySerializer::SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data)
+{
+	SerializeName(Ar, Data.QuestClass);
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinarySerializer::SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data)
+{
+	SerializeName(Ar, Data.ConditionIdentifier);
+	SerializeBundle(Ar, Data.Data);
+}
+
+void UFlareSaveBinarySerializer::SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.ShortName);
+	SerializeText(Ar, Data.Description);
+
+	Ar << Data.CustomizationBasePaintColor;
+	Ar << Data.CustomizationPaintColor;
+	Ar << Data.CustomizationOverlayColor;
+	Ar << Data.CustomizationLightColor;
+	Ar << Data.CustomizationPatternIndex;
+}
+
+void UFlareSaveBinarySerializer::SerializeWorld(FArchive& Ar, FFlareWorldSave& Data)
+{
+	Ar << Data.Date;
+
+	SerializeArray(Ar, Data.CompanyData, &UFlareSaveBinarySerializer::SerializeCompany);
+	SerializeArray(Ar, Data.SectorData, &UFlareSaveBinarySerializer::SerializeSector);
+	SerializeArray(Ar, Data.TravelData, &UFlareSaveBinarySerializer::SerializeTravel);
+}
+
+
+void UFlareSaveBinarySerializer::SerializeCompany(FArchive& Ar, FFlareCompanySave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.CatalogIdentifier;
+	Ar << Data.Money;
+	Ar << Data.CompanyValue;
+	Ar << Data.PlayerLastPeaceDate;
+	Ar << Data.PlayerLastWarDate;
+	Ar << Data.PlayerLastTributeDate;
+	Ar << Data.FleetImmatriculationIndex;
+	Ar << Data.TradeRouteImmatriculationIndex;
+	Ar << Data.ResearchAmount;
+	Ar << Data.ResearchSpent;
+	SerializeCompanyAI(Ar, Data.AI);
+	SerializeFloat(Ar, Data.ResearchRatio);
+	SerializeFloat(Ar, Data.Retaliation);
+
+	SerializeNameArray(Ar, Data.UnlockedTechnologies);
+	SerializeNameArray(Ar, Data.CaptureOrders);
+	SerializeNameArray(Ar, Data.HostileCompanies);
+
+	SerializeArray(Ar, Data.ShipData, &UFlareSaveBinarySerializer::SerializeSpacecraft);
+	SerializeArray(Ar, Data.ChildStationData, &UFlareSaveBinarySerializer::SerializeSpacecraft);
+	SerializeArray(Ar, Data.StationData, &UFlareSaveBinarySerializer::SerializeSpacecraft);
+	SerializeArray(Ar, Data.DestroyedSpacecraftData, &UFlareSaveBinarySerializer::SerializeSpacecraft);
+	SerializeArray(Ar, Data.Fleets, &UFlareSaveBinarySerializer::SerializeFleet);
+	SerializeArray(Ar, Data.TradeRoutes, &UFlareSaveBinarySerializer::SerializeTradeRoute);
+	SerializeArray(Ar, Data.SectorsKnowledge, &UFlareSaveBinarySerializer::SerializeSectorKnowledge);
+
+	SerializeFloat(Ar, Data.PlayerReputation);
+
+	SerializeArray(Ar, Data.TransactionLog, &UFlareSaveBinarySerializer::SerializeTransactionLogEntry);
+
+	// Saves before version 3 have no transaction balances, they are rebuilt from the log
+	if (Ar.IsSaving() || LoadedFormatVersion >= 3)
+	{
+		SerializeArray(Ar, Data.TransactionBalances, &UFlareSaveBinarySerializer::SerializeTransactionLogBalance);
+	}
+}
+
+void UFlareSaveBinarySerializer::SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data)
+{
+	Ar << Data.IsDestroyed;
+	Ar << Data.IsUnderConstruction;
+	SerializeName(Ar, Data.Immatriculation);
+	SerializeText(Ar, Data.NickName);
+	SerializeName(Ar, Data.Identifier);
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeEnum(Ar, Data.SpawnMode);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeName(Ar, Data.DockedTo);
+	Ar << Data.DockedAt;
+	SerializeFloat(Ar, Data.DockedAngle);
+	SerializeFloat(Ar, Data.Heat);
+	SerializeFloat(Ar, Data.PowerOutageDelay);
+	SerializeFloat(Ar, Data.PowerOutageAcculumator);
+	SerializeName(Ar, Data.DynamicComponentStateIdentifier);
+	SerializeFloat(Ar, Data.DynamicComponentStateProgress);
+	Ar << Data.Level;
+	Ar << Data.IsTrading;
+	Ar << Data.IsIntercepted;
+	SerializeFloat(Ar, Data.RefillStock);
+	SerializeFloat(Ar, Data.RepairStock);
+	Ar << Data.IsReserve;
+	Ar << Data.AllowExternalOrder;
+	SerializePilot(Ar, Data.Pilot);
+	SerializeAsteroid(Ar, Data.AsteroidData);
+	SerializeName(Ar, Data.HarpoonCompany);
+	SerializeName(Ar, Data.AttachActorName);
+	SerializeName(Ar, Data.AttachComplexStationName);
+	SerializeName(Ar, Data.AttachComplexConnectorName);
+
+	SerializeArray(Ar, Data.Components, &UFlareSaveBinarySerializer::SerializeSpacecraftComponent);
+	SerializeArray(Ar, Data.ConstructionCargoBay, &UFlareSaveBinarySerializer::SerializeCargo);
+	SerializeArray(Ar, Data.ProductionCargoBay, &UFlareSaveBinarySerializer::SerializeCargo);
+	SerializeArray(Ar, Data.FactoryStates, &UFlareSaveBinarySerializer::SerializeFactory);
+	SerializeArray(Ar, Data.ShipyardOrderQueue, &UFlareSaveBinarySerializer::SerializeShipyardOrder);
+	SerializeNameArray(Ar, Data.SalesExcludedResources);
+	SerializeArray(Ar, Data.ConnectedStations, &UFlareSaveBinarySerializer::SerializeStationConnection);
+
+	SerializeNameMap(Ar, Data.CapturePoints, [](FArchive& ValueAr, int32& Points)
+	{
+		ValueAr << Points;
+	});
+}
+
+void UFlareSaveBinarySerializer::SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinarySerializer::SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeVector(Ar, Data.Scale);
+	Ar << Data.AsteroidMeshID;
+}
+
+void UFlareSaveBinarySerializer::SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data)
+{
+	SerializeVector(Ar, Data.Location);
+	SerializeVector(Ar, Data.TargetOffset);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	Ar << Data.MeteoriteMeshID;
+	Ar << Data.IsMetal;
+	SerializeFloat(Ar, Data.Damage);
+	SerializeFloat(Ar, Data.BrokenDamage);
+	SerializeName(Ar, Data.TargetStation);
+	Ar << Data.HasMissed;
+	Ar << Data.DaysBeforeImpact;
+}
+
+void UFlareSaveBinarySerializer::SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data)
+{
+	SerializeName(Ar, Data.ComponentIdentifier);
+	SerializeName(Ar, Data.ShipSlotIdentifier);
+	SerializeFloat(Ar, Data.Damage);
+	SerializeFloat(Ar, Data.Turret.TurretAngle);
+	SerializeFloat(Ar, Data.Turret.BarrelsAngle);
+	Ar << Data.Weapon.FiredAmmo;
+	SerializeTurretPilot(Ar, Data.Pilot);
+}
+
+void UFlareSaveBinarySerializer::SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.Name;
+}
+
+void UFlareSaveBinarySerializer::SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data)
+{
+	SerializeName(Ar, Data.ConnectorName);
+	SerializeName(Ar, Data.StationIdentifier);
+}
+
+void UFlareSaveBinarySerializer::SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	Ar << Data.MaxQuantity;
+	Ar << Data.InventoryLimit;
+	Ar << Data.MaxWait;
+	SerializeEnum(Ar, Data.Type);
+	Ar << Data.CanTradeWithStorages;
+}
+
+void UFlareSaveBinarySerializer::SerializeCargo(FArchive& Ar, FFlareCargoSave& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	Ar << Data.Quantity;
+	SerializeEnum(Ar, Data.Lock);
+	SerializeEnum(Ar, Data.Restriction);
+}
+
+void UFlareSaveBinarySerializer::SerializeFactory(FArchive& Ar, FFlareFactorySave& Data)
+{
+	Ar << Data.Active;
+	Ar << Data.CostReserved;
+	Ar << Data.ProductedDuration;
+	Ar << Data.InfiniteCycle;
+	Ar << Data.CycleCount;
+	SerializeName(Ar, Data.TargetShipClass);
+	SerializeName(Ar, Data.TargetShipCompany);
+
+	SerializeArray(Ar, Data.ResourceReserved, &UFlareSaveBinarySerializer::SerializeCargo);
+	SerializeArray(Ar, Data.OutputCargoLimit, &UFlareSaveBinarySerializer::SerializeCargo);
+}
+
+void UFlareSaveBinarySerializer::SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data)
+{
+	SerializeName(Ar, Data.Company);
+	SerializeName(Ar, Data.ShipClass);
+	Ar << Data.AdvancePayment;
+}
+
+void UFlareSaveBinarySerializer::SerializeFleet(FArchive& Ar, FFlareFleetSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.Identifier);
+	SerializeNameArray(Ar, Data.ShipImmatriculations);
+	Ar << Data.FleetColor;
+	Ar << Data.AutoTrade;
+
+	Ar << Data.AutoTradeStatsDays;
+	Ar << Data.AutoTradeStatsLoadResources;
+	Ar << Data.AutoTradeStatsUnloadResources;
+	Ar << Data.AutoTradeStatsMoneySell;
+	Ar << Data.AutoTradeStatsMoneyBuy;
+}
+
+void UFlareSaveBinarySerializer::SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data)
+{
+	SerializeText(Ar, Data.Name);
+	SerializeName(Ar, Data.Identifier);
+	SerializeName(Ar, Data.FleetIdentifier);
+	SerializeName(Ar, Data.TargetSectorIdentifier);
+	Ar << Data.CurrentOperationIndex;
+	Ar << Data.CurrentOperationProgress;
+	Ar << Data.CurrentOperationDuration;
+	Ar << Data.IsPaused;
+
+	// Stats
+	Ar << Data.StatsDays;
+	Ar << Data.StatsLoadResources;
+	Ar << Data.StatsUnloadResources;
+	Ar << Data.StatsMoneySell;
+	Ar << Data.StatsMoneyBuy;
+	Ar << Data.StatsOperationSuccessCount;
+	Ar << Data.StatsOperationFailCount;
+
+	SerializeArray(Ar, Data.Sectors, &UFlareSaveBinarySerializer::SerializeTradeRouteSector);
+}
+
+void UFlareSaveBinarySerializer::SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data)
+{
+	SerializeName(Ar, Data.SectorIdentifier);
+	SerializeArray(Ar, Data.Operations, &UFlareSaveBinarySerializer::SerializeTradeOperation);
+}
+
+void UFlareSaveBinarySerializer::SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data)
+{
+	SerializeName(Ar, Data.SectorIdentifier);
+	SerializeEnum(Ar, Data.Knowledge);
+}
+
+void UFlareSaveBinarySerializer::SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data)
+{
+	Ar << Data.Date;
+	Ar << Data.Amount;
+	SerializeEnum(Ar, Data.Type);
+	SerializeName(Ar, Data.Spacecraft);
+	SerializeName(Ar, Data.Sector);
+	SerializeName(Ar, Data.OtherCompany);
+	SerializeName(Ar, Data.OtherSpacecraft);
+	SerializeName(Ar, Data.Resource);
+	Ar << Data.ResourceQuantity;
+	SerializeName(Ar, Data.ExtraIdentifier1);
+	SerializeName(Ar, Data.ExtraIdentifier2);
+}
+
+void UFlareSaveBinarySerializer::SerializeTransactionLogBalance(FArchive& Ar, FFlareTransactionLogBalance& Data)
+{
+	Ar << Data.Date;
+	SerializeEnum(Ar, Data.Type);
+	Ar << Data.Amount;
+}
+
+void UFlareSaveBinarySerializer::SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data)
+{
+	Ar << Data.BudgetMilitary;
+	Ar << Data.BudgetStation;
+	Ar << Data.BudgetTechnology;
+	Ar << Data.BudgetTrade;
+	SerializeFloat(Ar, Data.Caution);
+	SerializeFloat(Ar, Data.Pacifism);
+	SerializeName(Ar, Data.ResearchProject);
+}
+
+void UFlareSaveBinarySerializer::SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data)
+{
+	SerializeName(Ar, Data.CompanyIdentifier);
+	SerializeFloat(Ar, Data.Reputation);
+}
+
+
+void UFlareSaveBinarySerializer::SerializeSector(FArchive& Ar, FFlareSectorSave& Data)
+{
+	SerializeText(Ar, Data.GivenName);
+	SerializeName(Ar, Data.Identifier);
+	Ar << Data.LocalTime;
+	SerializePeople(Ar, Data.PeopleData);
+
+	SerializeArray(Ar, Data.BombData, &UFlareSaveBinarySerializer::SerializeBomb);
+	SerializeArray(Ar, Data.AsteroidData, &UFlareSaveBinarySerializer::SerializeAsteroid);
+	SerializeArray(Ar, Data.MeteoriteData, &UFlareSaveBinarySerializer::SerializeMeteorite);
+	SerializeNameArray(Ar, Data.FleetIdentifiers);
+	SerializeNameArray(Ar, Data.SpacecraftIdentifiers);
+	SerializeArray(Ar, Data.ResourcePrices, &UFlareSaveBinarySerializer::SerializeResourcePrice);
+
+	Ar << Data.IsTravelSector;
+
+	SerializeFloatBuffer(Ar, Data.FleetSupplyConsumptionStats);
+	Ar << Data.DailyFleetSupplyConsumption;
+}
+
+void UFlareSaveBinarySerializer::SerializePeople(FArchive& Ar, FFlarePeopleSave& Data)
+{
+	Ar << Data.Population;
+	Ar << Data.FoodStock;
+	Ar << Data.FuelStock;
+	Ar << Data.ToolStock;
+	Ar << Data.TechStock;
+	SerializeFloat(Ar, Data.FoodConsumption);
+	SerializeFloat(Ar, Data.FuelConsumption);
+	SerializeFloat(Ar, Data.ToolConsumption);
+	SerializeFloat(Ar, Data.TechConsumption);
+	Ar << Data.Money;
+	Ar << Data.Dept;
+	Ar << Data.BirthPoint;
+	Ar << Data.DeathPoint;
+	Ar << Data.HungerPoint;
+	Ar << Data.HappinessPoint;
+
+	SerializeArray(Ar, Data.CompanyReputations, &UFlareSaveBinarySerializer::SerializeCompanyReputation);
+}
+
+void UFlareSaveBinarySerializer::SerializeBomb(FArchive& Ar, FFlareBombSave& Data)
+{
+	SerializeName(Ar, Data.Identifier);
+	SerializeVector(Ar, Data.Location);
+	SerializeRotator(Ar, Data.Rotation);
+	SerializeVector(Ar, Data.LinearVelocity);
+	SerializeVector(Ar, Data.AngularVelocity);
+	SerializeName(Ar, Data.WeaponSlotIdentifier);
+	SerializeName(Ar, Data.AimTargetSpacecraft);
+	SerializeName(Ar, Data.ParentSpacecraft);
+	SerializeName(Ar, Data.AttachTarget);
+	Ar << Data.Activated;
+	Ar << Data.Dropped;
+	Ar << Data.Locked;
+	SerializeFloat(Ar, Data.DropParentDistance);
+	SerializeFloat(Ar, Data.LifeTime);
+	SerializeFloat(Ar, Data.BurnDuration);
+}
+
+void UFlareSaveBinarySerializer::SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data)
+{
+	SerializeName(Ar, Data.ResourceIdentifier);
+	SerializeFloat(Ar, Data.Price);
+	SerializeFloatBuffer(Ar, Data.Prices);
+}
+
+void UFlareSaveBinarySerializer::SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data)
+{
+	Ar << Data.MaxSize;
+	Ar << Data.WriteIndex;
+
+	int32 Count = Data.Values.Num();
+	Ar << Count;
+	if (Ar.IsLoading())
+	{
+		if (!CheckCount(Ar, Count))
+		{
+			return;
+		}
+		Data.Values.SetNumUninitialized(Count);
+	}
+
+	for (float& Value : Data.Values)
+	{
+		Ar << Value;
+	}
+}
+
+void UFlareSaveBinarySerializer::SerializeBundle(FArchive& Ar, FFlareBundle& Data)
+{
+	SerializeNameMap(Ar, Data.FloatValues, [](FArchive& ValueAr, float& Value)
+	{
+		SerializeFloat(ValueAr, Value);
+	});
+
+	SerializeNameMap(Ar, Data.Int32Values, [](FArchive& ValueAr, int32& Value)
+	{
+		ValueAr << Value;
+	});
+
+	SerializeNameMap(Ar, Data.TransformValues, [](FArchive& ValueAr, FTransform& Value)
+	{
+		ValueAr << Value;
+	});
+
+	SerializeNameMap(Ar, Data.VectorArrayValues, [](FArchive& ValueAr, FVectorArray& Value)
+	{
+		int32 Count = Value.Entries.Num();
+		ValueAr << Count;
+		if (ValueAr.IsLoading())
+		{
+			if (!CheckCount(ValueAr, Count))
+			{
+				return;
+			}
+			Value.Entries.SetNum(Count);
+		}
+
+		for (FVector& Vector : Value.Entries)
+		{
+			SerializeVector(ValueAr, Vector);
+		}
+	});
+
+	SerializeNameMap(Ar, Data.NameValues, [](FArchive& ValueAr, FName& Value)
+	{
+		SerializeName(ValueAr, Value);
+	});
+
+	SerializeNameMap(Ar, Data.NameArrayValues, [](FArchive& ValueAr, FNameArray& Value)
+	{
+		SerializeNameArray(ValueAr, Value.Entries);
+	});
+
+	SerializeNameMap(Ar, Data.StringValues, [](FArchive& ValueAr, FString& Value)
+	{
+		ValueAr << Value;
+	});
+
+	SerializeNameArray(Ar, Data.Tags);
+}
+
+void UFlareSaveBinarySerializer::SerializeTravel(FArchive& Ar, FFlareTravelSave& Data)
+{
+	SerializeName(Ar, Data.FleetIdentifier);
+	SerializeName(Ar, Data.OriginSectorIdentifier);
+	SerializeName(Ar, Data.DestinationSectorIdentifier);
+	Ar << Data.DepartureDate;
+
+	SerializeSector(Ar, Data.SectorData);
+}
+
+
+/*----------------------------------------------------
+	Journal
+----------------------------------------------------*/
+
+void UFlareSaveBinarySerializer::ComputeBase(UFlareSaveGame* Data, FFlareSaveBinaryBase& Base)
+{
+	TSet<FName> DuplicateSpacecrafts;
+
+	for (FFlareCompanySave& Company : Data->WorldData.CompanyData)
+	{
+		for (TArray<FFlareSpacecraftSave> FFlareCompanySave::* List : SpacecraftLists)
+		{
+			for (FFlareSpacecraftSave& Spacecraft : Company.*List)
+			{
+				// Keys seen twice are always written, the base record would be ambiguous
+				FName Key = Spacecraft.Immatriculation;
+				if (DuplicateSpacecrafts.Contains(Key))
+				{
+					continue;
+				}
+				else if (Base.SpacecraftKeys.Contains(Key))
+				{
+					Base.SpacecraftKeys.Remove(Key);
+					DuplicateSpacecrafts.Add(Key);
+					continue;
+				}
+
+				Base.SpacecraftKeys.Add(Key);
+			}
+		}
+	}
+}
+
+bool UFlareSaveBinarySerializer::ApplyJournal(FArchive& Ar, UFlareSaveGame* Data)
+{
+	// Take the base records out of the save, the journal gives the new lists
+	TArray<FFlareCompanySave> BaseCompanies = MoveTemp(Data->WorldData.CompanyData);
+	TArray<FFlareSectorSave> BaseSectors = MoveTemp(Data->WorldData.SectorData);
+	TArray<FFlareSpacecraftSave> BaseSpacecrafts;
+	Data->WorldData.CompanyData.Empty();
+	Data->WorldData.SectorData.Empty();
+
+	for (FFlareCompanySave& Company : BaseCompanies)
+	{
+		for (TArray<FFlareSpacecraftSave> FFlareCompanySave::* List : SpacecraftLists)
+		{
+			BaseSpacecrafts.Append(MoveTemp(Company.*List));
+			(Company.*List).Empty();
+		}
+	}
+
+	TMap<FName, FFlareCompanySave*> CompanyRecords;
+	TMap<FName, FFlareSpacecraftSave*> SpacecraftRecords;
+	TMap<FName, FFlareSectorSave*> SectorRecords;
+	IndexRecords(BaseCompanies, &FFlareCompanySave::Identifier, CompanyRecords);
+	IndexRecords(BaseSpacecrafts, &FFlareSpacecraftSave::Immatriculation, SpacecraftRecords);
+	IndexRecords(BaseSectors, &FFlareSectorSave::Identifier, SectorRecords);
+
+	// Small data
+	SerializeGameHeader(Ar, Data);
+	Ar << Data->WorldData.Date;
+	SerializeArray(Ar, Data->WorldData.TravelData, &UFlareSaveBinarySerializer::SerializeTravel);
+
+	// Companies, then their spacecrafts
+	int32 CompanyCount = 0;
+	Ar << CompanyCount;
+	if (!CheckCount(Ar, CompanyCount))
+	{
+		return false;
+	}
+
+	Data->WorldData.CompanyData.SetNum(CompanyCount);
+	for (int32 CompanyIndex = 0; CompanyIndex < CompanyCount && !Ar.IsError(); CompanyIndex++)
+	{
+		FFlareCompanySave& Company = Data->WorldData.CompanyData[CompanyIndex];
+		ReadJournalRecord(Ar, Company, &UFlareSaveBinarySerializer::SerializeCompany, CompanyRecords);
+
+		for (TArray<FFlareSpacecraftSave> FFlareCompanySave::* List : SpacecraftLists)
+		{
+			int32 SpacecraftCount = 0;
+			Ar << SpacecraftCount;
+			if (!CheckCount(Ar, SpacecraftCount))
+			{
+				return false;
+			}
+
+			(Company.*List).SetNum(SpacecraftCount);
+			for (int32 SpacecraftIndex = 0; SpacecraftIndex < SpacecraftCount && !Ar.IsError(); SpacecraftIndex++)
+			{
+				ReadJournalRecord(Ar, (Company.*List)[SpacecraftIndex], &UFlareSaveBinarySerializer::SerializeSpacecraft, SpacecraftRecords);
+			}
+		}
+	}
+
+	// Sectors
+	int32 SectorCount = 0;
+	Ar << SectorCount;
+	if (!CheckCount(Ar, SectorCount))
+	{
+		return false;
+	}
+
+	Data->WorldData.SectorData.SetNum(SectorCount);
+	for (int32 SectorIndex = 0; SectorIndex < SectorCount && !Ar.IsError(); SectorIndex++)
+	{
+		ReadJournalRecord(Ar, Data->WorldData.SectorData[SectorIndex], &UFlareSaveBinarySerializer::SerializeSector, SectorRecords);
+	}
+
+	return !Ar.IsError();
+}
+
+void UFlareSaveBinarySerializer::SwapSpacecraftLists(FFlareCompanySave& A, FFlareCompanySave& B)
+{
+	for (TArray<FFlareSpacecraftSave> FFlareCompanySave::* List : SpacecraftLists)
+	{
+		Swap(A.*List, B.*List);
+	}
+}
+
+
+/*----------------------------------------------------
+	Low-level tools
+----------------------------------------------------*/
+
+void UFlareSaveBinarySerializer::SerializeName(FArchive& Ar, FName& Data)
+{
+	// Names are not stable across runs, store them as strings
+	FString NameString;
+	if (Ar.IsSaving())
+	{
+		NameString = Data.ToString();
+	}
+
+	Ar << NameString;
+
+	if (Ar.IsLoading())
+	{
+		Data = FName(*NameString);
+	}
+}
+
+void UFlareSaveBinarySerializer::SerializeText(FArchive& Ar, FText& Data)
+{
+	// Same as the JSON format, texts are reloaded as plain strings
+	FString TextString;
+	if (Ar.IsSaving())
+	{
+		TextString = Data.ToString();
+	}
+
+	Ar << TextString;
+
+	if (Ar.IsLoading())
+	{
+		Data = FText::FromString(TextString);
+	}
+}
+
+void UFlareSaveBinarySerializer::SerializeFloat(FArchive& Ar, float& Data)
+{
+	if (Ar.IsSaving())
+	{
+		float FixedData = UFlareSaveWriter::FixFloat(Data);
+		Ar << FixedData;
+	}
+	else
+	{
+		Ar << Data;
+	}
+}
+
+void UFlareSaveBinarySerializer::SerializeVector(FArchive& Ar, FVector& Data)
+{
+	SerializeFloat(Ar, Data.X);
+	SerializeFloat(Ar, Data.Y);
+	SerializeFloat(Ar, Data.Z);
+}
+
+void UFlareSaveBinarySerializer::SerializeRotator(FArchive& Ar, FRotator& Data)
+{
+	SerializeFloat(Ar, Data.Pitch);
+	SerializeFloat(Ar, Data.Yaw);
+	SerializeFloat(Ar, Data.Roll);
+}
+
+void UFlareSaveBinarySerializer::SerializeNameArray(FArchive& Ar, TArray<FName>& Data)
+{
+	int32 Count = Data.Num();
+	Ar << Count;
+
+	if (Ar.IsLoading())
+	{
+		if (!CheckCount(Ar, Count))
+		{
+			return;
+		}
+		Data.SetNum(Count);
+	}
+
+	for (FName& Name : Data)
+	{
+		SerializeName(Ar, Name);
+	}
+}
+
+bool UFlareSaveBinarySerializer::CheckCount(FArchive& Ar, int32 Count)
+{
+	if (Ar.IsError() || Count < 0 || Count > Ar.TotalSize())
+	{
+		FLOGV("WARNING: Invalid element count %d at offset %lld. Save corrupted", Count, Ar.Tell());
+		Ar.ArIsError = true;
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "Object.h"
+#include "../FlareSaveGame.h"
+#include "FlareSaveBinarySerializer.generated.h"
+
+
+class UFlareSaveGame;
+struct FFlareTradeRouteSectorOperationSave;
+struct FFlareFloatBuffer;
+
+
+/** Identity and spacecraft records of the last full save, journals are written against it */
+struct FFlareSaveBinaryBase
+{
+	FGuid                                      SaveId;
+
+	/** Snapshot revision of the full save, spacecrafts changed since have a higher revision */
+	int64                                      SaveRevision;
+
+	/** Spacecrafts in the full save, without duplicate keys */
+	TSet<FName>                                SpacecraftKeys;
+
+	/** Journals written since the full save */
+	int32                                      JournalCount;
+
+	/** The last journal changed too much of the save, the next save should be a full one */
+	bool                                       NeedCompaction;
+
+	FFlareSaveBinaryBase()
+		: SaveRevision(0)
+		, JournalCount(0)
+		, NeedCompaction(false)
+	{}
+};
+
+
+/** Binary save format. Each Serialize function is both the writer and the reader of a save struct, new fields go at the end behind a format version check */
+UCLASS()
+class HELIUMRAIN_API UFlareSaveBinarySerializer: public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/** Stream the save to a compressed binary file. If Base is set, it becomes the base of the next journals */
+	bool SaveGame(UFlareSaveGame* Data, const FString& Filename, FFlareSaveBinaryBase* Base = NULL);
+
+	/** Write a journal holding the companies, the sectors and the spacecrafts that changed since the base save */
+	bool SaveJournal(UFlareSaveGame* Data, const FString& Filename, const FFlareSaveBinaryBase& Base, int32& ChangedRecords, int32& TotalRecords);
+
+	/** Map a binary save and decode it, then apply its journal if it matches. Return NULL if the save is missing or invalid */
+	UFlareSaveGame* LoadGame(const FString& Filename, const FString& JournalFilename);
+
+	/** Current binary format version */
+	static const int32 FormatVersion = 3;
+
+protected:
+
+	/** Format version of the save being read, fields added later are only read from newer saves */
+	int32                                      LoadedFormatVersion;
+
+	/*----------------------------------------------------
+	  Serializers
+	----------------------------------------------------*/
+
+	void SerializeGame(FArchive& Ar, UFlareSaveGame* Data);
+	void SerializeGameHeader(FArchive& Ar, UFlareSaveGame* Data);
+
+	void SerializePlayer(FArchive& Ar, FFlarePlayerSave& Data);
+	void SerializeQuest(FArchive& Ar, FFlareQuestSave& Data);
+	void SerializeQuestProgress(FArchive& Ar, FFlareQuestProgressSave& Data);
+	void SerializeGeneratedQuest(FArchive& Ar, FFlareGeneratedQuestSave& Data);
+	void SerializeQuestStepProgress(FArchive& Ar, FFlareQuestConditionSave& Data);
+
+	void SerializeCompanyDescription(FArchive& Ar, FFlareCompanyDescription& Data);
+	void SerializeWorld(FArchive& Ar, FFlareWorldSave& Data);
+
+
+	void SerializeCompany(FArchive& Ar, FFlareCompanySave& Data);
+
+	void SerializeSpacecraft(FArchive& Ar, FFlareSpacecraftSave& Data);
+	void SerializePilot(FArchive& Ar, FFlareShipPilotSave& Data);
+	void SerializeAsteroid(FArchive& Ar, FFlareAsteroidSave& Data);
+	void SerializeMeteorite(FArchive& Ar, FFlareMeteoriteSave& Data);
+	void SerializeSpacecraftComponent(FArchive& Ar, FFlareSpacecraftComponentSave& Data);
+	void SerializeTurretPilot(FArchive& Ar, FFlareTurretPilotSave& Data);
+	void SerializeStationConnection(FArchive& Ar, FFlareConnectionSave& Data);
+
+	void SerializeTradeOperation(FArchive& Ar, FFlareTradeRouteSectorOperationSave& Data);
+	void SerializeCargo(FArchive& Ar, FFlareCargoSave& Data);
+	void SerializeFactory(FArchive& Ar, FFlareFactorySave& Data);
+	void SerializeShipyardOrder(FArchive& Ar, FFlareShipyardOrderSave& Data);
+
+	void SerializeFleet(FArchive& Ar, FFlareFleetSave& Data);
+	void SerializeTradeRoute(FArchive& Ar, FFlareTradeRouteSave& Data);
+	void SerializeTradeRouteSector(FArchive& Ar, FFlareTradeRouteSectorSave& Data);
+	void SerializeSectorKnowledge(FArchive& Ar, FFlareCompanySectorKnowledge& Data);
+	void SerializeTransactionLogEntry(FArchive& Ar, FFlareTransactionLogEntry& Data);
+	void SerializeTransactionLogBalance(FArchive& Ar, FFlareTransactionLogBalance& Data);
+	void SerializeCompanyAI(FArchive& Ar, FFlareCompanyAISave& Data);
+	void SerializeCompanyReputation(FArchive& Ar, FFlareCompanyReputationSave& Data);
+
+
+	void SerializeSector(FArchive& Ar, FFlareSectorSave& Data);
+	void SerializePeople(FArchive& Ar, FFlarePeopleSave& Data);
+	void SerializeBomb(FArchive& Ar, FFlareBombSave& Data);
+	void SerializeResourcePrice(FArchive& Ar, FFFlareResourcePrice& Data);
+	void SerializeFloatBuffer(FArchive& Ar, FFlareFloatBuffer& Data);
+	void SerializeBundle(FArchive& Ar, FFlareBundle& Data);
+
+	void SerializeTravel(FArchive& Ar, FFlareTravelSave& Data);
+
+
+	/*----------------------------------------------------
+	  Journal
+	----------------------------------------------------*/
+
+	/** List the spacecraft records of a full save */
+	void ComputeBase(UFlareSaveGame* Data, FFlareSaveBinaryBase& Base);
+
+	/** Replace the base records by the journal ones, return false if the journal doesn't apply */
+	bool ApplyJournal(FArchive& Ar, UFlareSaveGame* Data);
+
+	/** Swap the spacecraft lists of two company saves, they are journaled as separate records */
+	static void SwapSpacecraftLists(FFlareCompanySave& A, FFlareCompanySave& B);
+
+	/** Write a record, or only its key if the base holds the same data */
+	template<typename T>
+	void WriteJournalRecord(FArchive& Ar, FName Key, T& Data, void (UFlareSaveBinarySerializer::*SerializeItem)(FArchive&, T&), bool Changed, int32& ChangedRecords)
+	{
+		SerializeName(Ar, Key);
+		Ar << Changed;
+		if (Changed)
+		{
+			(this->*SerializeItem)(Ar, Data);
+			ChangedRecords++;
+		}
+	}
+
+	/** Read a journal record, taking unchanged data from the base records */
+	template<typename T>
+	void ReadJournalRecord(FArchive& Ar, T& Data, void (UFlareSaveBinarySerializer::*SerializeItem)(FArchive&, T&), TMap<FName, T*>& BaseRecords)
+	{
+		FName Key;
+		bool Changed;
+		SerializeName(Ar, Key);
+		Ar << Changed;
+
+		if (Changed)
+		{
+			(this->*SerializeItem)(Ar, Data);
+			return;
+		}
+
+		T* BaseRecord = NULL;
+		if (BaseRecords.RemoveAndCopyValue(Key, BaseRecord) && BaseRecord)
+		{
+			Data = MoveTemp(*BaseRecord);
+		}
+		else
+		{
+			FLOGV("WARNING: Journal record '%s' is missing from the base save", *Key.ToString());
+			Ar.ArIsError = true;
+		}
+	}
+
+	template<typename T>
+	static void IndexRecords(TArray<T>& Records, FName T::* Key, TMap<FName, T*>& Index)
+	{
+		TSet<FName> DuplicateKeys;
+		for (T& Record : Records)
+		{
+			FName RecordKey = Record.*Key;
+			if (DuplicateKeys.Contains(RecordKey))
+			{
+				continue;
+			}
+			else if (Index.Contains(RecordKey))
+			{
+				Index.Remove(RecordKey);
+				DuplicateKeys.Add(RecordKey);
+				continue;
+			}
+			Index.Add(RecordKey, &Record);
+		}
+	}
+
+
+	/*----------------------------------------------------
+	  Low-level tools
+	----------------------------------------------------*/
+
+	static void SerializeName(FArchive& Ar, FName& Data);
+	static void SerializeText(FArchive& Ar, FText& Data);
+	static void SerializeFloat(FArchive& Ar, float& Data);
+	static void SerializeVector(FArchive& Ar, FVector& Data);
+	static void SerializeRotator(FArchive& Ar, FRotator& Data);
+	static void SerializeNameArray(FArchive& Ar, TArray<FName>& Data);
+
+	/** Check a count read from the file before allocating anything */
+	static bool CheckCount(FArchive& Ar, int32 Count);
+
+	template<typename EnumType>
+	static void SerializeEnum(FArchive& Ar, EnumType& Data)
+	{
+		uint8 Value = (uint8)Data;
+		Ar << Value;
+		Data = (EnumType)Value;
+	}
+
+	template<typename T>
+	void SerializeArray(FArchive& Ar, TArray<T>& Data, void (UFlareSaveBinarySerializer::*SerializeItem)(FArchive&, T&))
+	{
+		int32 Count = Data.Num();
+		Ar << Count;
+
+		if (Ar.IsLoading())
+		{
+			if (!CheckCount(Ar, Count))
+			{
+				return;
+			}
+			Data.SetNum(Count);
+		}
+
+		for (int32 i = 0; i < Data.Num() && !Ar.IsError(); i++)
+		{
+			(this->*SerializeItem)(Ar, Data[i]);
+		}
+	}
+
+	template<typename T, typename SerializeValueType>
+	static void SerializeNameMap(FArchive& Ar, TMap<FName, T>& Data, SerializeValueType SerializeValue)
+	{
+		int32 Count = Data.Num();
+		Ar << Count;
+
+		if (Ar.IsLoading())
+		{
+			if (!CheckCount(Ar, Count))
+			{
+				return;
+			}
+
+			Data.Empty(Count);
+			for (int32 i = 0; i < Count && !Ar.IsError(); i++)
+			{
+				FName Key;
+				T Value;
+				SerializeName(Ar, Key);
+				SerializeValue(Ar, Value);
+				Data.Add(Key, Value);
+			}
+		}
+		else
+		{
+			for (auto& Pair : Data)
+			{
+				FName Key = Pair.Key;
+				SerializeName(Ar, Key);
+				SerializeValue(Ar, Pair.Value);
+			}
+		}
+	}
+};
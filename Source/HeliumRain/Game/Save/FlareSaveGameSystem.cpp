@@ -4,6 +4,7 @@
 
 #include "FlareSaveWriter.h"
 #include "FlareSaveReaderV1.h"
+#include "FlareSaveBinarySerializer.h"
 #include "../FlareGame.h"
 
 
@@ -14,6 +15,7 @@
 UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	BinarySerializer = CreateDefaultSubobject<UFlareSaveBinarySerializer>(TEXT("BinarySerializer"));
 }
 
 /*----------------------------------------------------
@@ -23,61 +25,134 @@ UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectIniti
 
 bool UFlareSaveGameSystem::DoesSaveGameExist(const FString SaveName)
 {
-	return IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0 || IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
+	return IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, true)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName, false)) >= 0;
 }
 
-bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData)
+EFlareSaveResult::Type UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData, bool Incremental)
 {
 	bool ret = false;
+
+	// A newer save was queued for this slot, skip this one
+	SaveListLock.Lock();
+	FFlareQueuedSaves* Queued = QueuedSaves.Find(SaveName);
+	bool Superseded = (Queued && Queued->Latest != SaveData);
+	if (Superseded)
+	{
+		ReleaseQueuedSave(SaveName, SaveData);
+	}
+	SaveListLock.Unlock();
+
+	if (Superseded)
+	{
+		FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s : skipped, superseded by a newer save", *SaveName);
+		return EFlareSaveResult::Superseded;
+	}
+
 	SaveLock.Lock();
 	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s", *SaveName);
 
+	// Journal against the last full save
+	FFlareSaveBinaryBase* Base = SaveBases.Find(SaveName);
+	if (Incremental && Base && !Base->NeedCompaction && Base->JournalCount < JournalCompactionCount)
+	{
+		int32 ChangedRecords = 0;
+		int32 TotalRecords = 0;
+		ret = BinarySerializer->SaveJournal(SaveData, GetBinaryJournalPath(SaveName), *Base, ChangedRecords, TotalRecords);
+
+		if (ret)
+		{
+			// Each journal holds all changes since the full save, compact it once it gets too big
+			Base->JournalCount++;
+			Base->NeedCompaction = (ChangedRecords > TotalRecords / 2);
+			FLOGV("UFlareSaveGameSystem::SaveGame : Journal done, %d/%d records changed", ChangedRecords, TotalRecords);
+		}
+	}
+
+	// Full save, also used to compact the journal
+	if (!ret)
+	{
+		FFlareSaveBinaryBase NewBase;
+		ret = BinarySerializer->SaveGame(SaveData, GetBinarySaveGamePath(SaveName), &NewBase);
+
+		if (ret)
+		{
+			// The binary save replaces the journal and the JSON saves
+			IFileManager::Get().Delete(*GetBinaryJournalPath(SaveName), false, false, true);
+			IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), false, false, true);
+			IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), false, false, true);
+			SaveBases.Add(SaveName, NewBase);
+			FLOG("UFlareSaveGameSystem::SaveGame : Save done");
+		}
+		else
+		{
+			FLOGV("Fail to write save %s", *SaveName);
+		}
+	}
+
+	SaveLock.Unlock();
+
+	SaveListLock.Lock();
+	ReleaseQueuedSave(SaveName, SaveData);
+	SaveListLock.Unlock();
+
+	return (ret ? EFlareSaveResult::Saved : EFlareSaveResult::Failed);
+}
+
+bool UFlareSaveGameSystem::ExportGame(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	SaveLock.Lock();
+	FLOGV("UFlareSaveGameSystem::ExportGame SaveName=%s", *SaveName);
+
+	bool ret = SaveGameJson(GetExportPath(SaveName), SaveData, false);
+
+	SaveLock.Unlock();
+	return ret;
+}
+
+bool UFlareSaveGameSystem::SaveGameJson(const FString Filename, UFlareSaveGame* SaveData, bool Compress)
+{
+	bool ret = false;
+
 	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
 	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveGame(SaveData);
 
 	// Save the json object
 	FString FileContents;
-	//TSharedRef< TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> > JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&FileContents);
 	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
 
 	if (FJsonSerializer::Serialize(JsonObject, JsonWriter))
 	{
 		JsonWriter->Close();
 
-		bool Compress = true;
 		if(Compress)
 		{
-			uint32 StrLength = FCStringAnsi::Strlen(TCHAR_TO_UTF8(*FileContents));
+			FTCHARToUTF8 Utf8Contents(*FileContents);
+			int32 StrLength = Utf8Contents.Length();
 
 			uint8* CompressedDataRaw = new uint8[StrLength];
 			int32 CompressedSize = StrLength;
 
-			const bool bResult = FCompression::CompressMemory((ECompressionFlags)(COMPRESS_GZIP), CompressedDataRaw, CompressedSize, TCHAR_TO_UTF8(*FileContents), StrLength);
+			const bool bResult = FCompression::CompressMemory((ECompressionFlags)(COMPRESS_GZIP), CompressedDataRaw, CompressedSize, Utf8Contents.Get(), StrLength);
 			if (bResult)
 			{
-				ret = FFileHelper::SaveArrayToFile(TArrayView<const uint8>(CompressedDataRaw, CompressedSize), *GetSaveGamePath(SaveName, true));
+				ret = FFileHelper::SaveArrayToFile(TArrayView<const uint8>(CompressedDataRaw, CompressedSize), *Filename);
 			}
 
 			delete[] CompressedDataRaw;
 		}
 		else
 		{
-			ret = FFileHelper::SaveStringToFile(FileContents, *GetSaveGamePath(SaveName, false));
+			ret = FFileHelper::SaveStringToFile(FileContents, *Filename);
 		}
-		FLOG("UFlareSaveGameSystem::SaveGame : Save done");
 	}
 	else
 	{
-		FLOGV("Fail to serialize save %s", *SaveName);
+		FLOGV("Fail to serialize save %s", *Filename);
 		ret = false;
 	}
 
-	SaveLock.Unlock();
-
-	SaveListLock.Lock();
-	SaveList.Remove(SaveData);
-	SaveListLock.Unlock();
-
 	return ret;
 }
 
@@ -87,6 +162,23 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 
 	UFlareSaveGame *SaveGame = NULL;
 
+	// Binary save
+	if (IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0)
+	{
+		SaveGame = BinarySerializer->LoadGame(GetBinarySaveGamePath(SaveName), GetBinaryJournalPath(SaveName));
+		if (SaveGame)
+		{
+			FLOGV("Save '%s' read", *GetBinarySaveGamePath(SaveName));
+		}
+		else
+		{
+			// Older JSON files of this slot are outdated, don't load them in place of the binary save
+			FLOGV("ERROR: Fail to read save '%s'", *GetBinarySaveGamePath(SaveName));
+		}
+		return SaveGame;
+	}
+
+	// JSON save
 	// Read the saveto a string
 	FString SaveString;
 	bool SaveStringLoaded = false;
@@ -160,18 +252,41 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 
 bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
 {
-	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true) | IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true);
+	bool Result = IFileManager::Get().Delete(*GetSaveGamePath(SaveName, false), true)
+		| IFileManager::Get().Delete(*GetSaveGamePath(SaveName, true), true)
+		| IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	IFileManager::Get().Delete(*GetBinaryJournalPath(SaveName), false, false, true);
+
+	SaveLock.Lock();
+	SaveBases.Remove(SaveName);
+	SaveLock.Unlock();
+
 	return Result;
 }
 
 
-void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
+void UFlareSaveGameSystem::PushSaveData(const FString SaveName, UFlareSaveGame* SaveData)
 {
 	SaveListLock.Lock();
 	SaveList.Add(SaveData);
+	FFlareQueuedSaves& Queued = QueuedSaves.FindOrAdd(SaveName);
+	Queued.Latest = SaveData;
+	Queued.Count++;
 	SaveListLock.Unlock();
 }
 
+void UFlareSaveGameSystem::ReleaseQueuedSave(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	SaveList.Remove(SaveData);
+
+	// Keep the latest save known while older ones may still run, so that they are skipped
+	FFlareQueuedSaves* Queued = QueuedSaves.Find(SaveName);
+	if (Queued && --Queued->Count <= 0)
+	{
+		QueuedSaves.Remove(SaveName);
+	}
+}
+
 
 /*----------------------------------------------------
 	Getters
@@ -189,3 +304,18 @@ FString UFlareSaveGameSystem::GetSaveGamePath(const FString SaveName, bool compr
 		return FString::Printf(TEXT("%s/SaveGames/%s.json"), *FPaths::ProjectSavedDir(), *SaveName);
 	}
 }
+
+FString UFlareSaveGameSystem::GetExportPath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/Exports/%s.json"), *FPaths::ProjectSavedDir(), *SaveName);
+}
+
+FString UFlareSaveGameSystem::GetBinarySaveGamePath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.hrsave"), *FPaths::ProjectSavedDir(), *SaveName);
+}
+
+FString UFlareSaveGameSystem::GetBinaryJournalPath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.hrjournal"), *FPaths::ProjectSavedDir(), *SaveName);
+}
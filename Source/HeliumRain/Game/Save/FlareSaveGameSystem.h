@@ -2,10 +2,41 @@
 #pragma once
 
 #include "Object.h"
+#include "FlareSaveBinarySerializer.h"
 #include "FlareSaveGameSystem.generated.h"
 
 class UFlareSaveGame;
 
+
+/** Outcome of a save request */
+namespace EFlareSaveResult
+{
+	enum Type
+	{
+		Saved,
+		Failed,
+		/** A newer save of the same name was queued, nothing was written */
+		Superseded
+	};
+}
+
+
+/** Saves queued for a save name */
+struct FFlareQueuedSaves
+{
+	/** Last save pushed, older ones are skipped. Only compared to queued saves which are still referenced */
+	UFlareSaveGame*                            Latest;
+
+	/** Saves pushed and not yet written or skipped */
+	int32                                      Count;
+
+	FFlareQueuedSaves()
+		: Latest(NULL)
+		, Count(0)
+	{}
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareSaveGameSystem: public UObject
 {
@@ -21,18 +52,28 @@ public:
 	virtual bool DoesSaveGameExist(const FString SaveName);
 
 
-	virtual bool SaveGame(const FString SaveName, UFlareSaveGame* SaveData);
+	/** Save the game. Incremental saves only write a journal of the changes since the last full save */
+	virtual EFlareSaveResult::Type SaveGame(const FString SaveName, UFlareSaveGame* SaveData, bool Incremental = false);
+
+	/** Write a save as readable JSON, for debug and export. Exports are never loaded as saves */
+	virtual bool ExportGame(const FString SaveName, UFlareSaveGame* SaveData);
 
 	virtual UFlareSaveGame* LoadGame(const FString SaveName);
 
 
 	virtual bool DeleteGame(const FString SaveName);
 
-	/* Keep Save data reference for the async save*/
-	virtual void PushSaveData(UFlareSaveGame* SaveData);
+	/* Keep Save data reference for the async save, a newer save to the same name supersedes it */
+	virtual void PushSaveData(const FString SaveName, UFlareSaveGame* SaveData);
 
 protected:
 
+	/** A queued save was written or skipped, forget it. Called with SaveListLock held */
+	void ReleaseQueuedSave(const FString SaveName, UFlareSaveGame* SaveData);
+
+	/** Serialize the save as JSON to a file, compressed or not */
+	bool SaveGameJson(const FString Filename, UFlareSaveGame* SaveData, bool Compress);
+
 
 	/*----------------------------------------------------
 		Protected data
@@ -45,6 +86,19 @@ protected:
 	UPROPERTY()
 	TArray<UFlareSaveGame *> SaveList;
 
+	/** Queued saves of each save name, removed once they are all done */
+	TMap<FString, FFlareQueuedSaves> QueuedSaves;
+
+	/** Created on the game thread, stateless when saving */
+	UPROPERTY()
+	UFlareSaveBinarySerializer* BinarySerializer;
+
+	/** Last full save written for each save name, protected by SaveLock */
+	TMap<FString, FFlareSaveBinaryBase> SaveBases;
+
+	/** Journals written before a full save is forced */
+	static const int32 JournalCompactionCount = 10;
+
 
 public:
 
@@ -55,4 +109,13 @@ public:
    /** Get the path to save game file for the given name, a platform _may_ be able to simply override this and no other functions above */
    static FString GetSaveGamePath(const FString SaveName, bool compressed);
 
+   /** Get the path to the JSON export of the given save name, out of the save files */
+   static FString GetExportPath(const FString SaveName);
+
+   /** Get the path to the binary save game file for the given name */
+   static FString GetBinarySaveGamePath(const FString SaveName);
+
+   /** Get the path to the journal of the binary save game file for the given name */
+   static FString GetBinaryJournalPath(const FString SaveName);
+
 };
@@ -391,6 +391,17 @@ void UFlareSaveReaderV1::LoadCompany(const TSharedPtr<FJsonObject> Object, FFlar
 		}
 	}
 
+	const TArray<TSharedPtr<FJsonValue>>* TransactionBalances;
+	if(Object->TryGetArrayField("TransactionBalances", TransactionBalances))
+	{
+		for (TSharedPtr<FJsonValue> Item : *TransactionBalances)
+		{
+			FFlareTransactionLogBalance ChildData;
+			LoadTransactionLogBalance(Item->AsObject(), &ChildData);
+			Data->TransactionBalances.Add(ChildData);
+		}
+	}
+
 	LoadFloat(Object, "PlayerReputation", &Data->PlayerReputation);
 }
 
@@ -923,6 +934,13 @@ void UFlareSaveReaderV1::LoadTransactionLogEntry(const TSharedPtr<FJsonObject> O
 	LoadFName(Object, "ExtraIdentifier2", &Data->ExtraIdentifier2);
 }
 
+void UFlareSaveReaderV1::LoadTransactionLogBalance(const TSharedPtr<FJsonObject> Object, FFlareTransactionLogBalance* Data)
+{
+	LoadInt64(Object, "Date", &Data->Date);
+	Data->Type = LoadEnum<EFlareTransactionLogEntry::Type>(Object, "Type", "EFlareTransactionLogEntry");
+	LoadInt64(Object, "Amount", &Data->Amount);
+}
+
 
 
 void UFlareSaveReaderV1::LoadCompanyAI(const TSharedPtr<FJsonObject> Object, FFlareCompanyAISave* Data)
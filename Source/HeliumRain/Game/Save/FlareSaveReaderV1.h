@@ -56,6 +56,7 @@ protected:
 	void LoadTradeRouteSector(const TSharedPtr<FJsonObject> Object, FFlareTradeRouteSectorSave* Data);
 	void LoadSectorKnowledge(const TSharedPtr<FJsonObject> Object, FFlareCompanySectorKnowledge* Data);
 	void LoadTransactionLogEntry(const TSharedPtr<FJsonObject> Object, FFlareTransactionLogEntry* Data);
+	void LoadTransactionLogBalance(const TSharedPtr<FJsonObject> Object, FFlareTransactionLogBalance* Data);
 	void LoadCompanyAI(const TSharedPtr<FJsonObject> Object, FFlareCompanyAISave* Data);
 	void LoadCompanyReputation(const TSharedPtr<FJsonObject> Object, FFlareCompanyReputationSave* Data);
 
@@ -318,6 +318,13 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompany(FFlareCompanySave* Data)
 	}
 	JsonObject->SetArrayField("TransactionLog", TransactionLog);
 
+	TArray< TSharedPtr<FJsonValue> > TransactionBalances;
+	for(int i = 0; i < Data->TransactionBalances.Num(); i++)
+	{
+		TransactionBalances.Add(MakeShareable(new FJsonValueObject(SaveTransactionLogBalance(&Data->TransactionBalances[i]))));
+	}
+	JsonObject->SetArrayField("TransactionBalances", TransactionBalances);
+
 
 	return JsonObject;
 }
@@ -709,6 +716,17 @@ TSharedRef<FJsonObject> UFlareSaveWriter::SaveTransactionLogEntry(FFlareTransact
 	return JsonObject;
 }
 
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveTransactionLogBalance(FFlareTransactionLogBalance* Data)
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+
+	JsonObject->SetStringField("Date", FormatInt64(Data->Date));
+	JsonObject->SetStringField("Type", FormatEnum<EFlareTransactionLogEntry::Type>("EFlareTransactionLogEntry",Data->Type));
+	JsonObject->SetStringField("Amount", FormatInt64(Data->Amount));
+
+	return JsonObject;
+}
+
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyAI(FFlareCompanyAISave* Data)
 {
 	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
@@ -294,10 +294,10 @@ void UFlareSoundManager::Update(float DeltaSeconds)
 		int32 EngineCount = 0;
 
 		// Check all engines for engine alpha values
-		TArray<UActorComponent*> Engines = ShipPawn->GetComponentsByClass(UFlareEngine::StaticClass());
+		const TArray<UFlareEngine*>& Engines = ShipPawn->GetEngines();
 		for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 		{
-			UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+			UFlareEngine* Engine = Engines[EngineIndex];
 			if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
 			{
 				EngineAlpha += Engine->GetEffectiveAlpha();
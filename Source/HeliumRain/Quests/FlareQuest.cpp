@@ -27,6 +27,8 @@ UFlareQuest::UFlareQuest(const FObjectInitializer& ObjectInitializer)
 	  Client(NULL)
 {
 	Accepted = false;
+	CurrentConditionsStep = NULL;
+	CurrentConditionsValid = false;
 	QuestData.AvailableDate = 0;
 	QuestData.AcceptationDate = 0;
 }
@@ -540,9 +542,18 @@ void UFlareQuest::UpdateObjectiveTracker()
 	Callbacks
 ----------------------------------------------------*/
 
-TArray<UFlareQuestCondition*> UFlareQuest::GetCurrentConditions()
+const TArray<UFlareQuestCondition*>& UFlareQuest::GetCurrentConditions()
 {
-	TArray<UFlareQuestCondition*> Conditions;
+	if (CurrentConditionsValid && CurrentConditionsStatus == QuestStatus && CurrentConditionsStep == CurrentStep)
+	{
+		return CurrentConditions;
+	}
+
+	TArray<UFlareQuestCondition*>& Conditions = CurrentConditions;
+	Conditions.Reset();
+	CurrentConditionsStatus = QuestStatus;
+	CurrentConditionsStep = CurrentStep;
+	CurrentConditionsValid = true;
 
 	switch(QuestStatus)
 	{
@@ -574,35 +585,29 @@ TArray<UFlareQuestCondition*> UFlareQuest::GetCurrentConditions()
 	return Conditions;
 }
 
-TArray<EFlareQuestCallback::Type> UFlareQuest::GetCurrentCallbacks()
+TArray<UFlareQuestCondition*> UFlareQuest::GetCallbackConditions()
 {
-	TArray<EFlareQuestCallback::Type> Callbacks;
+	TArray<UFlareQuestCondition*> Conditions;
 
-	// TODO Cache and return reference
 	switch(QuestStatus)
 	{
 		case EFlareQuestStatus::PENDING:
 			// Use trigger conditions
-			UFlareQuestCondition::AddConditionCallbacks(Callbacks, TriggerCondition->GetAllConditions());
-
-			if (Callbacks.Contains(EFlareQuestCallback::TICK_FLYING))
-			{
-				FLOGV("WARNING: The quest %s need a TICK_FLYING callback as trigger", *GetIdentifier().ToString());
-			}
+			Conditions += TriggerCondition->GetAllConditions();
 			break;
 		case EFlareQuestStatus::AVAILABLE:
 			// Use expiration conditions
-			UFlareQuestCondition::AddConditionCallbacks(Callbacks, ExpirationCondition->GetAllConditions());
+			Conditions += ExpirationCondition->GetAllConditions();
 			break;
 		case EFlareQuestStatus::ONGOING:
 		 {
 			// Use current step conditions
 			if (CurrentStep)
 			{
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetEnableCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetEndCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetFailCondition()->GetAllConditions());
-				UFlareQuestCondition::AddConditionCallbacks(Callbacks, CurrentStep->GetBlockCondition()->GetAllConditions());
+				Conditions += CurrentStep->GetEnableCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetEndCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetFailCondition()->GetAllConditions();
+				Conditions += CurrentStep->GetBlockCondition()->GetAllConditions();
 			}
 			else
 			{
@@ -615,9 +620,48 @@ TArray<EFlareQuestCallback::Type> UFlareQuest::GetCurrentCallbacks()
 			break;
 	}
 
+	return Conditions;
+}
+
+TArray<EFlareQuestCallback::Type> UFlareQuest::GetCurrentCallbacks()
+{
+	TArray<EFlareQuestCallback::Type> Callbacks;
+	UFlareQuestCondition::AddConditionCallbacks(Callbacks, GetCallbackConditions());
+
+	if (QuestStatus == EFlareQuestStatus::PENDING && Callbacks.Contains(EFlareQuestCallback::TICK_FLYING))
+	{
+		FLOGV("WARNING: The quest %s need a TICK_FLYING callback as trigger", *GetIdentifier().ToString());
+	}
+
 	return Callbacks;
 }
 
+bool UFlareQuest::GetCurrentEventTags(TArray<FName>& Tags)
+{
+	Tags.Reset();
+
+	for (UFlareQuestCondition* Condition : GetCallbackConditions())
+	{
+		if (!Condition->GetConditionCallbacks().Contains(EFlareQuestCallback::QUEST_EVENT))
+		{
+			continue;
+		}
+		else if (Condition->EventTags.Num() == 0)
+		{
+			// This condition handles any event
+			Tags.Reset();
+			return false;
+		}
+
+		for (FName Tag : Condition->EventTags)
+		{
+			Tags.AddUnique(Tag);
+		}
+	}
+
+	return true;
+}
+
 void UFlareQuest::OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity)
 {
 	for (UFlareQuestCondition* Condition : GetCurrentConditions())
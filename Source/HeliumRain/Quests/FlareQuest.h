@@ -30,6 +30,22 @@ namespace EFlareQuestCategory
 
 struct FFlarePlayerObjectiveData;
 
+/** Resource quantity or free space a quest keeps aside in a station */
+struct FFlareQuestCargoReservation
+{
+	FName                                    StationIdentifier;
+	FName                                    ResourceIdentifier;
+	int32                                    Quantity;
+	int32                                    Capacity;
+
+	FFlareQuestCargoReservation(FName Station, FName Resource, int32 ReservedQuantity, int32 ReservedCapacity)
+		: StationIdentifier(Station)
+		, ResourceIdentifier(Resource)
+		, Quantity(ReservedQuantity)
+		, Capacity(ReservedCapacity)
+	{}
+};
+
 /** Quest */
 UCLASS()
 class HELIUMRAIN_API UFlareQuest: public UObject
@@ -77,9 +93,8 @@ public:
 
 	virtual FText FormatTags(FText Message);
 
-	virtual int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
-
-	virtual int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource) { return 0; };
+	/** Add the station cargo kept aside by this quest while it is available or ongoing */
+	virtual void GetCargoReservations(TArray<FFlareQuestCargoReservation>& Reservations) {};
 
 
 	/*----------------------------------------------------
@@ -96,10 +111,14 @@ public:
 		Callback
 	----------------------------------------------------*/
 
-	virtual TArray<UFlareQuestCondition*> GetCurrentConditions();
+	/** Conditions of the current status and step, kept until either changes */
+	virtual const TArray<UFlareQuestCondition*>& GetCurrentConditions();
 
 	virtual TArray<EFlareQuestCallback::Type> GetCurrentCallbacks();
 
+	/** Tags of the events the current QUEST_EVENT conditions handle. Return false if they handle any event */
+	virtual bool GetCurrentEventTags(TArray<FName>& Tags);
+
 	virtual void OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity);
 
 	virtual void OnSpacecraftCaptured(UFlareSimulatedSpacecraft* CapturedSpacecraftBefore, UFlareSimulatedSpacecraft* CapturedSpacecraftAfter);
@@ -112,10 +131,8 @@ public:
 
 protected:
 
-	/*----------------------------------------------------
-		Objective tracking
-	----------------------------------------------------*/
-
+	/** Conditions providing the current callbacks */
+	TArray<UFlareQuestCondition*> GetCallbackConditions();
 
 
    /*----------------------------------------------------
@@ -139,6 +156,13 @@ protected:
 	UPROPERTY()
 	UFlareQuestConditionGroup*           ExpirationCondition;
 
+	// Current conditions cache
+	UPROPERTY()
+	TArray<UFlareQuestCondition*>           CurrentConditions;
+	EFlareQuestStatus::Type                 CurrentConditionsStatus;
+	UFlareQuestStep*                        CurrentConditionsStep;
+	bool                                    CurrentConditionsValid;
+
 	UPROPERTY()
 	TArray<UFlareQuestAction*>				SuccessActions;
 	UPROPERTY()
@@ -49,6 +49,9 @@ public:
 	}
 
 	TArray<EFlareQuestCallback::Type> Callbacks;
+
+	/** Tags of the events handled by a QUEST_EVENT condition, any event if empty. Conditions polling state on events keep it empty */
+	TArray<FName> EventTags;
 protected:
 
 	  void LoadInternal(UFlareQuest* ParentQuest, FName ConditionIdentifier = NAME_None)
@@ -274,7 +274,7 @@ void UFlareQuestGenerator::GenerateSectorQuest(UFlareSimulatedSector* Sector)
 	for (int32 SectorIndex = 0; SectorIndex < PlayerCompany->GetKnownSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* KnownSector = PlayerCompany->GetKnownSectors()[SectorIndex];
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats1 = SectorHelper::ComputeSectorResourceStats(KnownSector, false);
+		const TArray<WorldHelper::FlareResourceStats>& Stats1 = Game->GetGameWorld()->GetSectorResourceStats(KnownSector, false);
 
 		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 		{
@@ -286,11 +286,11 @@ void UFlareQuestGenerator::GenerateSectorQuest(UFlareSimulatedSector* Sector)
 				continue;
 			}
 
-			if(Stats1[Resource].Production > 0)
+			if(Stats1[Resource->CatalogIndex].Production > 0)
 			{
 				AvailableResources.Add(Resource);
 				//FLOGV("%s is available in %s %d", *Resource->Identifier.ToString(), *KnownSector->GetSectorName().ToString(),
-				//	Stats1[Resource].Production);
+				//	Stats1[Resource->CatalogIndex].Production);
 			}
 		}
 	}
@@ -1095,22 +1095,9 @@ bool UFlareQuestGeneratedResourceSale::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceSale::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceSale::GetCargoReservations(TArray<FFlareQuestCargoReservation>& Reservations)
 {
-	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
-
-	if (Station == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
+	Reservations.Add(FFlareQuestCargoReservation(InitData.GetName("station"), InitData.GetName("resource"), InitData.GetInt32("quantity"), 0));
 }
 
 /*----------------------------------------------------
@@ -1326,22 +1313,9 @@ bool UFlareQuestGeneratedResourcePurchase::Load(UFlareQuestGenerator* Parent, co
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourcePurchase::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourcePurchase::GetCargoReservations(TArray<FFlareQuestCargoReservation>& Reservations)
 {
-	UFlareSimulatedSpacecraft* Station = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station"));
-	// TODO Cache
-
-	if (Station == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
+	Reservations.Add(FFlareQuestCargoReservation(InitData.GetName("station"), InitData.GetName("resource"), 0, InitData.GetInt32("quantity")));
 }
 
 /*----------------------------------------------------
@@ -1614,41 +1588,15 @@ bool UFlareQuestGeneratedResourceTrade::Load(UFlareQuestGenerator* Parent, const
 	return true;
 }
 
-int32 UFlareQuestGeneratedResourceTrade::GetReservedCapacity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
+void UFlareQuestGeneratedResourceTrade::GetCargoReservations(TArray<FFlareQuestCargoReservation>& Reservations)
 {
-	UFlareSimulatedSpacecraft* Station2 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station2"));
-	// TODO Cache
-
-	if (Station2 == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
+	FName Resource = InitData.GetName("resource");
+	int32 Quantity = InitData.GetInt32("quantity");
 
-	return 0;
+	Reservations.Add(FFlareQuestCargoReservation(InitData.GetName("station1"), Resource, Quantity, 0));
+	Reservations.Add(FFlareQuestCargoReservation(InitData.GetName("station2"), Resource, 0, Quantity));
 }
 
-int32 UFlareQuestGeneratedResourceTrade::GetReservedQuantity(UFlareSimulatedSpacecraft* TargetStation, FFlareResourceDescription* TargetResource)
-{
-	UFlareSimulatedSpacecraft* Station1 = QuestManager->GetGame()->GetGameWorld()->FindSpacecraft(InitData.GetName("station1"));
-	// TODO Cache
-
-	if (Station1 == TargetStation)
-	{
-		FFlareResourceDescription* Resource = QuestManager->GetGame()->GetResourceCatalog()->Get(InitData.GetName("resource"));
-		if (Resource == TargetResource)
-		{
-			int32 Quantity = InitData.GetInt32("quantity");
-			return Quantity;
-		}
-	}
-
-	return 0;
-}
 /*----------------------------------------------------
 	Generated station defense quest
 ----------------------------------------------------*/
@@ -4,6 +4,7 @@
 #include "../Game/FlareGame.h"
 #include "../Data/FlareQuestCatalog.h"
 #include "../Data/FlareQuestCatalogEntry.h"
+#include "../Data/FlareResourceCatalog.h"
 #include "../Player/FlarePlayerController.h"
 #include "FlareQuestGenerator.h"
 #include "FlareCatalogQuest.h"
@@ -22,6 +23,9 @@ DECLARE_CYCLE_STAT(TEXT("FlareQuestManager OnCallbackEvent"), STAT_FlareQuestMan
 UFlareQuestManager::UFlareQuestManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	AnyEventListenerCount = 0;
+	MilitaryContractsDirty = true;
+	CargoReservationsDirty = true;
 }
 
 
@@ -51,6 +55,8 @@ void UFlareQuestManager::Load(const FFlareQuestSave& Data)
 
 	LoadDynamicQuests();
 
+	MilitaryContractsDirty = true;
+	InvalidateCargoReservations();
 
 	for(UFlareQuest* Quest: Quests)
 	{
@@ -306,31 +312,26 @@ void UFlareQuestManager::LoadCallbacks(UFlareQuest* Quest)
 
 	for (int i = 0; i < Callbacks.Num(); i++)
 	{
-		CallbacksMap.FindOrAdd(Callbacks[i]).Add(Quest);
+		GetWritableCallbacks(Callbacks[i]).Add(Quest);
+	}
 
-		/*switch (Callbacks[i])
+	// Index the events this quest handles
+	if (Callbacks.Contains(EFlareQuestCallback::QUEST_EVENT))
+	{
+		TArray<FName> Tags;
+		if (Quest->GetCurrentEventTags(Tags))
+		{
+			for (FName Tag : Tags)
+			{
+				EventTagListenerCounts.FindOrAdd(Tag)++;
+			}
+		}
+		else
 		{
-		case EFlareQuestCallback::FLY_SHIP:
-			FlyShipCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::TICK_FLYING:
-			TickFlyingCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SECTOR_VISITED:
-			SectorVisitedCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SECTOR_ACTIVE:
-			SectorActiveCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::SHIP_DOCKED:
-			ShipDockedCallback.Add(Quest);
-			break;
-		case EFlareQuestCallback::QUEST:
-			QuestCallback.Add(Quest);
-			break;
-		default:
-			FLOGV("Bad callback type %d for quest %s", (int)(Callbacks[i] + 0), *Quest->GetIdentifier().ToString());
-		}*/
+			AnyEventListenerCount++;
+		}
+
+		QuestEventTags.Add(Quest, Tags);
 	}
 }
 
@@ -338,18 +339,81 @@ void UFlareQuestManager::ClearCallbacks(UFlareQuest* Quest)
 {
 	for (auto& Elem : CallbacksMap)
 	{
-		Elem.Value.Remove(Quest);
+		if (Elem.Value->Contains(Quest))
+		{
+			GetWritableCallbacks(Elem.Key).Remove(Quest);
+		}
+	}
+
+	TArray<FName> Tags;
+	if (QuestEventTags.RemoveAndCopyValue(Quest, Tags))
+	{
+		if (Tags.Num() == 0)
+		{
+			AnyEventListenerCount--;
+		}
+
+		for (FName Tag : Tags)
+		{
+			int32& Count = EventTagListenerCounts.FindChecked(Tag);
+			Count--;
+			if (Count == 0)
+			{
+				EventTagListenerCounts.Remove(Tag);
+			}
+		}
 	}
 }
 
+TArray<UFlareQuest*>& UFlareQuestManager::GetWritableCallbacks(EFlareQuestCallback::Type EventType)
+{
+	TSharedPtr<TArray<UFlareQuest*>>& Callbacks = CallbacksMap.FindOrAdd(EventType);
+
+	if (!Callbacks.IsValid())
+	{
+		Callbacks = MakeShareable(new TArray<UFlareQuest*>());
+	}
+	else if (!Callbacks.IsUnique())
+	{
+		// An event is iterating this list, leave it untouched
+		Callbacks = MakeShareable(new TArray<UFlareQuest*>(*Callbacks));
+	}
+
+	return *Callbacks;
+}
+
+bool UFlareQuestManager::IsListeningEvent(FName Tag) const
+{
+	return AnyEventListenerCount > 0 || EventTagListenerCounts.Contains(Tag);
+}
+
+bool UFlareQuestManager::IsQuestListeningEvent(UFlareQuest* Quest, const FFlareBundle& Bundle) const
+{
+	const TArray<FName>* Tags = QuestEventTags.Find(Quest);
+	if (!Tags || Tags->Num() == 0)
+	{
+		return true;
+	}
+
+	for (FName Tag : *Tags)
+	{
+		if (Bundle.HasTag(Tag))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void UFlareQuestManager::OnCallbackEvent(EFlareQuestCallback::Type EventType)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareQuestManager_OnCallbackEvent);
 	
-	if (CallbacksMap.Contains(EventType))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EventType);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EventType];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
 			Quest->UpdateState();
 		}
@@ -392,10 +456,10 @@ void UFlareQuestManager::OnWarStateChanged(UFlareCompany* Company1, UFlareCompan
 
 void UFlareQuestManager::OnSpacecraftDestroyed(UFlareSimulatedSpacecraft* Spacecraft, bool Uncontrollable, DamageCause Cause)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::SPACECRAFT_DESTROYED))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EFlareQuestCallback::SPACECRAFT_DESTROYED);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::SPACECRAFT_DESTROYED];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
 			Quest->OnSpacecraftDestroyed(Spacecraft, Uncontrollable, Cause);
 			Quest->UpdateState();
@@ -407,10 +471,10 @@ void UFlareQuestManager::OnSpacecraftDestroyed(UFlareSimulatedSpacecraft* Spacec
 
 void UFlareQuestManager::OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft, UFlareSimulatedSpacecraft* DestinationSpacecraft, FFlareResourceDescription* Resource, int32 Quantity)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::TRADE_DONE))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EFlareQuestCallback::TRADE_DONE);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::TRADE_DONE];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
 			Quest->OnTradeDone(SourceSpacecraft, DestinationSpacecraft, Resource, Quantity);
 			Quest->UpdateState();
@@ -422,10 +486,10 @@ void UFlareQuestManager::OnTradeDone(UFlareSimulatedSpacecraft* SourceSpacecraft
 
 void UFlareQuestManager::OnSpacecraftCaptured(UFlareSimulatedSpacecraft* CapturedSpacecraftBefore, UFlareSimulatedSpacecraft* CapturedSpacecraftAfter)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::SPACECRAFT_CAPTURED))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EFlareQuestCallback::SPACECRAFT_CAPTURED);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::SPACECRAFT_CAPTURED];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
 			Quest->OnSpacecraftCaptured(CapturedSpacecraftBefore, CapturedSpacecraftAfter);
 			Quest->UpdateState();
@@ -438,10 +502,10 @@ void UFlareQuestManager::OnSpacecraftCaptured(UFlareSimulatedSpacecraft* Capture
 
 void UFlareQuestManager::OnTravelStarted(UFlareTravel* Travel)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::TRAVEL_STARTED))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EFlareQuestCallback::TRAVEL_STARTED);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::TRAVEL_STARTED];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
 			Quest->OnTravelStarted(Travel);
 			Quest->UpdateState();
@@ -453,11 +517,16 @@ void UFlareQuestManager::OnTravelStarted(UFlareTravel* Travel)
 
 void UFlareQuestManager::OnEvent(FFlareBundle& Bundle)
 {
-	if (CallbacksMap.Contains(EFlareQuestCallback::QUEST_EVENT))
+	TSharedPtr<TArray<UFlareQuest*>> Callbacks = CallbacksMap.FindRef(EFlareQuestCallback::QUEST_EVENT);
+	if (Callbacks.IsValid())
 	{
-		TArray<UFlareQuest*> Callbacks = CallbacksMap[EFlareQuestCallback::QUEST_EVENT];
-		for (UFlareQuest* Quest: Callbacks)
+		for (UFlareQuest* Quest: *Callbacks)
 		{
+			if (!IsQuestListeningEvent(Quest, Bundle))
+			{
+				continue;
+			}
+
 			Quest->OnEvent(Bundle);
 			Quest->UpdateState();
 		}
@@ -524,6 +593,11 @@ void UFlareQuestManager::OnQuestStatusChanged(UFlareQuest* Quest)
 {
 	LoadCallbacks(Quest);
 
+	{
+		FScopeLock Lock(&MilitaryCacheLock);
+		MilitaryContractsDirty = true;
+	}
+
 	OnCallbackEvent(EFlareQuestCallback::QUEST_CHANGED);
 }
 
@@ -532,6 +606,7 @@ void UFlareQuestManager::OnQuestSuccess(UFlareQuest* Quest)
 	FLOGV("Quest %s is now successful", *Quest->GetIdentifier().ToString())
 	OngoingQuests.Remove(Quest);
 	OldQuests.Add(Quest);
+	InvalidateCargoReservations();
 
 	// Quest successful notification
 	if (Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL)
@@ -562,6 +637,7 @@ void UFlareQuestManager::OnQuestFail(UFlareQuest* Quest, bool Notify)
 	AvailableQuests.Remove(Quest);
 	PendingQuests.Remove(Quest);
 	OldQuests.Add(Quest);
+	InvalidateCargoReservations();
 
 	// Quest failed notification
 	if (Notify && Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL)
@@ -588,6 +664,7 @@ void UFlareQuestManager::OnQuestAvailable(UFlareQuest* Quest)
 	FLOGV("Quest %s is now available", *Quest->GetIdentifier().ToString())
 	PendingQuests.Remove(Quest);
 	AvailableQuests.Add(Quest);
+	InvalidateCargoReservations();
 
 	// New quest notification
 	if (Quest->GetQuestCategory() != EFlareQuestCategory::TUTORIAL && Quest->GetQuestCategory() != EFlareQuestCategory::SECONDARY)
@@ -609,7 +686,8 @@ void UFlareQuestManager::OnQuestOngoing(UFlareQuest* Quest)
 	FLOGV("Quest %s is now ongoing", *Quest->GetIdentifier().ToString())
 	AvailableQuests.Remove(Quest);
 	OngoingQuests.Add(Quest);
-	
+	InvalidateCargoReservations();
+
 	if (!SelectedQuest)
 	{
 		SelectQuest(Quest);
@@ -619,36 +697,67 @@ void UFlareQuestManager::OnQuestOngoing(UFlareQuest* Quest)
 
 int32 UFlareQuestManager::GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
 {
-	int32 ReservedCapacity = 0;
+	FScopeLock Lock(&CargoReservationLock);
 
-	for(UFlareQuest* Quest: OngoingQuests)
+	if (CargoReservationsDirty)
 	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
+		UpdateCargoReservations();
 	}
 
-	for(UFlareQuest* Quest: AvailableQuests)
+	return ReservedCapacities.FindRef(CargoReservationKey(Station->GetImmatriculation(), Resource));
+}
+
+int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+{
+	FScopeLock Lock(&CargoReservationLock);
+
+	if (CargoReservationsDirty)
 	{
-		ReservedCapacity += Quest->GetReservedCapacity(Station, Resource);
+		UpdateCargoReservations();
 	}
 
-	return ReservedCapacity;
+	return ReservedQuantities.FindRef(CargoReservationKey(Station->GetImmatriculation(), Resource));
 }
 
-int32 UFlareQuestManager::GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource)
+void UFlareQuestManager::InvalidateCargoReservations()
 {
-	int32 ReservedQuantity = 0;
+	FScopeLock Lock(&CargoReservationLock);
+	CargoReservationsDirty = true;
+}
+
+void UFlareQuestManager::UpdateCargoReservations()
+{
+	ReservedQuantities.Empty();
+	ReservedCapacities.Empty();
 
+	TArray<FFlareQuestCargoReservation> Reservations;
 	for(UFlareQuest* Quest: OngoingQuests)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
+		Quest->GetCargoReservations(Reservations);
 	}
 
 	for(UFlareQuest* Quest: AvailableQuests)
 	{
-		ReservedQuantity += Quest->GetReservedQuantity(Station, Resource);
+		Quest->GetCargoReservations(Reservations);
+	}
+
+	for(const FFlareQuestCargoReservation& Reservation : Reservations)
+	{
+		FFlareResourceDescription* Resource = Game->GetResourceCatalog()->Get(Reservation.ResourceIdentifier);
+		CargoReservationKey Key(Reservation.StationIdentifier, Resource);
+
+		if (Reservation.Quantity > 0)
+		{
+			ReservedQuantities.FindOrAdd(Key) += Reservation.Quantity;
+		}
+
+		if (Reservation.Capacity > 0)
+		{
+			ReservedCapacities.FindOrAdd(Key) += Reservation.Capacity;
+		}
 	}
 
-	return ReservedQuantity;
+	CargoReservationsDirty = false;
 }
 
 /*----------------------------------------------------
@@ -857,50 +966,31 @@ bool UFlareQuestManager::IsTradeQuestUseStation(UFlareSimulatedSpacecraft* Stati
 
 bool UFlareQuestManager::IsUnderMilitaryContract(UFlareSimulatedSector* Sector,  UFlareCompany* Company, bool IncludeCache)
 {
-	if(IsUnderMilitaryContractNoCache(Sector, Company))
-	{
-		for(IsUnderMilitaryContractCacheEntry& CacheEntry : IsUnderMilitaryContractCache)
-		{
-			if(CacheEntry.Sector == Sector && CacheEntry.Company == Company)
-			{
-				CacheEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-				return true;
-			}
-		}
+	FScopeLock Lock(&MilitaryCacheLock);
 
-		IsUnderMilitaryContractCacheEntry NewEntry;
-		NewEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-		NewEntry.Sector = Sector;
-		NewEntry.Company = Company;
-		IsUnderMilitaryContractCache.Add(NewEntry);
+	TPair<UFlareSimulatedSector const*, UFlareCompany const*> CacheKey(Sector, Company);
 
+	if(IsUnderMilitaryContractNoCache(Sector, Company))
+	{
+		IsUnderMilitaryContractCache.Add(CacheKey, FPlatformTime::Seconds() + 10.f);
 		return true;
 	}
-	else if(!IncludeCache)
+	else if(!IncludeCache || IsUnderMilitaryContractCache.Num() == 0)
 	{
 		return false;
 	}
 	else
 	{
-		int Index = 0;
-
-		for(IsUnderMilitaryContractCacheEntry& CacheEntry : IsUnderMilitaryContractCache)
+		double* ExpireTime = IsUnderMilitaryContractCache.Find(CacheKey);
+		if(ExpireTime)
 		{
-			if(CacheEntry.Sector == Sector && CacheEntry.Company == Company)
+			if(*ExpireTime > FPlatformTime::Seconds())
 			{
-				if(CacheEntry.ExpireTime > FPlatformTime::Seconds())
-				{
-					return true;
-				}
-				else
-				{
-					IsUnderMilitaryContractCache.RemoveAt(Index);
-					break;
-				}
+				return true;
 			}
-			Index++;
-		}
 
+			IsUnderMilitaryContractCache.Remove(CacheKey);
+		}
 
 		return false;
 	}
@@ -908,221 +998,166 @@ bool UFlareQuestManager::IsUnderMilitaryContract(UFlareSimulatedSector* Sector,
 
 bool UFlareQuestManager::IsMilitaryTarget(UFlareSimulatedSpacecraft const* Spacecraft, bool IncludeCache)
 {
+	FScopeLock Lock(&MilitaryCacheLock);
+
 	if(IsMilitaryTargetNoCache(Spacecraft))
 	{
-		for(IsMilitaryTargetCacheEntry& CacheEntry : IsMilitaryTargetCache)
-		{
-			if(CacheEntry.Spacecraft == Spacecraft)
-			{
-				CacheEntry.ExpireTime = FPlatformTime::Seconds() + 10.f;
-				return true;
-			}
-		}
-
-		IsMilitaryTargetCacheEntry NewEntry;
-		NewEntry.ExpireTime = FPlatformTime::Seconds();
-		NewEntry.Spacecraft = Spacecraft;
-		IsMilitaryTargetCache.Add(NewEntry);
-
+		IsMilitaryTargetCache.Add(Spacecraft, FPlatformTime::Seconds() + 10.f);
 		return true;
 	}
-	else if(!IncludeCache)
+	else if(!IncludeCache || IsMilitaryTargetCache.Num() == 0)
 	{
 		return false;
 	}
 	else
 	{
-		int Index = 0;
-		for(IsMilitaryTargetCacheEntry& CacheEntry : IsMilitaryTargetCache)
+		double* ExpireTime = IsMilitaryTargetCache.Find(Spacecraft);
+		if(ExpireTime)
 		{
-			if(CacheEntry.Spacecraft == Spacecraft)
+			if(*ExpireTime > FPlatformTime::Seconds())
 			{
-				if(CacheEntry.ExpireTime > FPlatformTime::Seconds())
-				{
-					return true;
-				}
-				else
-				{
-					IsMilitaryTargetCache.RemoveAt(Index);
-					break;
-				}
+				return true;
 			}
-			Index++;
+
+			IsMilitaryTargetCache.Remove(Spacecraft);
 		}
+
 		return false;
 	}
 }
 
 bool UFlareQuestManager::IsUnderMilitaryContractNoCache(UFlareSimulatedSector* Sector,  UFlareCompany* Company)
 {
-	for(UFlareQuest* OngoingQuest : GetOngoingQuests())
+	FScopeLock Lock(&MilitaryCacheLock);
+
+	const MilitaryContractRules* Rules = GetMilitaryContractRules(Company);
+	if(!Rules)
 	{
-		UFlareQuestGeneratedCargoHunt2* CargoHunt = Cast<UFlareQuestGeneratedCargoHunt2>(OngoingQuest);
-		if(CargoHunt)
-		{
+		return false;
+	}
 
-			if(CargoHunt->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
+	FName SectorIdentifier = Sector->GetIdentifier();
 
-			bool TargetLargeCargo = CargoHunt->GetInitData()->GetInt32("large-cargo") > 0;
+	if(Rules->DefenseSectors.Contains(SectorIdentifier))
+	{
+		return true;
+	}
 
-			for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
-			{
-				if(Ship->GetCompany() != Company)
-				{
-					continue;
-				}
-
-				if(Ship->IsMilitary())
-				{
-					continue;
-				}
-
-				if(TargetLargeCargo == (Ship->GetSize() == EFlarePartSize::L))
-				{
-					return true;
-				}
-			}
-		}
+	if(Rules->AttackSectors.Contains(TPair<FName, int32>(SectorIdentifier, GetGame()->GetGameWorld()->GetDate())))
+	{
+		return true;
+	}
 
-		UFlareQuestGeneratedMilitaryHunt2* MilitaryHunt = Cast<UFlareQuestGeneratedMilitaryHunt2>(OngoingQuest);
-		if(MilitaryHunt)
+	// Hunt contracts need a hunted ship in the sector
+	if(Rules->HuntLargeCargo || Rules->HuntSmallCargo || Rules->HuntMilitary)
+	{
+		for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
 		{
-			if(MilitaryHunt->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
+			if(Ship->GetCompany() != Company)
 			{
 				continue;
 			}
 
-
-			for(UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+			if(Ship->IsMilitary() ? Rules->HuntMilitary : (Ship->GetSize() == EFlarePartSize::L ? Rules->HuntLargeCargo : Rules->HuntSmallCargo))
 			{
-				if(Ship->GetCompany() != Company)
-				{
-					continue;
-				}
-
-				if(!Ship->IsMilitary())
-				{
-					continue;
-				}
-
 				return true;
 			}
 		}
+	}
 
-		UFlareQuestGeneratedStationDefense2* StationDefense = Cast<UFlareQuestGeneratedStationDefense2>(OngoingQuest);
-		if(StationDefense)
-		{
-			if(StationDefense->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
-
-			if(StationDefense->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
-
-			return true;
-		}
-
-		UFlareQuestGeneratedJoinAttack2* JoinAttack = Cast<UFlareQuestGeneratedJoinAttack2>(OngoingQuest);
-		if(JoinAttack)
-		{
-
-			if(JoinAttack->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
-
-			int32 AttackDate = JoinAttack->GetInitData()->GetInt32("attack-date");
-			if(GetGame()->GetGameWorld()->GetDate() != AttackDate)
-			{
-				continue;
-			}
+	return false;
+}
 
-			TArray<FName> HostileCompanyNames = JoinAttack->GetInitData()->GetNameArray("hostile-companies");
-			for(FName HostileCompanyName : HostileCompanyNames)
-			{
-				if(HostileCompanyName  == Company->GetIdentifier())
-				{
-					return true;
-				}
-			}
+bool UFlareQuestManager::IsMilitaryTargetNoCache(UFlareSimulatedSpacecraft const* Spacecraft)
+{
+	FScopeLock Lock(&MilitaryCacheLock);
 
-			continue;
-		}
+	const MilitaryContractRules* Rules = GetMilitaryContractRules(Spacecraft->GetCompany());
+	if(!Rules)
+	{
+		return false;
+	}
 
-		UFlareQuestGeneratedSectorDefense2* SectorDefense = Cast<UFlareQuestGeneratedSectorDefense2>(OngoingQuest);
-		if(SectorDefense)
-		{
-			if(SectorDefense->GetInitData()->GetName("hostile-company") != Company->GetIdentifier())
-			{
-				continue;
-			}
+	if(Spacecraft->IsMilitary())
+	{
+		return Rules->HuntMilitary;
+	}
 
-			int32 AttackDate = SectorDefense->GetInitData()->GetInt32("attack-date");
-			if(GetGame()->GetGameWorld()->GetDate() != AttackDate)
-			{
-				continue;
-			}
+	return (Spacecraft->GetSize() == EFlarePartSize::L) ? Rules->HuntLargeCargo : Rules->HuntSmallCargo;
+}
 
-			if(SectorDefense->GetInitData()->GetName("sector") != Sector->GetIdentifier())
-			{
-				continue;
-			}
+const UFlareQuestManager::MilitaryContractRules* UFlareQuestManager::GetMilitaryContractRules(UFlareCompany const* Company)
+{
+	if(MilitaryContractsDirty)
+	{
+		UpdateMilitaryContracts();
+	}
 
-			return true;
-		}
+	if(MilitaryContracts.Num() == 0)
+	{
+		return NULL;
 	}
 
-	return false;
+	return MilitaryContracts.Find(Company->GetIdentifier());
 }
 
-bool UFlareQuestManager::IsMilitaryTargetNoCache(UFlareSimulatedSpacecraft const* Spacecraft)
+void UFlareQuestManager::UpdateMilitaryContracts()
 {
+	MilitaryContracts.Empty();
+
 	for(UFlareQuest* OngoingQuest : GetOngoingQuests())
 	{
 		UFlareQuestGeneratedCargoHunt2* CargoHunt = Cast<UFlareQuestGeneratedCargoHunt2>(OngoingQuest);
 		if(CargoHunt)
 		{
-			if(Spacecraft->IsMilitary())
-			{
-		continue;
-			}
+			MilitaryContractRules& Rules = MilitaryContracts.FindOrAdd(CargoHunt->GetInitData()->GetName("hostile-company"));
 
-			if(CargoHunt->GetInitData()->GetName("hostile-company") != Spacecraft->GetCompany()->GetIdentifier())
+			if(CargoHunt->GetInitData()->GetInt32("large-cargo") > 0)
 			{
-				continue;
+				Rules.HuntLargeCargo = true;
 			}
-
-			bool TargetLargeCargo = CargoHunt->GetInitData()->GetInt32("large-cargo") > 0;
-
-			if(TargetLargeCargo == (Spacecraft->GetSize() == EFlarePartSize::L))
+			else
 			{
-				return true;
+				Rules.HuntSmallCargo = true;
 			}
+			continue;
 		}
 
 		UFlareQuestGeneratedMilitaryHunt2* MilitaryHunt = Cast<UFlareQuestGeneratedMilitaryHunt2>(OngoingQuest);
 		if(MilitaryHunt)
 		{
-			if(!Spacecraft->IsMilitary())
-			{
-				continue;
-			}
+			MilitaryContracts.FindOrAdd(MilitaryHunt->GetInitData()->GetName("hostile-company")).HuntMilitary = true;
+			continue;
+		}
 
-			if(MilitaryHunt->GetInitData()->GetName("hostile-company") != Spacecraft->GetCompany()->GetIdentifier())
+		UFlareQuestGeneratedStationDefense2* StationDefense = Cast<UFlareQuestGeneratedStationDefense2>(OngoingQuest);
+		if(StationDefense)
+		{
+			MilitaryContracts.FindOrAdd(StationDefense->GetInitData()->GetName("hostile-company")).DefenseSectors.AddUnique(StationDefense->GetInitData()->GetName("sector"));
+			continue;
+		}
+
+		UFlareQuestGeneratedJoinAttack2* JoinAttack = Cast<UFlareQuestGeneratedJoinAttack2>(OngoingQuest);
+		if(JoinAttack)
+		{
+			TPair<FName, int32> Attack(JoinAttack->GetInitData()->GetName("sector"), JoinAttack->GetInitData()->GetInt32("attack-date"));
+
+			for(FName HostileCompanyName : JoinAttack->GetInitData()->GetNameArray("hostile-companies"))
 			{
-				continue;
+				MilitaryContracts.FindOrAdd(HostileCompanyName).AttackSectors.AddUnique(Attack);
 			}
+			continue;
+		}
 
-			return true;
+		UFlareQuestGeneratedSectorDefense2* SectorDefense = Cast<UFlareQuestGeneratedSectorDefense2>(OngoingQuest);
+		if(SectorDefense)
+		{
+			TPair<FName, int32> Attack(SectorDefense->GetInitData()->GetName("sector"), SectorDefense->GetInitData()->GetInt32("attack-date"));
+			MilitaryContracts.FindOrAdd(SectorDefense->GetInitData()->GetName("hostile-company")).AttackSectors.AddUnique(Attack);
 		}
 	}
-	return false;
+
+	MilitaryContractsDirty = false;
 }
 
 bool UFlareQuestManager::IsAllowedToDestroy(UFlareSimulatedSpacecraft const* Spacecraft)
@@ -180,8 +180,10 @@ public:
 
 	void NotifyNewQuests(TArray<UFlareQuest*>& Quests);
 
+	/** Free space kept aside by the available and ongoing quests in a station */
 	int32 GetReservedCapacity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource);
 
+	/** Resource quantity kept aside by the available and ongoing quests in a station */
 	int32 GetReservedQuantity(UFlareSimulatedSpacecraft* Station, FFlareResourceDescription* Resource);
 
    /*----------------------------------------------------
@@ -194,6 +196,9 @@ public:
 
 	void OnCallbackEvent(EFlareQuestCallback::Type EventType);
 
+	/** Check if a quest handles events with this tag, to avoid building events nobody listens to */
+	bool IsListeningEvent(FName Tag) const;
+
 	virtual void OnFlyShip(AFlareSpacecraft* Ship);
 
 	virtual void OnSectorActivation(UFlareSimulatedSector* Sector);
@@ -232,6 +237,12 @@ public:
 
 protected:
 
+	/** Get a callback list to modify, copied first if an event is iterating it */
+	TArray<UFlareQuest*>& GetWritableCallbacks(EFlareQuestCallback::Type EventType);
+
+	/** Check if a QUEST_EVENT quest handles this event */
+	bool IsQuestListeningEvent(UFlareQuest* Quest, const FFlareBundle& Bundle) const;
+
    /*----------------------------------------------------
 	   Protected data
    ----------------------------------------------------*/
@@ -253,7 +264,13 @@ protected:
 	
 	UFlareQuest*			                 SelectedQuest;
 
-	TMap<EFlareQuestCallback::Type, TArray<UFlareQuest*>> CallbacksMap;
+	/** Quests by callback. Events iterate a shared list without copying it, lists changed during an event are copied on write */
+	TMap<EFlareQuestCallback::Type, TSharedPtr<TArray<UFlareQuest*>>> CallbacksMap;
+
+	/** Event tags handled by each QUEST_EVENT quest, empty for any event */
+	TMap<UFlareQuest*, TArray<FName>>        QuestEventTags;
+	TMap<FName, int32>                       EventTagListenerCounts;
+	int32                                    AnyEventListenerCount;
 
 	FFlareQuestSave			                 QuestData;
 
@@ -266,21 +283,59 @@ protected:
 
 	TArray<UFlareQuest*>					 NewQuestAccumulator;
 
-	struct IsUnderMilitaryContractCacheEntry
+	/** What the ongoing military contracts allow against a company */
+	struct MilitaryContractRules
 	{
-		UFlareSimulatedSector const* Sector;
-		UFlareCompany const* Company;
-		float ExpireTime;
+		/** Hunted ships */
+		bool HuntLargeCargo;
+		bool HuntSmallCargo;
+		bool HuntMilitary;
+
+		/** Defended sectors */
+		TArray<FName> DefenseSectors;
+
+		/** Sectors attacked at a date */
+		TArray<TPair<FName, int32>> AttackSectors;
+
+		MilitaryContractRules()
+			: HuntLargeCargo(false)
+			, HuntSmallCargo(false)
+			, HuntMilitary(false)
+		{}
 	};
 
-	struct IsMilitaryTargetCacheEntry
-	{
-		UFlareSimulatedSpacecraft const* Spacecraft;
-		float ExpireTime;
-	};
+	/** Get the military contract rules against a company, NULL if there is none */
+	const MilitaryContractRules* GetMilitaryContractRules(UFlareCompany const* Company);
+
+	/** Index the ongoing military contracts by hostile company */
+	void UpdateMilitaryContracts();
+
+	/** Rules of the ongoing military contracts by hostile company, rebuilt when a quest changes state */
+	TMap<FName, MilitaryContractRules>       MilitaryContracts;
+	bool                                     MilitaryContractsDirty;
+
+	/** Recent positive answers stay true for a while, by expiration time */
+	TMap<TPair<UFlareSimulatedSector const*, UFlareCompany const*>, double> IsUnderMilitaryContractCache;
+	TMap<UFlareSimulatedSpacecraft const*, double> IsMilitaryTargetCache;
+
+	/** Hostility checks may come from the parallel AI planning */
+	FCriticalSection                         MilitaryCacheLock;
+
+	/** The available or ongoing quest lists changed */
+	void InvalidateCargoReservations();
+
+	/** Index the cargo reservations of the available and ongoing quests by station and resource */
+	void UpdateCargoReservations();
+
+	typedef TPair<FName, FFlareResourceDescription*> CargoReservationKey;
+
+	/** Reserved quantities and capacities by station immatriculation and resource, rebuilt when a quest changes state */
+	TMap<CargoReservationKey, int32>         ReservedQuantities;
+	TMap<CargoReservationKey, int32>         ReservedCapacities;
+	bool                                     CargoReservationsDirty;
 
-	TArray<IsUnderMilitaryContractCacheEntry> IsUnderMilitaryContractCache;
-	TArray<IsMilitaryTargetCacheEntry> IsMilitaryTargetCache;
+	/** Cargo queries may come from the parallel simulation */
+	FCriticalSection                         CargoReservationLock;
 
 public:
 
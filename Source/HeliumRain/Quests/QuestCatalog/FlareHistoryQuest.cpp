@@ -359,6 +359,7 @@ void UFlareQuestConditionVisitSector::Load(UFlareQuest* ParentQuest, UFlareSimul
 {
 	LoadInternal(ParentQuest);
 	Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+	EventTags.Add("travel-end");
 	Completed = false;
 	TargetSector = Sector;
 	InitialLabel = FText::Format(LOCTEXT("VisitSector", "Visit {0}"), TargetSector->GetSectorName());
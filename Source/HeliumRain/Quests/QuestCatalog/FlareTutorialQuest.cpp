@@ -845,6 +845,7 @@ void UFlareQuestTutorialNavigation::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("undock");
 		}));
 
 		Steps.Add(Step);
@@ -1460,6 +1461,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("toggle-combat");
 		}));
 
 		Steps.Add(Step);
@@ -1485,6 +1487,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("toggle-combat");
 		}));
 
 		Steps.Add(Step);
@@ -1510,6 +1513,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("activate-weapon");
 		}));
 
 		Steps.Add(Step);
@@ -1535,6 +1539,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("deactivate-weapon");
 		}));
 
 		Steps.Add(Step);
@@ -1561,6 +1566,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("fire-gun");
 		},  "FireWeaponcond1", 10));
 
 		Steps.Add(Step);
@@ -1614,6 +1620,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("hit-asteroid");
 		},  "HitAsteroidcond1", 20));
 
 		Steps.Add(Step);
@@ -1692,6 +1699,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("full-zoom");
 		}));
 
 		Steps.Add(Step);
@@ -1730,6 +1738,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("hit-ship");
 		}));
 
 		Steps.Add(Step);
@@ -1790,6 +1799,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("quick-switch");
 		},  "MultipleQuickSwitchcond1", 5));
 
 		Steps.Add(Step);
@@ -1842,6 +1852,7 @@ void UFlareQuestTutorialFighter::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("enemy-uncontrollable");
 		}));
 
 		Steps.Add(Step);
@@ -1915,6 +1926,7 @@ void UFlareQuestTutorialSplitFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("travel-end");
 		}));
 
 		Steps.Add(Step);
@@ -1948,6 +1960,7 @@ void UFlareQuestTutorialSplitFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("fleet-selected");
 		}));
 
 		Steps.Add(Step);
@@ -1973,6 +1986,7 @@ void UFlareQuestTutorialSplitFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("fleet-edited");
 		}));
 
 		Steps.Add(Step);
@@ -2090,6 +2104,7 @@ void UFlareQuestTutorialDistantFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("open-menu");
 		}));
 
 		Steps.Add(Step);
@@ -2143,6 +2158,7 @@ void UFlareQuestTutorialDistantFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("travel-end");
 		}));
 
 		Steps.Add(Step);
@@ -2196,6 +2212,7 @@ void UFlareQuestTutorialDistantFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("open-menu");
 		}));
 
 		Steps.Add(Step);
@@ -2350,6 +2367,7 @@ void UFlareQuestTutorialMergeFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("fleet-selected");
 		}));
 
 		Steps.Add(Step);
@@ -2375,6 +2393,7 @@ void UFlareQuestTutorialMergeFleet::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("fleet-edited");
 		}));
 
 		Steps.Add(Step);
@@ -2515,6 +2534,7 @@ void UFlareQuestTutorialTradeRoute::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("assign-fleet");
 		}));
 
 		Steps.Add(Step);
@@ -2540,6 +2560,7 @@ void UFlareQuestTutorialTradeRoute::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("trade-route-sector-add");
 		},  "AddTradeRouteSectorcond1", 2));
 
 		Steps.Add(Step);
@@ -2567,6 +2588,7 @@ void UFlareQuestTutorialTradeRoute::Load(UFlareQuestManager* Parent)
 		[](UFlareQuestCondition* Condition)
 		{
 			Condition->Callbacks.AddUnique(EFlareQuestCallback::QUEST_EVENT);
+			Condition->EventTags.Add("trade-route-transaction");
 		},  "TradeRouteProfitscond1", 5000));
 
 		Steps.Add(Step);
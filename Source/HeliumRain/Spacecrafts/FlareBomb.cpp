@@ -12,7 +12,7 @@
 #include "FlareWeapon.h"
 #include "FlareBombComponent.h"
 #include "FlareSpacecraft.h"
-#include "FlareShell.h"
+#include "FlareShellManager.h"
 
 #include "Components/DecalComponent.h"
 #include "Components/StaticMeshComponent.h"
@@ -405,7 +405,7 @@ void AFlareBomb::NotifyHit(class UPrimitiveComponent* MyComp, class AActor* Othe
 	AFlareAsteroid* Asteroid = Cast<AFlareAsteroid>(Other);
 	AFlareMeteorite* Meteorite = Cast<AFlareMeteorite>(Other);
 	AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(Other);
-	AFlareShell* Shell = Cast<AFlareShell>(Other);
+	AFlareShellManager* Shell = Cast<AFlareShellManager>(Other);
 	UFlareSpacecraftComponent* ShipComponent = Cast<UFlareSpacecraftComponent>(OtherComp);
 
 	// Forget uninteresting hits
@@ -26,10 +26,16 @@ bool PilotHelper::CheckFriendlyFire(UFlareSector* Sector, UFlareCompany* MyCompa
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_CheckFriendlyFire);
 
+	// Ammo can't meet a ship further than its own range plus the distance the ship travels until MaxDelay
+	FFlareSectorSpatialIndex& SpatialIndex = Sector->GetSpatialIndex();
+	float MaxRange = (AmmoVelocity + FireBaseVelocity.Size() + SpatialIndex.GetMaxSpacecraftSpeed()) * MaxDelay;
+	TArray<AActor*> Candidates;
+	SpatialIndex.QueryRadius(FireBaseLocation, MaxRange, EFlareSpatialBody::Spacecraft, Candidates);
+
 	//FLOG("CheckFriendlyFire");
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Candidates.Num(); SpacecraftIndex++)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(Candidates[SpacecraftIndex]);
 
 		if (SpacecraftCandidate)
 		{
@@ -91,70 +97,81 @@ bool PilotHelper::FindMostDangerousCollision(AActor*& MostDangerousCandidateActo
 	TArray<TFlareCollisionCandidate> Candidates;
 	TFlareCollisionCandidate Candidate;
 
-	// Select dangerous ships
-	for (auto SpacecraftCandidate : ActiveSector->GetSpacecrafts())
+	// Input data for danger processing
+	FBox ShipBox = Ship->GetComponentsBoundingBox();
+	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
+	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
+	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
+	float MaxRelevanceDistance = 200 * CurrentSize;
+
+	// Only bodies near enough can be relevant
+	TArray<AActor*> NearbyBodies;
+	ActiveSector->GetSpatialIndex().QueryRadius(CurrentLocation, MaxRelevanceDistance,
+		EFlareSpatialBody::Spacecraft | EFlareSpatialBody::Asteroid | EFlareSpatialBody::Meteorite | EFlareSpatialBody::Collider, NearbyBodies);
+
+	// Bodies come in the sector list order : ships, asteroids, meteorites, colliders
+	for (AActor* NearbyBody : NearbyBodies)
 	{
-		if (SpacecraftCandidate != Ship
-		 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
-		 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
-		 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
-		 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
-		 && !(Ship->GetSize() == EFlarePartSize::L
-			  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
-			  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
-			  && SpacecraftCandidate->IsHostile(Ship->GetCompany()))
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
-		&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
-		)
+		AFlareSpacecraft* SpacecraftCandidate = Cast<AFlareSpacecraft>(NearbyBody);
+		AFlareAsteroid* AsteroidCandidate = Cast<AFlareAsteroid>(NearbyBody);
+		AFlareMeteorite* MeteoriteCandidate = Cast<AFlareMeteorite>(NearbyBody);
+
+		// Select dangerous ships
+		if (SpacecraftCandidate)
 		{
-			Candidate.Key = SpacecraftCandidate;
-			Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
+			if (SpacecraftCandidate != Ship
+			 && SpacecraftCandidate != IgnoreConfig.SpacecraftToIgnore
+			 && !(IgnoreConfig.IgnoreAllStations && SpacecraftCandidate->IsStation())
+			 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
+			 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate)
+			 && !(Ship->GetSize() == EFlarePartSize::L
+				  && SpacecraftCandidate->GetSize() == EFlarePartSize::S
+				  && IsTargetDangerous(PilotTarget(SpacecraftCandidate))
+				  && SpacecraftCandidate->IsHostile(Ship->GetCompany()))
+			&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplexElement() && SpacecraftCandidate->GetParent() == IgnoreConfig.SpacecraftToIgnore->GetParent()->GetComplexMaster())
+			&& !(IgnoreConfig.SpacecraftToIgnore && IgnoreConfig.SpacecraftToIgnore->IsStation() && IgnoreConfig.SpacecraftToIgnore->GetParent()->IsComplex() && SpacecraftCandidate->GetParent()->GetComplexMaster() == IgnoreConfig.SpacecraftToIgnore->GetParent())
+			)
+			{
+				Candidate.Key = SpacecraftCandidate;
+				Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
+				Candidates.Add(Candidate);
+			}
+		}
+
+		// Select dangerous asteroids
+		else if (AsteroidCandidate)
+		{
+			Candidate.Key = AsteroidCandidate;
+			Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
 			Candidates.Add(Candidate);
 		}
-	}
 
-	// Select dangerous asteroids
-	for (auto AsteroidCandidate : ActiveSector->GetAsteroids())
-	{
-		Candidate.Key = AsteroidCandidate;
-		Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
-		Candidates.Add(Candidate);
-	}
+		// Select dangerous meteorites
+		else if (MeteoriteCandidate)
+		{
+			if (!MeteoriteCandidate->IsBroken())
+			{
+				Candidate.Key = MeteoriteCandidate;
+				Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
+				Candidates.Add(Candidate);
+			}
+		}
 
-	// Select dangerous meteorites
-	for (auto MeteoriteCandidate : ActiveSector->GetMeteorites())
-	{
-		if(!MeteoriteCandidate->IsBroken())
+		// Select dangerous colliders
+		else
 		{
-			Candidate.Key = MeteoriteCandidate;
-			Candidate.Value = MeteoriteCandidate->GetMeteoriteComponent()->GetPhysicsLinearVelocity();
+			Candidate.Key = NearbyBody;
+			Candidate.Value = FVector::ZeroVector;
 			Candidates.Add(Candidate);
 		}
 	}
 
-	// Select dangerous colliders
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(Ship->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (auto ColliderCandidate : ColliderActorList)
-	{
-		Candidate.Key = Cast<AFlareCollider>(ColliderCandidate);
-		Candidate.Value = FVector::ZeroVector;
-		Candidates.Add(Candidate);
-	}
-
 	// No candidate found, return
 	if (Candidates.Num() == 0)
 	{
 		return false;
 	}
 
-	// Input data for danger processing
-	FBox ShipBox = Ship->GetComponentsBoundingBox();
-	FVector CurrentVelocity = Ship->GetLinearVelocity() * 100;
-	FVector CurrentLocation = (ShipBox.Max + ShipBox.Min) / 2.0;
-	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
-	float MaxRelevanceDistance = 200 * CurrentSize;
-
 	// Output data
 	MostDangerousCandidateActor = NULL;
 
@@ -454,12 +471,10 @@ PilotHelper::PilotTarget PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, stru
 		}
 
 		// Divise by 25 the stateScore per current incoming missile
-		for (AFlareBomb* Bomb : Ship->GetGame()->GetActiveSector()->GetBombs())
+		int32 IncomingBombCount = Ship->GetGame()->GetActiveSector()->GetIncomingBombCount(ShipCandidate);
+		for (int32 BombIndex = 0; BombIndex < IncomingBombCount; BombIndex++)
 		{
-			if (Bomb->GetTargetSpacecraft() == ShipCandidate && Bomb->IsActive())
-			{
-				StateScore /= 25;
-			}
+			StateScore /= 25;
 		}
 
 		if(ShipCandidate->GetParent()->IsHarpooned()) {
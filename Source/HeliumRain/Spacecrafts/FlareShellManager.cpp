@@ -0,0 +1,936 @@
+
+#include "FlareShellManager.h"
+#include "../Flare.h"
+
+#include "FlareSpacecraft.h"
+
+#include "../Game/FlareGame.h"
+#include "../Game/FlareSector.h"
+#include "../Game/FlareGameTypes.h"
+#include "../Game/FlareSkirmishManager.h"
+
+#include "../Player/FlarePlayerController.h"
+
+#include "Components/DecalComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine.h"
+
+
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Tick"), STAT_ShellManager_Tick, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Move"), STAT_ShellManager_Move, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Collisions"), STAT_ShellManager_Collisions, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Tracers"), STAT_ShellManager_Tracers, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+AFlareShellManager::AFlareShellManager(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	ShellRoot = PCIP.CreateDefaultSubobject<USceneComponent>(this, TEXT("Root"));
+	RootComponent = ShellRoot;
+
+	// Settings
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+	HasDestroyedShells = false;
+	NextShellIdentifier = 0;
+	Sector = NULL;
+	PC = NULL;
+}
+
+
+/*----------------------------------------------------
+	Gameplay
+----------------------------------------------------*/
+
+void AFlareShellManager::Initialize(UFlareSector* ParentSector)
+{
+	Sector = ParentSector;
+	PC = Sector->GetGame()->GetPC();
+}
+
+void AFlareShellManager::FireShell(UFlareWeapon* Weapon, const FFlareSpacecraftComponentDescription* Description, FVector Location, FVector ShootDirection, FVector ParentVelocity,
+	bool Tracer, float SecureTime, float ActiveTime)
+{
+	// Can't exist without description, can't return
+	FCHECK(Description);
+
+	float AmmoVelocity = Description->WeaponCharacteristics.GunCharacteristics.AmmoVelocity;
+	float KineticEnergy = Description->WeaponCharacteristics.GunCharacteristics.KineticEnergy;
+
+	FVector Velocity = ParentVelocity + ShootDirection * AmmoVelocity * 100;
+	float LifeSpan = Description->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / Velocity.Size(); // 10km
+
+	ShellLocations.Add(Location);
+	ShellVelocities.Add(Velocity);
+	ShellLifeSpans.Add(LifeSpan);
+	ShellInitialLifeSpans.Add(LifeSpan);
+	ShellMasses.Add(2 * KineticEnergy * 1000 / FMath::Square(AmmoVelocity)); // ShellPower is in Kilo-Joule, reverse kinetic energy equation
+	ShellSecureTimes.Add(SecureTime);
+	ShellActiveTimes.Add(ActiveTime);
+	ShellMinEffectiveDistances.Add(0.f);
+	ShellArmed.Add(false);
+	ShellManualTurret.Add(Weapon->GetSpacecraft()->GetWeaponsSystem()->GetActiveWeaponType() == EFlareWeaponGroupType::WG_TURRET);
+	ShellDestroyed.Add(false);
+	ShellIdentifiers.Add(NextShellIdentifier++);
+	ShellDescriptions.Add(Description);
+	ShellWeapons.Add(Weapon);
+
+	// Show the flight effects
+	UParticleSystem* TracerTemplate = Description->WeaponCharacteristics.GunCharacteristics.TracerEffect;
+	if (Tracer && TracerTemplate)
+	{
+		ShellTracers.Add(GetTracer(TracerTemplate));
+		UpdateTracer(ShellLocations.Num() - 1);
+		ShellTracers.Last()->ActivateSystem(true);
+	}
+	else
+	{
+		ShellTracers.Add(NULL);
+	}
+}
+
+void AFlareShellManager::Tick(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShellManager_Tick);
+
+	Super::Tick(DeltaSeconds);
+
+	int32 ShellCount = ShellLocations.Num();
+	if (ShellCount == 0 || !Sector)
+	{
+		return;
+	}
+
+	// Move all shells in one pass
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ShellManager_Move);
+
+		PreviousLocations.Reset();
+		PreviousLocations.Append(ShellLocations);
+
+		FVector* Locations = ShellLocations.GetData();
+		const FVector* Velocities = ShellVelocities.GetData();
+		float* LifeSpans = ShellLifeSpans.GetData();
+
+		for (int32 ShellIndex = 0; ShellIndex < ShellCount; ShellIndex++)
+		{
+			Locations[ShellIndex] += Velocities[ShellIndex] * DeltaSeconds;
+			LifeSpans[ShellIndex] -= DeltaSeconds;
+		}
+	}
+
+	// Impacts and proximity fuzes, only traced when a body is near the shell path
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ShellManager_Collisions);
+
+		FFlareSectorSpatialIndex& SpatialIndex = Sector->GetSpatialIndex();
+		TArray<AActor*> NearbyBodies;
+
+		// Damage may end the sector and clear the shells
+		for (int32 ShellIndex = 0; ShellIndex < ShellCount && ShellCount <= ShellLocations.Num(); ShellIndex++)
+		{
+			if (ShellDestroyed[ShellIndex])
+			{
+				continue;
+			}
+			else if (ShellInitialLifeSpans[ShellIndex] > 0 && ShellLifeSpans[ShellIndex] <= 0)
+			{
+				DestroyShell(ShellIndex);
+				continue;
+			}
+
+			FVector ActorLocation = PreviousLocations[ShellIndex];
+			FVector NextActorLocation = ShellLocations[ShellIndex];
+
+			SpatialIndex.QueryRadius((ActorLocation + NextActorLocation) / 2, FVector::Dist(ActorLocation, NextActorLocation) / 2, EFlareSpatialBody::All, NearbyBodies);
+			if (NearbyBodies.Num())
+			{
+				FHitResult HitResult(ForceInit);
+				if (Trace(ShellIndex, ActorLocation, NextActorLocation, HitResult))
+				{
+					OnImpact(ShellIndex, HitResult, ShellVelocities[ShellIndex]);
+				}
+			}
+
+			if (!ShellDestroyed[ShellIndex] && ShellDescriptions[ShellIndex]->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity)
+			{
+				if (ShellSecureTimes[ShellIndex] > 0)
+				{
+					ShellSecureTimes[ShellIndex] -= DeltaSeconds;
+				}
+				else if (ShellActiveTimes[ShellIndex] > 0)
+				{
+					CheckFuze(ShellIndex, ActorLocation, NextActorLocation);
+					ShellActiveTimes[ShellIndex] -= DeltaSeconds;
+				}
+			}
+		}
+	}
+
+	// Remove destroyed shells from the end, so that swapped shells were already processed
+	if (HasDestroyedShells)
+	{
+		for (int32 ShellIndex = ShellLocations.Num() - 1; ShellIndex >= 0; ShellIndex--)
+		{
+			if (ShellDestroyed[ShellIndex])
+			{
+				RemoveShell(ShellIndex);
+			}
+		}
+		HasDestroyedShells = false;
+	}
+
+	// Tracers
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ShellManager_Tracers);
+
+		for (int32 ShellIndex = 0; ShellIndex < ShellLocations.Num(); ShellIndex++)
+		{
+			if (ShellTracers[ShellIndex])
+			{
+				UpdateTracer(ShellIndex);
+			}
+		}
+	}
+}
+
+void AFlareShellManager::UpdateTracer(int32 ShellIndex)
+{
+	FVector Location = ShellLocations[ShellIndex];
+
+	// 1 at 100m or less
+	float Scale = 1;
+	float BaseDistance = 10000.f;
+	float MinScale = 0.1f;
+	if (PC && PC->GetShipPawn())
+	{
+		float LifeRatioScale = 1.f;
+
+		if (ShellInitialLifeSpans[ShellIndex] > 0)
+		{
+			float LifeRatio = ShellLifeSpans[ShellIndex] / ShellInitialLifeSpans[ShellIndex];
+			if (LifeRatio < 0.1f)
+			{
+				LifeRatioScale = LifeRatio * 10.f;
+			}
+		}
+
+		float Distance = (Location - PC->GetShipPawn()->GetActorLocation()).Size();
+		if (Distance > BaseDistance)
+		{
+			Scale = (Distance / BaseDistance) * ((1.f - MinScale) * BaseDistance / Distance + MinScale) * LifeRatioScale;
+		}
+	}
+
+	ShellTracers[ShellIndex]->SetWorldTransform(FTransform(ShellVelocities[ShellIndex].Rotation(), Location, FVector(0.6 + Scale * 0.4, Scale, Scale)));
+}
+
+void AFlareShellManager::DestroyShell(int32 ShellIndex)
+{
+	ShellDestroyed[ShellIndex] = true;
+	HasDestroyedShells = true;
+}
+
+void AFlareShellManager::RemoveShell(int32 ShellIndex)
+{
+	if (ShellTracers[ShellIndex])
+	{
+		ReleaseTracer(ShellTracers[ShellIndex]);
+	}
+
+	ShellLocations.RemoveAtSwap(ShellIndex, 1, false);
+	ShellVelocities.RemoveAtSwap(ShellIndex, 1, false);
+	ShellLifeSpans.RemoveAtSwap(ShellIndex, 1, false);
+	ShellInitialLifeSpans.RemoveAtSwap(ShellIndex, 1, false);
+	ShellMasses.RemoveAtSwap(ShellIndex, 1, false);
+	ShellSecureTimes.RemoveAtSwap(ShellIndex, 1, false);
+	ShellActiveTimes.RemoveAtSwap(ShellIndex, 1, false);
+	ShellMinEffectiveDistances.RemoveAtSwap(ShellIndex, 1, false);
+	ShellArmed.RemoveAtSwap(ShellIndex, 1, false);
+	ShellManualTurret.RemoveAtSwap(ShellIndex, 1, false);
+	ShellDestroyed.RemoveAtSwap(ShellIndex, 1, false);
+	ShellIdentifiers.RemoveAtSwap(ShellIndex, 1, false);
+	ShellDescriptions.RemoveAtSwap(ShellIndex, 1, false);
+	ShellWeapons.RemoveAtSwap(ShellIndex, 1, false);
+	ShellTracers.RemoveAtSwap(ShellIndex, 1, false);
+}
+
+void AFlareShellManager::ClearShells()
+{
+	for (UParticleSystemComponent* Tracer : ShellTracers)
+	{
+		if (Tracer)
+		{
+			ReleaseTracer(Tracer);
+		}
+	}
+
+	ShellLocations.Empty();
+	ShellVelocities.Empty();
+	ShellLifeSpans.Empty();
+	ShellInitialLifeSpans.Empty();
+	ShellMasses.Empty();
+	ShellSecureTimes.Empty();
+	ShellActiveTimes.Empty();
+	ShellMinEffectiveDistances.Empty();
+	ShellArmed.Empty();
+	ShellManualTurret.Empty();
+	ShellDestroyed.Empty();
+	ShellIdentifiers.Empty();
+	ShellDescriptions.Empty();
+	ShellWeapons.Empty();
+	ShellTracers.Empty();
+	HasDestroyedShells = false;
+}
+
+FString AFlareShellManager::GetShellName(int32 ShellIndex) const
+{
+	return FString::Printf(TEXT("FlareShell_%u"), ShellIdentifiers[ShellIndex]);
+}
+
+
+/*----------------------------------------------------
+	Tracers
+----------------------------------------------------*/
+
+UParticleSystemComponent* AFlareShellManager::GetTracer(UParticleSystem* Template)
+{
+	UParticleSystemComponent* Tracer = NULL;
+
+	// Reuse an emitter, preferably with the same template
+	TArray<UParticleSystemComponent*>* Pool = TracerPools.Find(Template);
+	if (Pool && Pool->Num())
+	{
+		Tracer = Pool->Pop(false);
+	}
+	else
+	{
+		for (auto& OtherPool : TracerPools)
+		{
+			if (OtherPool.Value.Num())
+			{
+				Tracer = OtherPool.Value.Pop(false);
+				Tracer->SetTemplate(Template);
+				break;
+			}
+		}
+	}
+
+	// Create a new emitter
+	if (!Tracer)
+	{
+		Tracer = NewObject<UParticleSystemComponent>(this);
+		Tracer->bAutoActivate = false;
+		Tracer->bAutoDestroy = false;
+		Tracer->SetupAttachment(ShellRoot);
+		Tracer->SetAbsolute(true, true, true);
+		Tracer->SetTemplate(Template);
+		Tracer->RegisterComponent();
+		Tracers.Add(Tracer);
+	}
+
+	return Tracer;
+}
+
+void AFlareShellManager::ReleaseTracer(UParticleSystemComponent* Tracer)
+{
+	Tracer->DeactivateSystem();
+	Tracer->KillParticlesForced();
+	TracerPools.FindOrAdd(Tracer->Template).Add(Tracer);
+}
+
+
+/*----------------------------------------------------
+	Shell behaviour
+----------------------------------------------------*/
+
+void AFlareShellManager::CheckTargets(const TArray<AActor*>& Candidates, TFunctionRef<void(PilotHelper::PilotTarget)> CheckTarget)
+{
+	// Detonations can destroy candidates while iterating, skip them
+	for (AActor* Candidate : Candidates)
+	{
+		if (Candidate->IsPendingKill())
+		{
+			continue;
+		}
+
+		AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(Candidate);
+		AFlareBomb* Bomb = Cast<AFlareBomb>(Candidate);
+
+		if (Spacecraft)
+		{
+			CheckTarget(PilotHelper::PilotTarget(Spacecraft));
+		}
+		else if (Bomb)
+		{
+			CheckTarget(PilotHelper::PilotTarget(Bomb));
+		}
+		else
+		{
+			CheckTarget(PilotHelper::PilotTarget(Cast<AFlareMeteorite>(Candidate)));
+		}
+	}
+}
+
+void AFlareShellManager::CheckFuze(int32 ShellIndex, FVector ActorLocation, FVector NextActorLocation)
+{
+	const FFlareSpacecraftComponentDescription* Description = ShellDescriptions[ShellIndex];
+	UFlareWeapon* Weapon = ShellWeapons[ShellIndex];
+	FVector Center = (NextActorLocation + ActorLocation) / 2;
+	float NearThresoldSquared = FMath::Square(100000); // 1km
+
+	auto CheckTarget = [&](PilotHelper::PilotTarget TargetCandidate)
+	{
+		if (ShellDestroyed[ShellIndex])
+		{
+			// Already detonated
+			return;
+		}
+
+		if (TargetCandidate.Is(Weapon->GetSpacecraft()))
+		{
+			// Ignore parent spacecraft
+			return;
+		}
+
+		// First check if near to filter distant ship
+		if ((Center - TargetCandidate.GetActorLocation()).SizeSquared() > NearThresoldSquared)
+		{
+			return;
+		}
+
+		//FLOG("=================");
+		//FLOGV("Proximity fuze near ship for %s",*GetHumanReadableName());
+
+
+		FVector ShellDirection = ShellVelocities[ShellIndex].GetUnsafeNormal();
+		FVector CandidateOffset = TargetCandidate.GetActorLocation() - ActorLocation;
+		FVector NextCandidateOffset = TargetCandidate.GetActorLocation() - NextActorLocation;
+
+		// Min distance
+		float MinDistance = FVector::CrossProduct(CandidateOffset, ShellDirection).Size() / ShellDirection.Size();
+
+		// Check if the min distance is not in the past
+		if (FVector::DotProduct(CandidateOffset, ShellDirection) < 0)
+		{
+			// The target is behind the shell
+			MinDistance = CandidateOffset.Size();
+		}
+
+		bool MinInFuture = false;
+		// Check if the min distance is not in the future
+		if (FVector::DotProduct(NextCandidateOffset, ShellDirection) > 0)
+		{
+			// The target is before the shell
+			MinDistance = NextCandidateOffset.Size();
+			MinInFuture = true;
+		}
+
+
+
+		float DistanceToMinDistancePoint;
+		if (CandidateOffset.Size() == MinDistance)
+		{
+			DistanceToMinDistancePoint = 0;
+		}
+		else if (NextCandidateOffset.Size() == MinDistance)
+		{
+			DistanceToMinDistancePoint = (NextActorLocation - ActorLocation).Size();
+		}
+		else
+		{
+			DistanceToMinDistancePoint = FMath::Sqrt(CandidateOffset.SizeSquared() - FMath::Square(MinDistance));
+		}
+
+		/*FLOGV("ShipCandidate->GetMeshScale() %f",TargetCandidate.GetMeshScale());
+		FLOGV("DistanceToMinDistancePoint %f",DistanceToMinDistancePoint);
+		FLOGV("Step distance %f",(NextActorLocation - ActorLocation).Size());
+		FLOGV("MinDistance %f",MinDistance);
+		FLOGV("Start Distance %f",(ActorLocation - TargetCandidate.GetActorLocation()).Size());
+		FLOGV("End Distance %f",(NextActorLocation - TargetCandidate.GetActorLocation()).Size());*/
+
+
+		// Check if need to detonnate
+		float EffectiveDistance = MinDistance - TargetCandidate.GetMeshScale();
+
+
+		if (EffectiveDistance < Description->WeaponCharacteristics.FuzeMinDistanceThresold *100)
+		{
+			// Detonate because of too near. Find the detonate point.
+
+
+			float MinThresoldDistance = Description->WeaponCharacteristics.FuzeMinDistanceThresold *100 + TargetCandidate.GetMeshScale();
+
+		// 	FLOGV("MinThresoldDistance %f",MinThresoldDistance);
+			float DistanceToMinThresoldDistancePoint = FMath::Sqrt(FMath::Square(MinThresoldDistance) - FMath::Square(MinDistance));
+		// 	FLOGV("DistanceToMinThresoldDistancePoint %f",DistanceToMinThresoldDistancePoint);
+
+			float DistanceToDetonatePoint = DistanceToMinDistancePoint - DistanceToMinThresoldDistancePoint;
+		// 	FLOGV("DistanceToDetonatePoint %f",DistanceToDetonatePoint);
+			FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToDetonatePoint;
+
+			DetonateAt(ShellIndex, DetonatePoint);
+		}
+		else if (ShellArmed[ShellIndex] && EffectiveDistance > ShellMinEffectiveDistances[ShellIndex])
+		{
+			// We are armed and the distance as increase, detonate at nearest point
+			FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToMinDistancePoint;
+			DetonateAt(ShellIndex, DetonatePoint);
+		}
+		else if (EffectiveDistance < Description->WeaponCharacteristics.FuzeMaxDistanceThresold *100)
+		{
+			if (MinInFuture)
+			{
+				// In activation zone but we will be near in future, arm the fuze
+				ShellArmed[ShellIndex] = true;
+				ShellMinEffectiveDistances[ShellIndex] = EffectiveDistance;
+			}
+			else
+			{
+				// In activation zone and the min distance is reach in this step, detonate
+				FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToMinDistancePoint;
+			// 	FLOGV("DistanceToMinDistancePoint %f",DistanceToMinDistancePoint);
+				DetonateAt(ShellIndex, DetonatePoint);
+			}
+		}
+	};
+
+	// Check targets near the shell path
+	TArray<AActor*> Candidates;
+	Sector->GetSpatialIndex().QueryRadius(Center, 100000, EFlareSpatialBody::Spacecraft | EFlareSpatialBody::Bomb | EFlareSpatialBody::Meteorite, Candidates);
+	CheckTargets(Candidates, CheckTarget);
+}
+
+
+void AFlareShellManager::OnImpact(int32 ShellIndex, const FHitResult& HitResult, const FVector& HitVelocity)
+{
+	const FFlareSpacecraftComponentDescription* Description = ShellDescriptions[ShellIndex];
+	UFlareWeapon* Weapon = ShellWeapons[ShellIndex];
+	bool DestroyProjectile = true;
+	
+	if (HitResult.Actor.IsValid() && HitResult.Component.IsValid())
+	{
+		// Compute projectile energy.
+		FVector ProjectileVelocity = HitVelocity / 100;
+		FVector TargetVelocity = HitResult.Component->GetPhysicsLinearVelocity() / 100;
+		FVector ImpactVelocity = ProjectileVelocity - TargetVelocity;
+		FVector ImpactVelocityAxis = ImpactVelocity.GetUnsafeNormal();
+	
+		// Compute parameters
+		float ShellEnergy = 0.5f * ShellMasses[ShellIndex] * ImpactVelocity.SizeSquared() / 1000; // Damage in KJ
+		
+
+		float AbsorbedEnergy = ApplyDamage(ShellIndex, HitResult.Actor.Get(), HitResult.GetComponent(), HitResult.Location, ImpactVelocityAxis, HitResult.ImpactNormal, ShellEnergy, Description->WeaponCharacteristics.AmmoDamageRadius, EFlareDamage::DAM_ArmorPiercing);
+		bool Richochet = (AbsorbedEnergy < ShellEnergy);
+
+		if (Richochet)
+		{
+			DestroyProjectile = false;
+			float RemainingEnergy = ShellEnergy - AbsorbedEnergy;
+			float RemainingVelocity = FMath::Sqrt(2 * RemainingEnergy * 1000 / ShellMasses[ShellIndex]);
+			FVector BounceDirection = ShellVelocities[ShellIndex].GetUnsafeNormal().MirrorByVector(HitResult.ImpactNormal);
+			ShellVelocities[ShellIndex] = BounceDirection * RemainingVelocity * 100;
+			ShellLocations[ShellIndex] = HitResult.Location;
+		}
+		else
+		{
+			AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(HitResult.Actor.Get());
+			if (Description->WeaponCharacteristics.DamageType == EFlareShellDamageType::HEAT)
+			{
+				AFlareAsteroid* Asteroid = Cast<AFlareAsteroid>(HitResult.Actor.Get());
+				AFlareMeteorite* Meteorite = Cast<AFlareMeteorite>(HitResult.Actor.Get());
+				if (Spacecraft)
+				{
+					Spacecraft->GetDamageSystem()->ApplyDamage(Description->WeaponCharacteristics.ExplosionPower,
+						Description->WeaponCharacteristics.AmmoDamageRadius, HitResult.Location, EFlareDamage::DAM_HEAT, Weapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+
+					float ImpulseForce = 1000 * Description->WeaponCharacteristics.ExplosionPower * Description->WeaponCharacteristics.AmmoDamageRadius;
+
+					// Physics impulse
+					Spacecraft->Airframe->AddImpulseAtLocation( ShellVelocities[ShellIndex].GetUnsafeNormal(), HitResult.Location);
+				}
+				else if (Asteroid)
+				{
+					float ImpulseForce = 1000 * Description->WeaponCharacteristics.ExplosionPower * Description->WeaponCharacteristics.AmmoDamageRadius;
+					Asteroid->GetAsteroidComponent()->AddImpulseAtLocation( ShellVelocities[ShellIndex].GetUnsafeNormal(), HitResult.Location);
+				}
+				else if (Meteorite)
+				{
+					float ImpulseForce = 1000 * Description->WeaponCharacteristics.ExplosionPower * Description->WeaponCharacteristics.AmmoDamageRadius;
+					Meteorite->GetMeteoriteComponent()->AddImpulseAtLocation( ShellVelocities[ShellIndex].GetUnsafeNormal(), HitResult.Location);
+					Meteorite->ApplyDamage(Description->WeaponCharacteristics.ExplosionPower,
+										   Description->WeaponCharacteristics.AmmoDamageRadius, HitResult.Location, EFlareDamage::DAM_HEAT, Weapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+				}
+
+			}
+
+			// Spawn penetration effect
+			if(!(Spacecraft && Spacecraft->GetCameraMode() == EFlareCameraMode::Immersive))
+			{
+				UParticleSystemComponent* PSC = UGameplayStatics::SpawnEmitterAttached(
+					Description->WeaponCharacteristics.ExplosionEffect,
+					HitResult.GetComponent(),
+					NAME_None,
+					HitResult.Location,
+					HitResult.ImpactNormal.Rotation(),
+					EAttachLocation::KeepWorldPosition,
+					true);
+				if (PSC)
+				{
+					PSC->SetWorldScale3D(Description->WeaponCharacteristics.ExplosionEffectScale * FVector(1, 1, 1));
+				}
+			}
+
+			// Spawn hull damage effect
+			UFlareSpacecraftComponent* HullComp = Cast<UFlareSpacecraftComponent>(HitResult.GetComponent());
+			if (HullComp)
+			{
+				HullComp->StartDamagedEffect(HitResult.Location, HitResult.ImpactNormal.Rotation(), Weapon->GetDescription()->Size);
+			}
+
+		}
+	}
+
+	if (DestroyProjectile)
+	{
+		DestroyShell(ShellIndex);
+	}
+}
+
+void AFlareShellManager::DetonateAt(int32 ShellIndex, FVector DetonatePoint)
+{
+	const FFlareSpacecraftComponentDescription* Description = ShellDescriptions[ShellIndex];
+	UFlareWeapon* Weapon = ShellWeapons[ShellIndex];
+
+	UGameplayStatics::SpawnEmitterAtLocation(this,
+		Description->WeaponCharacteristics.ExplosionEffect,
+		DetonatePoint);
+	auto CheckTarget = [&](PilotHelper::PilotTarget Target)
+	{
+		//FLOGV("DetonateAt CheckTarget for %s",*Target.GetActor()->GetName());
+
+		// First check if in radius area
+		FVector CandidateOffset = Target.GetActorLocation() - DetonatePoint;
+		float CandidateDistance = CandidateOffset.Size();
+		float CandidateSize = Target.GetMeshScale();
+
+		if (CandidateDistance > Description->WeaponCharacteristics.AmmoExplosionRadius * 100 + CandidateSize)
+		{
+			//FLOG("Too far");
+			return;
+		}
+
+		// DrawDebugSphere(Weapon->GetSpacecraft()->GetWorld(), ShipCandidate->GetActorLocation(), CandidateSize, 12, FColor::Magenta, true);
+
+		//FLOGV("CandidateOffset at %s",*CandidateOffset.ToString());
+
+		// Find exposed surface
+		// Apparent radius
+		float ApparentRadius = FMath::Sqrt(FMath::Square(CandidateDistance) + FMath::Square(CandidateSize));
+
+		float Angle = FMath::Acos(CandidateDistance/ApparentRadius);
+
+		// DrawDebugSphere(Weapon->GetSpacecraft()->GetWorld(), DetonatePoint, ApparentRadius, 12, FColor::Yellow, true);
+
+		float ExposedSurface = 2 * PI * ApparentRadius * (ApparentRadius - CandidateDistance);
+		float TotalSurface = 4 * PI * FMath::Square(ApparentRadius);
+
+		float ExposedSurfaceRatio = ExposedSurface / TotalSurface;
+
+
+		int FragmentCount =  FMath::RandRange(0,2) + Description->WeaponCharacteristics.AmmoFragmentCount * ExposedSurfaceRatio;
+
+		/*FLOGV("CandidateDistance %f",CandidateDistance);
+		FLOGV("CandidateSize %f",CandidateSize);
+		FLOGV("ApparentRadius %f",ApparentRadius);
+		FLOGV("Angle %f",FMath::RadiansToDegrees(Angle));
+		FLOGV("ExposedSurface %f",ExposedSurface);
+		FLOGV("TotalSurface %f",TotalSurface);
+		FLOGV("ExposedSurfaceRatio %f",ExposedSurfaceRatio);
+		FLOGV("FragmentCount %d",FragmentCount);*/
+
+		TArray<UActorComponent*> Components = Target.GetActor()->GetComponentsByClass(UPrimitiveComponent::StaticClass());
+
+		//FLOGV("Component cont %d",Components.Num());
+		for (int i = 0; i < FragmentCount; i ++)
+		{
+
+			FVector HitDirection = FMath::VRandCone(CandidateOffset, Angle);
+
+			bool HasHit = false;
+			FHitResult BestHitResult;
+			float BestHitDistance = 0;
+
+			for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+			{
+				UPrimitiveComponent* Component = Cast<UPrimitiveComponent>(Components[ComponentIndex]);
+				if (Component)
+				{
+					FHitResult HitResult(ForceInit);
+					FCollisionQueryParams TraceParams(FName(TEXT("Fragment Trace")), true, this);
+					TraceParams.bTraceComplex = true;
+					TraceParams.bReturnPhysicalMaterial = false;
+					Component->LineTraceComponent(HitResult, DetonatePoint, DetonatePoint + HitDirection * 2* CandidateDistance, TraceParams);
+
+					if (HitResult.Actor.IsValid()){
+						float HitDistance = (HitResult.Location - DetonatePoint).Size();
+						if (!HasHit || HitDistance < BestHitDistance)
+						{
+							BestHitDistance = HitDistance;
+							BestHitResult = HitResult;
+						}
+
+						//FLOGV("Fragment %d hit %s at a distance=%f",i, *Component->GetReadableName(), HitDistance);
+						HasHit = true;
+					}
+				}
+
+			}
+
+			if (HasHit)
+			{
+				//UKismetSystemLibrary::DrawDebugLine(Weapon->GetSpacecraft()->GetWorld(), DetonatePoint, BestHitResult.Location, FColor::Green, 1000.f);
+
+				AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(BestHitResult.Actor.Get());
+				AFlareBomb* Bomb = Cast<AFlareBomb>(BestHitResult.Actor.Get());
+				AFlareMeteorite* Meteorite = Cast<AFlareMeteorite>(BestHitResult.Actor.Get());
+
+				if (Spacecraft)
+				{
+					float FragmentPowerEffet = FMath::FRandRange(0.f, 2.f);
+					float FragmentRangeEffet = FMath::FRandRange(0.5f, 1.5f);
+					ApplyDamage(ShellIndex, Spacecraft, BestHitResult.GetComponent()
+								, BestHitResult.Location
+								, HitDirection
+								, BestHitResult.ImpactNormal
+								, FragmentPowerEffet * Description->WeaponCharacteristics.ExplosionPower
+								, FragmentRangeEffet  * Description->WeaponCharacteristics.AmmoDamageRadius
+								, EFlareDamage::DAM_HighExplosive);
+
+					// Play sound
+					AFlareSpacecraftPawn* SpacecraftPawn = Cast<AFlareSpacecraftPawn>(Spacecraft);
+					if (SpacecraftPawn->IsPlayerShip())
+					{
+						SpacecraftPawn->GetPC()->PlayLocalizedSound(Description->WeaponCharacteristics.ImpactSound, BestHitResult.Location, BestHitResult.GetComponent());
+					}
+				}
+				else if (Bomb)
+				{
+					Bomb->OnBombDetonated(nullptr, nullptr, BestHitResult.Location, BestHitResult.ImpactNormal);
+				}
+				else if (Meteorite)
+				{
+					float FragmentPowerEffet = FMath::FRandRange(0.f, 2.f);
+					float FragmentRangeEffet = FMath::FRandRange(0.5f, 1.5f);
+					ApplyDamage(ShellIndex, Meteorite, BestHitResult.GetComponent()
+								, BestHitResult.Location
+								, HitDirection
+								, BestHitResult.ImpactNormal
+								, FragmentPowerEffet * Description->WeaponCharacteristics.ExplosionPower
+								, FragmentRangeEffet  * Description->WeaponCharacteristics.AmmoDamageRadius
+								, EFlareDamage::DAM_HighExplosive);
+				}
+			}
+		}
+	};
+
+	// Check targets in the explosion radius
+	TArray<AActor*> Candidates;
+	Sector->GetSpatialIndex().QueryRadius(DetonatePoint, Description->WeaponCharacteristics.AmmoExplosionRadius * 100,
+		EFlareSpatialBody::Spacecraft | EFlareSpatialBody::Bomb | EFlareSpatialBody::Meteorite, Candidates);
+	CheckTargets(Candidates, CheckTarget);
+
+	DestroyShell(ShellIndex);
+}
+
+float AFlareShellManager::ApplyDamage(int32 ShellIndex, AActor *ActorToDamage, UPrimitiveComponent* HitComponent, FVector ImpactLocation, FVector ImpactAxis, FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType)
+{
+	const FFlareSpacecraftComponentDescription* Description = ShellDescriptions[ShellIndex];
+	UFlareWeapon* Weapon = ShellWeapons[ShellIndex];
+	float Incidence = FVector::DotProduct(ImpactNormal, -ImpactAxis);
+	float Armor = 1; // Full armored
+
+	if (Incidence < 0)
+	{
+		// Parasite hit after rebound, ignore
+		return 0;
+	}
+
+	// Hit a component
+	UFlareSpacecraftComponent* ShipComponent = Cast<UFlareSpacecraftComponent>(HitComponent);
+	if (ShipComponent)
+	{
+		 Armor = ShipComponent->GetArmorAtLocation(ImpactLocation);
+	}
+
+	// Check armor peneration
+	int32 PenetrateArmor = false;
+	float PenerationIncidenceLimit = 0.7f;
+	if (Incidence > PenerationIncidenceLimit)
+	{
+		PenetrateArmor = true; // No ricochet
+	}
+	else if (Armor == 0)
+	{
+		PenetrateArmor = true; // Armor destruction
+	}
+
+	// Hit a component : damage in KJ
+	float AbsorbedEnergy = (PenetrateArmor ? ImpactPower : FMath::Square(Incidence) * ImpactPower);
+	AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(ActorToDamage);
+	AFlareAsteroid* Asteroid = Cast<AFlareAsteroid>(ActorToDamage);
+	AFlareMeteorite* Meteorite = Cast<AFlareMeteorite>(ActorToDamage);
+	AFlareBomb* Bomb = Cast<AFlareBomb>(ActorToDamage);
+	if (Spacecraft)
+	{
+		DamageCause Cause(Cast<AFlareSpacecraft>(Weapon->GetOwner())->GetParent(), DamageType);
+		Cause.ManualTurret = ShellManualTurret[ShellIndex];
+		Spacecraft->GetDamageSystem()->SetLastDamageCause(Cause);
+		Spacecraft->GetDamageSystem()->ApplyDamage(AbsorbedEnergy, ImpactRadius, ImpactLocation, DamageType, Weapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+
+		// Physics impulse
+		Spacecraft->Airframe->AddImpulseAtLocation( 5000	 * ImpactRadius * AbsorbedEnergy * (PenetrateArmor ? ImpactAxis : -ImpactNormal), ImpactLocation);
+		
+		// Play sound
+		AFlareSpacecraftPawn* SpacecraftPawn = Cast<AFlareSpacecraftPawn>(Spacecraft);
+		if (SpacecraftPawn->IsPlayerShip())
+		{
+			SpacecraftPawn->GetPC()->PlayLocalizedSound(PenetrateArmor ? Description->WeaponCharacteristics.DamageSound : Description->WeaponCharacteristics.ImpactSound, ImpactLocation, HitComponent);
+		}
+
+		// Quest progress
+		if (Weapon->GetSpacecraft()->GetGame()->GetQuestManager()
+			&& Weapon->GetSpacecraft()->GetGame()->GetQuestManager()->IsListeningEvent("hit-ship")
+			&& Weapon->GetSpacecraft()->GetParent() == Weapon->GetSpacecraft()->GetGame()->GetPC()->GetPlayerShip())
+		{
+			Weapon->GetSpacecraft()->GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("hit-ship").PutName("immatriculation", Spacecraft->GetImmatriculation()));
+		}
+
+		// Skirmish scoring
+		if (Weapon->GetSpacecraft()->GetGame()->IsSkirmish())
+		{
+			bool HitByPlayer = Weapon->GetSpacecraft()->GetCompany() == Weapon->GetSpacecraft()->GetPC()->GetCompany();
+			Weapon->GetSpacecraft()->GetGame()->GetSkirmishManager()->AmmoHit(HitByPlayer);
+		}
+	}
+	else if (Asteroid)
+	{
+		// Physics impulse
+		Asteroid->GetAsteroidComponent()->AddImpulseAtLocation( 5000	 * ImpactRadius * AbsorbedEnergy * (PenetrateArmor ? ImpactAxis : -ImpactNormal), ImpactLocation);
+		if (Weapon->GetSpacecraft()->GetGame()->GetQuestManager()
+			&& Weapon->GetSpacecraft()->GetGame()->GetQuestManager()->IsListeningEvent("hit-asteroid")
+			&& Weapon->GetSpacecraft()->GetParent() == Weapon->GetSpacecraft()->GetGame()->GetPC()->GetPlayerShip())
+		{
+			Weapon->GetSpacecraft()->GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("hit-asteroid"));
+		}
+	}
+	else if (Meteorite)
+	{
+		// Physics impulse
+		Meteorite->GetMeteoriteComponent()->AddImpulseAtLocation( 5000	 * ImpactRadius * AbsorbedEnergy * (PenetrateArmor ? ImpactAxis : -ImpactNormal), ImpactLocation);
+		if (Weapon->GetSpacecraft()->GetGame()->GetQuestManager()
+			&& Weapon->GetSpacecraft()->GetParent() == Weapon->GetSpacecraft()->GetGame()->GetPC()->GetPlayerShip())
+		{
+			Weapon->GetSpacecraft()->GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("hit-meteorite"));
+		}
+		Meteorite->ApplyDamage(AbsorbedEnergy, ImpactRadius, ImpactLocation, DamageType, Weapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+	}
+
+
+
+	else if (Bomb)
+	{
+		FHitResult Hit;
+		Bomb->NotifyHit(HitComponent, this, NULL, false, ImpactLocation, ImpactNormal, FVector::ZeroVector, Hit);
+	}
+
+	// Spawn impact decal
+	if (HitComponent)
+	{
+		float DecalSize = FMath::FRandRange(50, 100);
+		UDecalComponent* Decal = UGameplayStatics::SpawnDecalAttached(
+			Description->WeaponCharacteristics.GunCharacteristics.ExplosionMaterial,
+			DecalSize * FVector(1, 1, 1),
+			HitComponent,
+			NAME_None,
+			ImpactLocation,
+			ImpactNormal.Rotation(),
+			EAttachLocation::KeepWorldPosition,
+			120);
+		if (Decal)
+		{
+			// Instanciate and configure the decal material
+			UMaterialInterface* DecalMaterial = Decal->GetMaterial(0);
+			UMaterialInstanceDynamic* DecalMaterialInst = UMaterialInstanceDynamic::Create(DecalMaterial, GetWorld());
+			if (DecalMaterialInst)
+			{
+				DecalMaterialInst->SetScalarParameterValue("RandomParameter", FMath::FRandRange(1, 0));
+				DecalMaterialInst->SetScalarParameterValue("RandomParameter2", FMath::FRandRange(1, 0));
+				DecalMaterialInst->SetScalarParameterValue("IsShipHull", HitComponent->IsA(UFlareSpacecraftComponent::StaticClass()));
+				Decal->SetMaterial(0, DecalMaterialInst);
+			}
+		}
+	}
+
+	// Apply FX
+	if (HitComponent && !(Spacecraft && Spacecraft->GetCameraMode() == EFlareCameraMode::Immersive))
+	{
+		UParticleSystemComponent* PSC = UGameplayStatics::SpawnEmitterAttached(
+			Description->WeaponCharacteristics.ImpactEffect,
+			HitComponent,
+			NAME_None,
+			ImpactLocation,
+			ImpactNormal.Rotation(),
+			EAttachLocation::KeepWorldPosition,
+			true);
+		if (PSC)
+		{
+			PSC->SetWorldScale3D(Description->WeaponCharacteristics.ImpactEffectScale * FVector(1, 1, 1));
+		}
+	}
+
+	return AbsorbedEnergy;
+}
+
+bool AFlareShellManager::Trace(int32 ShellIndex, const FVector& Start, const FVector& End, FHitResult& HitOut)
+{
+	// Ignore Actors
+	FCollisionQueryParams TraceParams(FName(TEXT("Shell Trace")), true, this);
+	TraceParams.bTraceComplex = true;
+	TraceParams.bReturnPhysicalMaterial = false;
+	TraceParams.AddIgnoredActor(this);
+	TraceParams.AddIgnoredActor(ShellWeapons[ShellIndex]->GetSpacecraft());
+
+	// Re-initialize hit info
+	HitOut = FHitResult(ForceInit);
+
+	ECollisionChannel CollisionChannel = (ECollisionChannel) (ECC_WorldStatic | ECC_WorldDynamic | ECC_Pawn);
+
+	// Trace!
+	GetWorld()->LineTraceSingleByChannel(
+		HitOut,		// result
+		Start,	// start
+		End , // end
+		CollisionChannel, // collision channel
+		TraceParams
+	);
+
+	// Hit any Actor?
+	return (HitOut.GetActor() != NULL) ;
+}
+
+void AFlareShellManager::Destroyed()
+{
+	ClearShells();
+
+	Super::Destroyed();
+}
+
+void AFlareShellManager::SetPause(bool Pause)
+{
+	SetActorHiddenInGame(Pause);
+	CustomTimeDilation = (Pause ? 0.f : 1.0);
+}
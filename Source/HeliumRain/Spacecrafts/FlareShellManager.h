@@ -0,0 +1,136 @@
+#pragma once
+
+#include "FlareWeapon.h"
+#include "FlareShellManager.generated.h"
+
+
+class AFlarePlayerController;
+class UFlareSector;
+
+
+/** All the gun shells of the active sector.
+ *  Shells are plain data stored by field, moved in one pass per tick, and only traced when a body of the sector is near their path. */
+UCLASS()
+class AFlareShellManager : public AActor
+{
+public:
+
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/*----------------------------------------------------
+		Public methods
+	----------------------------------------------------*/
+
+	/** Attach to the active sector */
+	void Initialize(UFlareSector* ParentSector);
+
+	/** Fire a new shell. Fuze times are only used by proximity fuzes */
+	void FireShell(UFlareWeapon* Weapon, const FFlareSpacecraftComponentDescription* Description, FVector Location, FVector ShootDirection, FVector ParentVelocity,
+		bool Tracer, float SecureTime, float ActiveTime);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual void Destroyed() override;
+
+	virtual void SetPause(bool Pause);
+
+	/** Remove all shells */
+	void ClearShells();
+
+	int32 GetShellCount() const
+	{
+		return ShellLocations.Num();
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Shell behaviour
+	----------------------------------------------------*/
+
+	/** Impact happened */
+	void OnImpact(int32 ShellIndex, const FHitResult& HitResult, const FVector& HitVelocity);
+
+	void DetonateAt(int32 ShellIndex, FVector DetonatePoint);
+
+	bool Trace(int32 ShellIndex, const FVector& Start, const FVector& End, FHitResult& HitOut);
+
+	float ApplyDamage(int32 ShellIndex, AActor *ActorToDamage, UPrimitiveComponent* ImpactComponent, FVector ImpactLocation, FVector ImpactAxis, FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType);
+
+	void CheckFuze(int32 ShellIndex, FVector ActorLocation, FVector NextActorLocation);
+
+	/** Run a fuze or explosion check on spatial index candidates */
+	void CheckTargets(const TArray<AActor*>& Candidates, TFunctionRef<void(PilotHelper::PilotTarget)> CheckTarget);
+
+	/** Place and scale a tracer : 1 at 100m or less, then growing with the distance to the player */
+	void UpdateTracer(int32 ShellIndex);
+
+	/** Mark a shell as destroyed, it is removed at the end of the tick */
+	void DestroyShell(int32 ShellIndex);
+
+	/** Remove a shell, the last shell takes its place */
+	void RemoveShell(int32 ShellIndex);
+
+	/** Name given to damage logs */
+	FString GetShellName(int32 ShellIndex) const;
+
+	/** Get a tracer emitter for this template */
+	UParticleSystemComponent* GetTracer(UParticleSystem* Template);
+
+	/** Give a tracer emitter back */
+	void ReleaseTracer(UParticleSystemComponent* Tracer);
+
+
+	/*----------------------------------------------------
+		Shell data
+	----------------------------------------------------*/
+
+	TArray<FVector>                                      ShellLocations;
+	TArray<FVector>                                      ShellVelocities;
+	TArray<float>                                        ShellLifeSpans;
+	TArray<float>                                        ShellInitialLifeSpans;
+	TArray<float>                                        ShellMasses;
+	TArray<float>                                        ShellSecureTimes;
+	TArray<float>                                        ShellActiveTimes;
+	TArray<float>                                        ShellMinEffectiveDistances;
+	TArray<bool>                                         ShellArmed;
+	TArray<bool>                                         ShellManualTurret;
+	TArray<bool>                                         ShellDestroyed;
+	TArray<uint32>                                       ShellIdentifiers;
+	TArray<const FFlareSpacecraftComponentDescription*>  ShellDescriptions;
+
+	UPROPERTY()
+	TArray<UFlareWeapon*>                                ShellWeapons;
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*>                    ShellTracers;
+
+	/** All tracer emitters */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*>                    Tracers;
+
+	/** Tracer emitters ready to be used again, by template */
+	TMap<UParticleSystem*, TArray<UParticleSystemComponent*>> TracerPools;
+
+	/** Shell start locations of the current tick */
+	TArray<FVector>                                      PreviousLocations;
+
+	/** Some shells were destroyed during this tick */
+	bool                                                 HasDestroyedShells;
+
+	uint32                                               NextShellIdentifier;
+
+	/** Root component */
+	UPROPERTY()
+	USceneComponent*                                     ShellRoot;
+
+	UPROPERTY()
+	UFlareSector*                                        Sector;
+
+	UPROPERTY()
+	AFlarePlayerController*                              PC;
+
+};
@@ -1459,8 +1459,7 @@ FVector UFlareShipPilot::ExitAvoidance(AFlareSpacecraft* TargetShip, FVector Ini
 
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
+		const TArray<UFlareEngine*>& Engines = Ship->GetEngines();
 
 
 		FVector Acceleration = Ship->GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / Ship->GetSpacecraftMass();
@@ -1564,26 +1563,26 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestHostileShip(bool DangerousOnly, EFl
 	}
 
 	FVector PilotLocation = Ship->GetActorLocation();
-	float MinDistanceSquared = -1;
-	AFlareSpacecraft* NearestHostileShip = NULL;
+	TArray<AActor*> NearestHostileShips;
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Ship->GetGame()->GetActiveSector()->GetSpacecrafts().Num(); SpacecraftIndex++)
+	Ship->GetGame()->GetActiveSector()->GetSpatialIndex().QueryNearest(PilotLocation, 1, EFlareSpatialBody::Spacecraft,
+		[&](AActor* Candidate, float& Distance)
 	{
-		AFlareSpacecraft* ShipCandidate = Ship->GetGame()->GetActiveSector()->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* ShipCandidate = Cast<AFlareSpacecraft>(Candidate);
 
 		if (!ShipCandidate->GetParent()->GetDamageSystem()->IsAlive())
 		{
-			continue;
+			return false;
 		}
 
 		if (ShipCandidate->GetSize() != Size)
 		{
-			continue;
+			return false;
 		}
 
 		if (DangerousOnly && ! PilotHelper::IsTargetDangerous(PilotHelper::PilotTarget(ShipCandidate)))
 		{
-			continue;
+			return false;
 		}
 
 		// Tutorial exception
@@ -1597,18 +1596,14 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestHostileShip(bool DangerousOnly, EFl
 		}
 		else if (!ShipCandidate->IsHostile(Ship->GetCompany()))
 		{
-			continue;
+			return false;
 		}
 
-		float DistanceSquared = (PilotLocation - ShipCandidate->GetActorLocation()).SizeSquared();
-		if (NearestHostileShip == NULL || DistanceSquared < MinDistanceSquared)
-		{
-			MinDistanceSquared = DistanceSquared;
-			NearestHostileShip = ShipCandidate;
-		}
+		Distance = (PilotLocation - ShipCandidate->GetActorLocation()).Size();
+		return true;
+	}, NearestHostileShips);
 
-	}
-	return NearestHostileShip;
+	return NearestHostileShips.Num() ? Cast<AFlareSpacecraft>(NearestHostileShips[0]) : NULL;
 }
 
 AFlareSpacecraft* UFlareShipPilot::GetNearestShip(bool IgnoreDockingShip) const
@@ -1620,43 +1615,40 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestShip(bool IgnoreDockingShip) const
 	// - Is not me
 
 	FVector PilotLocation = Ship->GetActorLocation();
-	float MinDistanceSquared = -1;
-	AFlareSpacecraft* NearestShip = NULL;
+	TArray<AActor*> NearestShips;
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Ship->GetGame()->GetActiveSector()->GetSpacecrafts().Num(); SpacecraftIndex++)
+	Ship->GetGame()->GetActiveSector()->GetSpatialIndex().QueryNearest(PilotLocation, 1, EFlareSpatialBody::Spacecraft,
+		[&](AActor* Candidate, float& Distance)
 	{
-		AFlareSpacecraft* ShipCandidate = Ship->GetGame()->GetActiveSector()->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* ShipCandidate = Cast<AFlareSpacecraft>(Candidate);
 
 		if (ShipCandidate == Ship)
 		{
-			continue;
+			return false;
 		}
 
 		if (IgnoreDockingShip && Ship->GetDockingSystem()->IsGrantedShip(ShipCandidate) && !ShipCandidate->GetParent()->GetDamageSystem()->IsUncontrollable())
 		{
 			// Constrollable ship are not dangerous for collision
-			continue;
+			return false;
 		}
 
 		if (IgnoreDockingShip && Ship->GetDockingSystem()->IsDockedShip(ShipCandidate))
 		{
 			// Docked shipship are not dangerous for collision, even if they are dead or offlline
-			continue;
+			return false;
 		}
 
-		float DistanceSquared = (PilotLocation - ShipCandidate->GetActorLocation()).SizeSquared();
-		if (NearestShip == NULL || DistanceSquared < MinDistanceSquared)
-		{
-			MinDistanceSquared = DistanceSquared;
-			NearestShip = ShipCandidate;
-		}
-	}
-	return NearestShip;
+		Distance = (PilotLocation - ShipCandidate->GetActorLocation()).Size();
+		return true;
+	}, NearestShips);
+
+	return NearestShips.Num() ? Cast<AFlareSpacecraft>(NearestShips[0]) : NULL;
 }
 
 FVector UFlareShipPilot::GetAngularVelocityToAlignAxis(FVector LocalShipAxis, FVector TargetAxis, FVector TargetAngularVelocity, float DeltaSeconds) const
 {
-	TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Ship->GetEngines();
 
 	FVector AngularVelocity = Ship->Airframe->GetPhysicsAngularVelocityInDegrees();
 	FVector WorldShipAxis = Ship->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
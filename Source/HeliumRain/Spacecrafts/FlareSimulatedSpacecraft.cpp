@@ -8,6 +8,7 @@
 #include "../Game/FlareWorld.h"
 #include "../Game/FlareSectorHelper.h"
 #include "../Game/FlareGameTools.h"
+#include "../Game/FlareSaveGame.h"
 
 #include "../Player/FlarePlayerController.h"
 #include "../Economy/FlareCargoBay.h"
@@ -48,6 +49,7 @@ void UFlareSimulatedSpacecraft::Load(const FFlareSpacecraftSave& Data)
 	Company = Cast<UFlareCompany>(GetOuter());
 	Game = Company->GetGame();
 	SpacecraftData = Data;
+	SpacecraftData.SaveRevision = UFlareSaveGame::GetChangeRevision();
 
 	ComplexChildren.Empty();
 
@@ -270,6 +272,9 @@ void UFlareSimulatedSpacecraft::Load(const FFlareSpacecraftSave& Data)
 		ActiveSpacecraft->Load(this);
 		ActiveSpacecraft->Redock();
 	}
+
+	// New spacecraft, or new level and cargo bays
+	Company->InvalidateCompanyValueCache();
 }
 
 void UFlareSimulatedSpacecraft::Reload()
@@ -292,13 +297,15 @@ FFlareSpacecraftSave* UFlareSimulatedSpacecraft::Save()
 		SpacecraftData.ProductionCargoBay = *ProductionCargoBay->Save();
 	}
 
+	// Active spacecrafts change all the time
 	if (IsActive())
 	{
 		GetActive()->Save();
+		SetSaveDirty();
 	}
 
 	// Save connected stations
-	GetData().ConnectedStations.Empty();
+	TArray<FFlareConnectionSave> ConnectedStations;
 	for (FFlareDockingInfo& StationConnection : ConnectorSlots)
 	{
 		if (StationConnection.Granted)
@@ -306,13 +313,38 @@ FFlareSpacecraftSave* UFlareSimulatedSpacecraft::Save()
 			FFlareConnectionSave Data;
 			Data.ConnectorName = StationConnection.Name;
 			Data.StationIdentifier = StationConnection.ConnectedStationName;
-			GetData().ConnectedStations.Add(Data);
+			ConnectedStations.Add(Data);
 		}
 	}
 
+	bool ConnectionsChanged = (ConnectedStations.Num() != SpacecraftData.ConnectedStations.Num());
+	for (int32 ConnectionIndex = 0; ConnectionIndex < ConnectedStations.Num() && !ConnectionsChanged; ConnectionIndex++)
+	{
+		const FFlareConnectionSave& OldConnection = SpacecraftData.ConnectedStations[ConnectionIndex];
+		ConnectionsChanged = (ConnectedStations[ConnectionIndex].ConnectorName != OldConnection.ConnectorName
+			|| ConnectedStations[ConnectionIndex].StationIdentifier != OldConnection.StationIdentifier);
+	}
+
+	if (ConnectionsChanged)
+	{
+		SpacecraftData.ConnectedStations = MoveTemp(ConnectedStations);
+		SetSaveDirty();
+	}
+
 	return &SpacecraftData;
 }
 
+void UFlareSimulatedSpacecraft::SetSaveDirty()
+{
+	SpacecraftData.SaveRevision = UFlareSaveGame::GetChangeRevision();
+
+	// A complex saves the factory states of its elements
+	if (ComplexMaster && ComplexMaster != this)
+	{
+		ComplexMaster->SetSaveDirty();
+	}
+}
+
 UFlareCompany* UFlareSimulatedSpacecraft::GetCompany() const
 {
 	return Company;
@@ -361,6 +393,7 @@ UFlareSimulatedSpacecraftWeaponsSystem* UFlareSimulatedSpacecraft::GetWeaponsSys
 void UFlareSimulatedSpacecraft::SetSpawnMode(EFlareSpawnMode::Type SpawnMode)
 {
 	SpacecraftData.SpawnMode = SpawnMode;
+	SetSaveDirty();
 }
 
 bool UFlareSimulatedSpacecraft::CanBeFlown(FText& OutInfo) const
@@ -407,6 +440,9 @@ void UFlareSimulatedSpacecraft::SetCurrentSector(UFlareSimulatedSector* Sector)
 {
 	CurrentSector = Sector;
 
+	// The spacecraft and its stock are now valued at the prices of this sector
+	GetCompany()->InvalidateCompanyValueCache();
+
 	// Mark the sector as visited
 	if (!Sector->IsTravelSector())
 	{
@@ -779,6 +815,7 @@ void UFlareSimulatedSpacecraft::SetAsteroidData(FFlareAsteroidSave* Data)
 	SpacecraftData.AsteroidData.Scale = Data->Scale;
 	SpacecraftData.Location = Data->Location;
 	SpacecraftData.Rotation = Data->Rotation;
+	SetSaveDirty();
 }
 
 void UFlareSimulatedSpacecraft::SetComplexStationAttachment(FName StationName, FName ConnectorName)
@@ -788,6 +825,7 @@ void UFlareSimulatedSpacecraft::SetComplexStationAttachment(FName StationName, F
 
 	SpacecraftData.AttachComplexStationName = StationName;
 	SpacecraftData.AttachComplexConnectorName = ConnectorName;
+	SetSaveDirty();
 }
 
 void UFlareSimulatedSpacecraft::SetActorAttachment(FName ActorName)
@@ -796,12 +834,18 @@ void UFlareSimulatedSpacecraft::SetActorAttachment(FName ActorName)
 		*GetImmatriculation().ToString(), *ActorName.ToString());
 
 	SpacecraftData.AttachActorName = ActorName;
+	SetSaveDirty();
 }
 
 void UFlareSimulatedSpacecraft::SetDynamicComponentState(FName Identifier, float Progress)
 {
-	SpacecraftData.DynamicComponentStateIdentifier = Identifier;
-	SpacecraftData.DynamicComponentStateProgress = Progress;
+	// Factories set their state every day
+	if (SpacecraftData.DynamicComponentStateIdentifier != Identifier || SpacecraftData.DynamicComponentStateProgress != Progress)
+	{
+		SpacecraftData.DynamicComponentStateIdentifier = Identifier;
+		SpacecraftData.DynamicComponentStateProgress = Progress;
+		SetSaveDirty();
+	}
 }
 
 void UFlareSimulatedSpacecraft::Upgrade()
@@ -865,6 +909,7 @@ void UFlareSimulatedSpacecraft::ForceUndock()
 {
 	SpacecraftData.DockedTo = NAME_None;
 	SpacecraftData.DockedAt = -1;
+	SetSaveDirty();
 }
 
 void UFlareSimulatedSpacecraft::SetTrading(bool Trading)
@@ -895,17 +940,34 @@ void UFlareSimulatedSpacecraft::SetTrading(bool Trading)
 			Data);
 	}
 
-	SpacecraftData.IsTrading = Trading;
+	if (SpacecraftData.IsTrading != Trading)
+	{
+		SpacecraftData.IsTrading = Trading;
+		SetSaveDirty();
+	}
 }
 
 void UFlareSimulatedSpacecraft::SetIntercepted(bool Intercepted)
 {
-	SpacecraftData.IsIntercepted = Intercepted;
+	if (SpacecraftData.IsIntercepted != Intercepted)
+	{
+		SpacecraftData.IsIntercepted = Intercepted;
+		SetSaveDirty();
+	}
 }
 
 void UFlareSimulatedSpacecraft::SetReserve(bool InReserve)
 {
-	SpacecraftData.IsReserve = InReserve;
+	if (SpacecraftData.IsReserve != InReserve)
+	{
+		SpacecraftData.IsReserve = InReserve;
+		SetSaveDirty();
+	}
+
+	if (GetCurrentSector())
+	{
+		GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 
@@ -961,7 +1023,11 @@ void UFlareSimulatedSpacecraft::Repair()
 
 	if (GetDamageSystem()->GetGlobalDamageRatio() >= 1.f)
 	{
-		SpacecraftData.RepairStock = 0;
+		if (SpacecraftData.RepairStock != 0)
+		{
+			SpacecraftData.RepairStock = 0;
+			SetSaveDirty();
+		}
 
 		if(SpacecraftPreciseCurrentNeededFleetSupply > 0)
 		{
@@ -976,6 +1042,7 @@ void UFlareSimulatedSpacecraft::Repair()
 void UFlareSimulatedSpacecraft::RecoveryRepair()
 {
 	SpacecraftData.RepairStock = 0;
+	SetSaveDirty();
 
 
 	UFlareSpacecraftComponentsCatalog* Catalog = GetGame()->GetShipPartsCatalog();
@@ -1012,8 +1079,12 @@ void UFlareSimulatedSpacecraft::Stabilize()
 {
 	if(!GetDamageSystem()->IsUncontrollable())
 	{
-		SpacecraftData.LinearVelocity = FVector::ZeroVector;
-		SpacecraftData.AngularVelocity = FVector::ZeroVector;
+		if (!SpacecraftData.LinearVelocity.IsZero() || !SpacecraftData.AngularVelocity.IsZero())
+		{
+			SpacecraftData.LinearVelocity = FVector::ZeroVector;
+			SpacecraftData.AngularVelocity = FVector::ZeroVector;
+			SetSaveDirty();
+		}
 
 		float Limits = UFlareSector::GetSectorLimits();
 		float Distance = SpacecraftData.Location.Size();
@@ -1022,6 +1093,7 @@ void UFlareSimulatedSpacecraft::Stabilize()
 		{
 			float Correction = 0.8* Limits / Distance;
 			SpacecraftData.Location *= Correction;
+			SetSaveDirty();
 		}
 	}
 }
@@ -1079,7 +1151,11 @@ void UFlareSimulatedSpacecraft::Refill()
 
 	if (!NeedRefill())
 	{
-		SpacecraftData.RefillStock = 0;
+		if (SpacecraftData.RefillStock != 0)
+		{
+			SpacecraftData.RefillStock = 0;
+			SetSaveDirty();
+		}
 
 
 		if(SpacecraftPreciseCurrentNeededFleetSupply > 0)
@@ -1100,11 +1176,13 @@ void UFlareSimulatedSpacecraft::SetHarpooned(UFlareCompany* OwnerCompany)
 		{
 			CombatLog::SpacecraftHarpooned(this, OwnerCompany);
 			SpacecraftData.HarpoonCompany  = OwnerCompany->GetIdentifier();
+			SetSaveDirty();
 		}
 	}
-	else
+	else if (SpacecraftData.HarpoonCompany != NAME_None)
 	{
 		SpacecraftData.HarpoonCompany = NAME_None;
+		SetSaveDirty();
 	}
 }
 
@@ -1126,6 +1204,12 @@ void UFlareSimulatedSpacecraft::RemoveCapturePoint(FName CompanyIdentifier, int3
 		{
 			SpacecraftData.CapturePoints[CompanyIdentifier] = CurrentCapturePoint - CapturePoint;
 		}
+		SetSaveDirty();
+
+		if (GetCurrentSector())
+		{
+			GetCurrentSector()->InvalidateBattleState();
+		}
 	}
 }
 
@@ -1175,6 +1259,12 @@ bool UFlareSimulatedSpacecraft::TryCapture(UFlareCompany* OtherCompany, int32 Ca
 	{
 		SpacecraftData.CapturePoints.Add(CompanyIdentifier, CurrentCapturePoint);
 	}
+	SetSaveDirty();
+
+	if (GetCurrentSector())
+	{
+		GetCurrentSector()->InvalidateBattleState();
+	}
 
 	if (CurrentCapturePoint > GetCapturePointThreshold())
 	{
@@ -1320,11 +1410,13 @@ void UFlareSimulatedSpacecraft::FinishConstruction()
 void UFlareSimulatedSpacecraft::OrderRepairStock(float FS)
 {
 	SpacecraftData.RepairStock += FS;
+	SetSaveDirty();
 }
 
 void UFlareSimulatedSpacecraft::OrderRefillStock(float FS)
 {
 	SpacecraftData.RefillStock += FS;
+	SetSaveDirty();
 }
 
 bool UFlareSimulatedSpacecraft::NeedRefill()
@@ -1550,6 +1642,7 @@ bool UFlareSimulatedSpacecraft::ShipyardOrderShip(UFlareCompany* OrderCompany, F
 	newOrder.AdvancePayment = ShipPrice;
 
 	SpacecraftData.ShipyardOrderQueue.Add(newOrder);
+	SetSaveDirty();
 
 	UpdateShipyardProduction();
 
@@ -1596,6 +1689,7 @@ void UFlareSimulatedSpacecraft::CancelShipyardOrder(int32 OrderIndex)
 	}
 
 	SpacecraftData.ShipyardOrderQueue.RemoveAt(OrderIndex);
+	SetSaveDirty();
 
 	UpdateShipyardProduction();
 }
@@ -1695,6 +1789,9 @@ void UFlareSimulatedSpacecraft::UpdateShipyardProduction()
 		return;
 	}
 
+	// Next order changes the expected shipyard consumption
+	GetGame()->GetGameWorld()->InvalidateResourceStats(GetCurrentSector());
+
 	TArray<int32> IndexToRemove;
 
 	int32 Index = 0;
@@ -1743,6 +1840,11 @@ void UFlareSimulatedSpacecraft::UpdateShipyardProduction()
 	{
 		SpacecraftData.ShipyardOrderQueue.RemoveAt(IndexToRemove[i]);
 	}
+
+	if (IndexToRemove.Num())
+	{
+		SetSaveDirty();
+	}
 }
 
 bool UFlareSimulatedSpacecraft::CanOrder(const FFlareSpacecraftDescription* ShipDescription, UFlareCompany* OrderCompany)
@@ -1955,6 +2057,7 @@ bool UFlareSimulatedSpacecraft::IsAllowExternalOrder()
 void UFlareSimulatedSpacecraft::SetAllowExternalOrder(bool Allow)
 {
 	SpacecraftData.AllowExternalOrder = Allow;
+	SetSaveDirty();
 
 	if(!Allow)
 	{
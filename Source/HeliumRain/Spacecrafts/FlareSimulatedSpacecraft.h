@@ -32,6 +32,9 @@ public:
 	/** Save the ship to a save file */
 	virtual FFlareSpacecraftSave* Save();
 
+	/** The save data changed, the ship will be written in the next save journals */
+	void SetSaveDirty();
+
 	/** Get the parent company */
 	virtual UFlareCompany* GetCompany() const;
 
@@ -96,6 +99,7 @@ public:
 			FCHECK(ActiveSpacecraft == NULL || ActiveSpacecraft == Spacecraft);
 		}
 		ActiveSpacecraft = Spacecraft;
+		SetSaveDirty();
 	}
 
 	void ForceUndock();
@@ -125,6 +129,7 @@ public:
 	void SetDestroyed(bool Destroyed)
 	{
 		SpacecraftData.IsDestroyed = Destroyed;
+		SetSaveDirty();
 	}
 
 	UFlareCompany* GetHarpoonCompany();
@@ -242,6 +247,7 @@ public:
 	void SetNickName(FText NewName)
 	{
 		SpacecraftData.NickName = NewName;
+		SetSaveDirty();
 	}
 
 
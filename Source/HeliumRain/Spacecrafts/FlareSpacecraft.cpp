@@ -191,14 +191,10 @@ void AFlareSpacecraft::Tick(float DeltaSeconds)
 		}
 
 		// Lights
-		TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
-		for (int32 ComponentIndex = 0; ComponentIndex < LightComponents.Num(); ComponentIndex++)
+		bool HasPower = !Parent->GetDamageSystem()->HasPowerOutage();
+		for (USpotLightComponent* Component : LightComponents)
 		{
-			USpotLightComponent* Component = Cast<USpotLightComponent>(LightComponents[ComponentIndex]);
-			if (Component)
-			{
-				Component->SetActive(!Parent->GetDamageSystem()->HasPowerOutage());
-			}
+			Component->SetActive(HasPower);
 		}
 
 		// Player ship updates
@@ -926,6 +922,9 @@ void AFlareSpacecraft::Load(UFlareSimulatedSpacecraft* ParentSpacecraft)
 		NavigationSystem->BreakDock();
 	}
 
+	// Cache components
+	UpdateComponentCache();
+
 	// Initialize damage system
 	DamageSystem = NewObject<UFlareSpacecraftDamageSystem>(this, UFlareSpacecraftDamageSystem::StaticClass());
 	DamageSystem->Initialize(this, &GetData());
@@ -1057,6 +1056,8 @@ void AFlareSpacecraft::Save()
 		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
 		Component->Save();
 	}
+
+	Parent->SetSaveDirty();
 }
 
 void AFlareSpacecraft::SetOwnerCompany(UFlareCompany* NewCompany)
@@ -1301,6 +1302,31 @@ void AFlareSpacecraft::UpdateDynamicComponents()
 			}
 		}
 	}
+
+	UpdateComponentCache();
+}
+
+void AFlareSpacecraft::UpdateComponentCache()
+{
+	EngineComponents.Reset();
+	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareEngine::StaticClass());
+	for (UActorComponent* Component : Components)
+	{
+		EngineComponents.Add(Cast<UFlareEngine>(Component));
+	}
+
+	LightComponents.Reset();
+	Components = GetComponentsByClass(USpotLightComponent::StaticClass());
+	for (UActorComponent* Component : Components)
+	{
+		LightComponents.Add(Cast<USpotLightComponent>(Component));
+	}
+
+	// Engine indices may have changed
+	if (NavigationSystem)
+	{
+		NavigationSystem->UpdateEngineTables();
+	}
 }
 
 UFlareInternalComponent* AFlareSpacecraft::GetInternalComponentAtLocation(FVector Location) const
@@ -2193,10 +2219,7 @@ float AFlareSpacecraft::GetTimeToStop() const
 	{
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = GetComponentsByClass(UFlareEngine::StaticClass());
-
-		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / GetSpacecraftMass();
+		FVector Acceleration = GetNavigationSystem()->GetTotalMaxThrustInAxis(EngineComponents, CurrentVelocityAxis, false) / GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, CurrentVelocityAxis));
 
 		TimeToStopCache = (CurrentVelocity.Size() / (AccelerationInAngleAxis));
@@ -14,6 +14,8 @@
 
 class UFlareShipPilot;
 class AFlareSpacecraft;
+class UFlareEngine;
+class USpotLightComponent;
 
 class UCanvasRenderTarget2D;
 
@@ -142,6 +144,9 @@ public:
 	void ApplyAsteroidData();
 
 	void UpdateDynamicComponents();
+
+	/** Rebuild the engine and light lists, and the engine tables of the navigation system */
+	void UpdateComponentCache();
 	
 	UFlareSimulatedSector* GetOwnerSector();
 	
@@ -295,6 +300,12 @@ protected:
 	UPROPERTY()
 	UFlareSpacecraftComponent*                     ShipCockit;
 
+	// Component cache
+	UPROPERTY()
+	TArray<UFlareEngine*>                          EngineComponents;
+	UPROPERTY()
+	TArray<USpotLightComponent*>                   LightComponents;
+
 	// Pilot object
 	UPROPERTY()
 	UFlareShipPilot*                               Pilot;
@@ -481,6 +492,11 @@ public:
 		return ShipCockit;
 	}
 
+	inline const TArray<UFlareEngine*>& GetEngines() const
+	{
+		return EngineComponents;
+	}
+
 	virtual UCameraComponent* GetCamera() const
 	{
 		return Cast<UCameraComponent>(Camera);
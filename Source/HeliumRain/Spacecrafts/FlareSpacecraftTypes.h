@@ -571,6 +571,9 @@ struct FFlareSpacecraftSave
 
 	/** List of connected stations */
 	TArray<FFlareConnectionSave> ConnectedStations;
+
+	/** Revision of the last change, not saved. Set by the simulated spacecraft, see UFlareSaveGame::GetChangeRevision */
+	int64 SaveRevision;
 };
 
 /** Catalog binding between FFlareSpacecraftDescription and FFlareSpacecraftComponentDescription structure */
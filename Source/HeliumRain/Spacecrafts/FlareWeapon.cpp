@@ -4,7 +4,7 @@
 
 #include "FlareSpacecraftTypes.h"
 #include "FlareSpacecraft.h"
-#include "FlareShell.h"
+#include "FlareShellManager.h"
 #include "FlareBomb.h"
 
 #include "../Game/FlareGame.h"
@@ -16,7 +16,7 @@
 
 DECLARE_CYCLE_STAT(TEXT("FlareWeapon Firing"), STAT_Weapon_Firing, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareWeapon FireGun"), STAT_Weapon_FireGun, STATGROUP_Flare);
-DECLARE_CYCLE_STAT(TEXT("FlareWeapon ConfigureShellFuze"), STAT_Weapon_ConfigureShellFuze, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareWeapon ComputeShellFuze"), STAT_Weapon_ComputeShellFuze, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareWeapon IsSafeToFire"), STAT_FlareWeapon_IsSafeToFire, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareWeapon Trace"), STAT_FlareWeapon_Trace, STATGROUP_Flare);
 
@@ -79,11 +79,6 @@ void UFlareWeapon::Initialize(FFlareSpacecraftComponentSave* Data, UFlareCompany
 		}
 	}
 
-	// Spawn properties
-	ProjectileSpawnParams.Instigator = SpacecraftPawn;
-	ProjectileSpawnParams.bNoFail = true;
-	ProjectileSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
 	// Additional properties
 	LastFiredGun = -1;
 	SetupFiringEffects();
@@ -315,16 +310,11 @@ bool UFlareWeapon::FireGun(int GunIndex)
 	FVector FiringDirection = FMath::VRandCone(FiringAxis, Imprecision);
 	FVector FiringVelocity = Spacecraft->Airframe->GetPhysicsLinearVelocity();
 
-	// Create a shell
-	AFlareShell* Shell = GetWorld()->SpawnActor<AFlareShell>(
-		AFlareShell::StaticClass(),
-		FiringLocation,
-		FRotator::ZeroRotator,
-		ProjectileSpawnParams);
-
-	// Fire it. Tracer ammo every bullets
-	Shell->Initialize(this, ComponentDescription, FiringDirection, FiringVelocity, true);
-	ConfigureShellFuze(Shell);
+	// Fire a shell. Tracer ammo every bullets
+	float SecureTime = 0;
+	float ActiveTime = 0;
+	ComputeShellFuze(SecureTime, ActiveTime);
+	Spacecraft->GetGame()->GetActiveSector()->GetShellManager()->FireShell(this, ComponentDescription, FiringLocation, FiringDirection, FiringVelocity, true, SecureTime, ActiveTime);
 	ShowFiringEffects(GunIndex);
 
 	// Play sound
@@ -339,6 +329,7 @@ bool UFlareWeapon::FireGun(int GunIndex)
 
 	// Quest progress
 	if (Spacecraft->GetGame()->GetQuestManager() && 
+		Spacecraft->GetGame()->GetQuestManager()->IsListeningEvent("fire-gun") &&
 		Spacecraft->GetParent() == Spacecraft->GetGame()->GetPC()->GetPlayerShip())
 	{
 		Spacecraft->GetGame()->GetQuestManager()->OnEvent(FFlareBundle().PutTag("fire-gun"));
@@ -387,15 +378,14 @@ bool UFlareWeapon::FireBomb()
 	return true;
 }
 
-void UFlareWeapon::ConfigureShellFuze(AFlareShell* Shell)
+void UFlareWeapon::ComputeShellFuze(float& SecureTime, float& ActiveTime)
 {
-	SCOPE_CYCLE_COUNTER(STAT_Weapon_ConfigureShellFuze);
+	SCOPE_CYCLE_COUNTER(STAT_Weapon_ComputeShellFuze);
 
 	if (ComponentDescription->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity)
 	{
 		float SecurityRadius = 	ComponentDescription->WeaponCharacteristics.AmmoExplosionRadius + Spacecraft->GetMeshScale() / 100;
 		float SecurityDelay = SecurityRadius / ComponentDescription->WeaponCharacteristics.GunCharacteristics.AmmoVelocity;
-		float ActiveTime = 10;
 
 		FVector RelativeFiringVelocity = Spacecraft->GetLinearVelocity() - TargetVelocity;
 		FVector TargetOffset = TargetLocation - Spacecraft->GetActorLocation();
@@ -407,9 +397,8 @@ void UFlareWeapon::ConfigureShellFuze(AFlareShell* Shell)
 
 		float NeededSecurityDelay = EstimatedFlightTime * 0.5;
 		SecurityDelay = FMath::Max(SecurityDelay, NeededSecurityDelay);
+		SecureTime = SecurityDelay;
 		ActiveTime = EstimatedFlightTime * 1.5 - SecurityDelay;
-
-		Shell->SetFuzeTimer(SecurityDelay, ActiveTime);
 	}
 }
 
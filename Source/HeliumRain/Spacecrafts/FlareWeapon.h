@@ -4,7 +4,6 @@
 #include "FlareWeapon.generated.h"
 
 
-class AFlareShell;
 class AFlareBomb;
 struct FFlareWeaponGroup;
 
@@ -70,7 +69,8 @@ public:
 
 	virtual bool FireBomb();
 
-	virtual void ConfigureShellFuze(AFlareShell* Shell);
+	/** Proximity fuze timers for a new shell, left unchanged for other fuzes */
+	virtual void ComputeShellFuze(float& SecureTime, float& ActiveTime);
 
 	/** Set the target data */
 	virtual void SetTarget(FVector TargetLocation, FVector TargetVelocity);
@@ -129,7 +129,6 @@ protected:
 	float                       FiringRate;
 	float                       FiringPeriod;
 	float                       AmmoVelocity;
-	FActorSpawnParameters       ProjectileSpawnParams;
 
 	UPROPERTY()
 	TArray<AFlareBomb*>         Bombs;
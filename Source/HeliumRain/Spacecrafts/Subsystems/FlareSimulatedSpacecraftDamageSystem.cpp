@@ -415,11 +415,11 @@ float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftCompone
 				// Retaliation
 				if(DamageSource->GetCompany() == PlayerCompany)
 				{
-					PlayerCompany->AddRetaliation(EffectiveEnergy);
+					Spacecraft->GetCurrentSector()->AddPlayerRetaliation(EffectiveEnergy);
 				}
 				else if(Spacecraft->GetCompany() == PlayerCompany)
 				{
-					PlayerCompany->RemoveRetaliation(EffectiveEnergy);
+					Spacecraft->GetCurrentSector()->AddPlayerRetaliation(-EffectiveEnergy);
 				}
 			}
 			else
@@ -438,30 +438,32 @@ float UFlareSimulatedSpacecraftDamageSystem::ApplyDamage(FFlareSpacecraftCompone
 				if (!Spacecraft->IsHostile(DamageSource->GetCompany(), true))
 				{
 					// If it's a betrayal, lower attacker's reputation on everyone, give rep to victim
-
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
-
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
-						   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("neutrality-violation"),
-						   EFlareNotification::NT_Military);
-
-
+					ApplyWorldEffect([this, ReputationCost]()
+					{
+						// Lower attacker's reputation on victim
+						Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/2);
+						Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost);
+
+						Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("NeutralAttack", "Neutrality violation"),
+							   FText::Format(LOCTEXT("NeutralAttackDescription", "Attacking neutral properties ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+							   FName("neutrality-violation"),
+							   EFlareNotification::NT_Military);
+					});
 				}
 				else if(Spacecraft->IsActive() && Spacecraft->GetActive()->GetTimeSinceUncontrollable() > 5.f && !Spacecraft->GetGame()->GetQuestManager()->IsAllowedToDestroy(Spacecraft))
 				{
 					// If an attack on a prisoner, lower attacker's reputation on everyone, give rep to victim
-
-					// Lower attacker's reputation on victim
-					Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
-					Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
-
-					Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
-						   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
-						   FName("prisoner-attack"),
-						   EFlareNotification::NT_Military);
+					ApplyWorldEffect([this, ReputationCost]()
+					{
+						// Lower attacker's reputation on victim
+						Spacecraft->GetCompany()->GivePlayerReputationToOthers(ReputationCost/5);
+						Spacecraft->GetCompany()->GivePlayerReputation(ReputationCost/5);
+
+						Spacecraft->GetGame()->GetPC()->Notify(LOCTEXT("PrisonerAttack", "Attacking prisoners"),
+							   FText::Format(LOCTEXT("PrisonerAttackDescription", "Attacking uncontrollable ships ({0}) will have diplomatic consequences."), UFlareGameTools::DisplaySpacecraftName(Spacecraft)),
+							   FName("prisoner-attack"),
+							   EFlareNotification::NT_Military);
+					});
 				}
 			}
 		}
@@ -706,15 +708,27 @@ void UFlareSimulatedSpacecraftDamageSystem::SetPowerDirty()
 void UFlareSimulatedSpacecraftDamageSystem::SetDamageDirty(FFlareSpacecraftComponentDescription* ComponentDescription)
 {
 	DamageDirty = true;
+	Spacecraft->SetSaveDirty();
 	if(ComponentDescription->GeneralCharacteristics.ElectricSystem)
 	{
 		SetPowerDirty();
 	}
+
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 void UFlareSimulatedSpacecraftDamageSystem::SetAmmoDirty()
 {
 	AmmoDirty = true;
+	Spacecraft->SetSaveDirty();
+
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleState();
+	}
 }
 
 bool UFlareSimulatedSpacecraftDamageSystem::IsPowered(FFlareSpacecraftComponentSave* ComponentToPowerData) const
@@ -825,20 +839,25 @@ float UFlareSimulatedSpacecraftDamageSystem::GetArmor(FFlareSpacecraftComponentD
 
 void UFlareSimulatedSpacecraftDamageSystem::NotifyDamage()
 {
+	DamageCause Cause = LastDamageCause;
+
 	// Update uncontrollable status
 	if (WasControllable && IsUncontrollable())
 	{
 		WasControllable = false;
 
-		if (Spacecraft->GetGame()->GetQuestManager())
+		ApplyWorldEffect([this, Cause]()
 		{
-			Spacecraft->GetGame()->GetQuestManager()->OnSpacecraftDestroyed(Spacecraft, true, LastDamageCause);
-		}
-		else if (Spacecraft->GetGame()->IsSkirmish())
-		{
-			bool DisabledByPlayerShip = Spacecraft->GetCurrentFleet() != Spacecraft->GetGame()->GetPC()->GetPlayerFleet();
-			Spacecraft->GetGame()->GetSkirmishManager()->ShipDisabled(DisabledByPlayerShip);
-		}
+			if (Spacecraft->GetGame()->GetQuestManager())
+			{
+				Spacecraft->GetGame()->GetQuestManager()->OnSpacecraftDestroyed(Spacecraft, true, Cause);
+			}
+			else if (Spacecraft->GetGame()->IsSkirmish())
+			{
+				bool DisabledByPlayerShip = Spacecraft->GetCurrentFleet() != Spacecraft->GetGame()->GetPC()->GetPlayerFleet();
+				Spacecraft->GetGame()->GetSkirmishManager()->ShipDisabled(DisabledByPlayerShip);
+			}
+		});
 	}
 
 	// Update alive status
@@ -846,15 +865,30 @@ void UFlareSimulatedSpacecraftDamageSystem::NotifyDamage()
 	{
 		WasAlive = false;
 
-		if (Spacecraft->GetGame()->GetQuestManager())
+		ApplyWorldEffect([this, Cause]()
 		{
-			Spacecraft->GetGame()->GetQuestManager()->OnSpacecraftDestroyed(Spacecraft, true, LastDamageCause);
-		}
-		else if (Spacecraft->GetGame()->IsSkirmish())
-		{
-			bool IsPlayerShip = Spacecraft->GetCompany() == Spacecraft->GetGame()->GetPC()->GetCompany();
-			Spacecraft->GetGame()->GetSkirmishManager()->ShipDestroyed(!IsPlayerShip);
-		}
+			if (Spacecraft->GetGame()->GetQuestManager())
+			{
+				Spacecraft->GetGame()->GetQuestManager()->OnSpacecraftDestroyed(Spacecraft, true, Cause);
+			}
+			else if (Spacecraft->GetGame()->IsSkirmish())
+			{
+				bool IsPlayerShip = Spacecraft->GetCompany() == Spacecraft->GetGame()->GetPC()->GetCompany();
+				Spacecraft->GetGame()->GetSkirmishManager()->ShipDestroyed(!IsPlayerShip);
+			}
+		});
+	}
+}
+
+void UFlareSimulatedSpacecraftDamageSystem::ApplyWorldEffect(TFunction<void()> Effect)
+{
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->ApplyOrDeferEffect(Effect);
+	}
+	else
+	{
+		Effect();
 	}
 }
 
@@ -141,6 +141,9 @@ protected:
 	// Update health values
 	float GetSubsystemHealthInternal(EFlareSubsystem::Type Type) const;
 
+	/** Apply an effect on the rest of the world, kept by the sector while it is simulated in parallel */
+	void ApplyWorldEffect(TFunction<void()> Effect);
+
 	/*----------------------------------------------------
 		Protected data
 	----------------------------------------------------*/
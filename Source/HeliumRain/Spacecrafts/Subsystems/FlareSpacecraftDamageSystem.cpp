@@ -14,7 +14,7 @@
 
 #include "../FlareEngine.h"
 #include "../FlareOrbitalEngine.h"
-#include "../FlareShell.h"
+#include "../FlareShellManager.h"
 
 #include "Engine/StaticMeshActor.h"
 
@@ -549,7 +549,7 @@ void UFlareSpacecraftDamageSystem::OnCollision(class AActor* Other, FVector HitL
 
 	// If the other actor is a projectile, specific weapon damage code is done in the projectile hit
 	// handler: in this case we ignore the collision
-	AFlareShell* OtherProjectile = Cast<AFlareShell>(Other);
+	AFlareShellManager* OtherProjectile = Cast<AFlareShellManager>(Other);
 	if (OtherProjectile)
 	{
 		return;
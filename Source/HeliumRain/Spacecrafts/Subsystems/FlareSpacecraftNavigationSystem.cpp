@@ -141,7 +141,11 @@ void UFlareSpacecraftNavigationSystem::Initialize(AFlareSpacecraft* OwnerSpacecr
 		AngularMaxVelocity = Description->AngularMaxVelocity;
 	}
 
-	// Initialize
+	UpdateEngineTables();
+}
+
+void UFlareSpacecraftNavigationSystem::UpdateEngineTables()
+{
 	XEngines.Key.Empty();
 	YEngines.Key.Empty();
 	ZEngines.Key.Empty();
@@ -149,10 +153,10 @@ void UFlareSpacecraftNavigationSystem::Initialize(AFlareSpacecraft* OwnerSpacecr
 	YEngines.Value.Empty();
 	ZEngines.Value.Empty();
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+		UFlareEngine* Engine = Engines[EngineIndex];
 
 		FVector LocalThrustAxis = Spacecraft->Airframe->GetComponentToWorld().Inverse().GetRotation().RotateVector(Engine->GetThrustAxis());
 
@@ -904,10 +908,10 @@ void UFlareSpacecraftNavigationSystem::ConfirmDock(AFlareSpacecraft* DockStation
 	DockConstraint->SetConstrainedComponents(Spacecraft->Airframe, NAME_None, AttachStation->Airframe,NAME_None);
 
 	// Cut engines
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+		UFlareEngine* Engine = Engines[EngineIndex];
 		Engine->SetAlpha(0.0f);
 	}
 
@@ -1102,7 +1106,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateLinearAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 
 	FVector DeltaPosition = (TargetLocation - Spacecraft->GetActorLocation()) / 100; // Distance in meters
 	FVector DeltaPositionDirection = DeltaPosition;
@@ -1191,7 +1195,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(FFlareShipComma
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateAngularAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 
 	// Rotation data
 	FVector TargetAxis = Command.RotationTarget;
@@ -1271,7 +1275,7 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetAngularVelocityToAlignAxis);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 
 	FVector AngularVelocity = Spacecraft->Airframe->GetPhysicsAngularVelocityInDegrees();
 	FVector WorldShipAxis = Spacecraft->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
@@ -1351,26 +1355,22 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_Physics);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 
 	if(Spacecraft->GetParent()->GetDamageSystem()->IsUncontrollable())
 	{
 		// Shutdown engines
 		for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 		{
-			UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+			UFlareEngine* Engine = Engines[EngineIndex];
 			Engine->SetAlpha(0);
 		}
 
 		return;
 	}
 
-	TArray<float> EnginesAlpha;
-
-	for(int i = 0 ; i < Engines.Num() ; i++)
-	{
-		EnginesAlpha.Add(0.f);
-	}
+	EnginesAlpha.Reset();
+	EnginesAlpha.AddZeroed(Engines.Num());
 
 	bool Log = false;
 	if (false && Spacecraft == Spacecraft->GetGame()->GetPC()->GetShipPawn())
@@ -1404,7 +1404,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 
 	float SharableBoostAcceleration = 0.f;
 
-	auto ProcessVelocityEngineAxis = [&](float VelocityTargetInAxis, FVector Axis, TPair<TArray<int>, TArray<int>> AxisEngines)
+	auto ProcessVelocityEngineAxis = [&](float VelocityTargetInAxis, FVector Axis, const TPair<TArray<int>, TArray<int>>& AxisEngines)
 	{
 		float LocalLinearVelocityInAxis = FVector::DotProduct(Axis, LocalLinearVelocity);
 		float DeltaV = VelocityTargetInAxis - LocalLinearVelocityInAxis;
@@ -1413,7 +1413,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		FLOGV("    - LocalLinearVelocityInAxis=%f", LocalLinearVelocityInAxis);
 		FLOGV("    - DeltaV=%f", DeltaV);*/
 
-		TArray<int>& UsefulEngines = DeltaV > 0 ? AxisEngines.Key: AxisEngines.Value;
+		const TArray<int>& UsefulEngines = DeltaV > 0 ? AxisEngines.Key: AxisEngines.Value;
 
 		//FLOGV("    - UsefulEngines=%d", UsefulEngines.Num());
 
@@ -1461,7 +1461,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 
 			for(int EngineIndex : UsefulEngines)
 			{
-				UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+				UFlareEngine* Engine = Engines[EngineIndex];
 
 
 				if (!Engine->IsA(UFlareOrbitalEngine::StaticClass()))
@@ -1494,11 +1494,11 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		}
 	};
 
-	auto ProcessAccelerationEngineAxis = [&](float AccelerationTargetInAxis, FVector Axis, TPair<TArray<int>, TArray<int>> AxisEngines)
+	auto ProcessAccelerationEngineAxis = [&](float AccelerationTargetInAxis, FVector Axis, const TPair<TArray<int>, TArray<int>>& AxisEngines)
 	{
 		float ClampedAccelerationTargetInAxis = FMath::Clamp(AccelerationTargetInAxis, -1.f, 1.f);
 
-		TArray<int>& UsefulEngines = ClampedAccelerationTargetInAxis > 0 ? AxisEngines.Key: AxisEngines.Value;
+		const TArray<int>& UsefulEngines = ClampedAccelerationTargetInAxis > 0 ? AxisEngines.Key: AxisEngines.Value;
 
 		if (!FMath::IsNearlyZero(ClampedAccelerationTargetInAxis))
 		{
@@ -1587,7 +1587,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 	// Update engine alpha
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+		UFlareEngine* Engine = Engines[EngineIndex];
 		FVector ThrustAxis = Engine->GetThrustAxis();
 		float LinearAlpha = EnginesAlpha[EngineIndex];
 		float AngularAlpha = 0;
@@ -1624,7 +1624,7 @@ void UFlareSpacecraftNavigationSystem::UpdateCOM()
 		Getters (Attitude)
 ----------------------------------------------------*/
 
-FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const
+FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(const TArray<UFlareEngine*>& Engines, FVector Axis, bool WithOrbitalEngines) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxThrustInAxis);
 
@@ -1632,7 +1632,7 @@ FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorC
 	FVector TotalMaxThrust = FVector::ZeroVector;
 	for (int32 i = 0; i < Engines.Num(); i++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
+		UFlareEngine* Engine = Engines[i];
 
 		FVector WorldThrustAxis = Engine->GetThrustAxis();
 		float Ratio = FVector::DotProduct(WorldThrustAxis, Axis);
@@ -1656,12 +1656,12 @@ FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorC
 	return TotalMaxThrust;
 }
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(TArray<UActorComponent*>& Engines, TArray<int>& UsefulEngines, bool WithOrbitalEngines)
+float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(const TArray<UFlareEngine*>& Engines, const TArray<int>& UsefulEngines, bool WithOrbitalEngines)
 {
 	float TotalMaxThrust = 0.f;
 	for (int i : UsefulEngines)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
+		UFlareEngine* Engine = Engines[i];
 
 		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
 		{
@@ -1680,7 +1680,7 @@ float UFlareSpacecraftNavigationSystem::GetTotalMaxThrustWithEngines(TArray<UAct
 }
 
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueAxis, bool WithDamages) const
+float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(const TArray<UFlareEngine*>& Engines, FVector TorqueAxis, bool WithDamages) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxTorqueInAxis);
 
@@ -1688,7 +1688,7 @@ float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorCom
 	float TotalMaxTorque = 0;
 
 	for (int32 i = 0; i < Engines.Num(); i++) {
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
+		UFlareEngine* Engine = Engines[i];
 
 		// Ignore orbital engines for torque computation
 		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
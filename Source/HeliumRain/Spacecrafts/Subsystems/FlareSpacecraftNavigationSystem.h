@@ -4,6 +4,7 @@
 #include "FlareSpacecraftNavigationSystem.generated.h"
 
 class AFlareSpacecraft;
+class UFlareEngine;
 
 class UPhysicsConstraintComponent;
 
@@ -256,6 +257,9 @@ public:
 	/** Update the ship's center of mass */
 	void UpdateCOM();
 
+	/** Sort the spacecraft engines by thrust axis */
+	void UpdateEngineTables();
+
 protected:
 
 
@@ -299,6 +303,7 @@ protected:
 	TPair<TArray<int>, TArray<int>> XEngines;
 	TPair<TArray<int>, TArray<int>> YEngines;
 	TPair<TArray<int>, TArray<int>> ZEngines;
+	TArray<float>                   EnginesAlpha;
 
 public:
 
@@ -312,7 +317,7 @@ public:
 	 * Axis : Axis of the thurst
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	FVector GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
+	FVector GetTotalMaxThrustInAxis(const TArray<UFlareEngine*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
 
 
 	/**
@@ -321,7 +326,7 @@ public:
 	 * UsefulEngines : engine to sum
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	float GetTotalMaxThrustWithEngines(TArray<UActorComponent*>& Engines, TArray<int>& UsefulEngines, bool WithOrbitalEngines);
+	float GetTotalMaxThrustWithEngines(const TArray<UFlareEngine*>& Engines, const TArray<int>& UsefulEngines, bool WithOrbitalEngines);
 
 	/**
 	 * Return the maximum torque the ship can provide in a specific axis.
@@ -329,7 +334,7 @@ public:
 	 * TorqueDirection : Axis of the torque
 	 * WithDamages : if true, use current thrust value and not theorical thrust value
 	 */
-	float GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueDirection, bool WithDamages) const;
+	float GetTotalMaxTorqueInAxis(const TArray<UFlareEngine*>& Engines, FVector TorqueDirection, bool WithDamages) const;
 
 
 	/*----------------------------------------------------
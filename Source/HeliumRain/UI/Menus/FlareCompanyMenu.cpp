@@ -687,19 +687,13 @@ void SFlareCompanyMenu::ShowCompanyLog(UFlareCompany* Target)
 {
 	CompanyLog->ClearChildren();
 	
-	// Compute balances
+	// Compute balances of the displayed days
+	int64 FirstDisplayedDate = MenuManager->GetGame()->GetGameWorld()->GetDate() - 30;
+	const TArray<FFlareTransactionLogBalance>& Balances = Target->GetTransactionBalances();
 	TMap<int64, int64> DayBalances;
-	for (const FFlareTransactionLogEntry& Entry : Target->GetTransactionLog())
+	for (int32 BalanceIndex = Balances.Num() - 1; BalanceIndex >= 0 && Balances[BalanceIndex].Date >= FirstDisplayedDate; BalanceIndex--)
 	{
-		int64* PreviousBalance = DayBalances.Find(Entry.Date);
-		if (PreviousBalance)
-		{
-			DayBalances.Add(Entry.Date, Entry.Amount + *PreviousBalance);			
-		}
-		else
-		{
-			DayBalances.Add(Entry.Date, Entry.Amount);
-		}
+		DayBalances.FindOrAdd(Balances[BalanceIndex].Date) += Balances[BalanceIndex].Amount;
 	}
 
 	// Generate the full log
@@ -766,11 +760,11 @@ void SFlareCompanyMenu::ShowCompanyAccounting(UFlareCompany* Target)
 	}
 
 	// Compute balances
-	for (const FFlareTransactionLogEntry& Entry : Target->GetTransactionLog())
+	for (const FFlareTransactionLogBalance& Balance : Target->GetTransactionBalances())
 	{
-		if (UFlareGameTools::GetYearFromDate(Entry.Date) == CurrentAccountingYear)
+		if (UFlareGameTools::GetYearFromDate(Balance.Date) == CurrentAccountingYear)
 		{
-			Balances[Entry.Type] += Entry.Amount;
+			Balances[Balance.Type.GetValue()] += Balance.Amount;
 		}
 	}
 
@@ -20,6 +20,8 @@
 void SFlareResourcePricesMenu::Construct(const FArguments& InArgs)
 {
 	MenuManager = InArgs._MenuManager;
+	TargetSector = NULL;
+	SnapshotDate = 0;
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 
 	// Build structure
@@ -311,6 +313,9 @@ void SFlareResourcePricesMenu::Enter(UFlareSimulatedSector* Sector)
 	IsCurrentSortDescending = false;
 	CurrentSortType = EFlareEconomySort::ES_Resource;
 
+	// Damages in the active sector are not tracked by the resource stats snapshot
+	MenuManager->GetGame()->GetGameWorld()->InvalidateResourceStats();
+
 	// Fill sector list
 	TargetSector = Sector;
 	KnownSectors = MenuManager->GetPC()->GetCompany()->GetKnownSectors();
@@ -325,49 +330,59 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 	ResourcePriceList->ClearChildren();
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 
-	// Get resource list
-	TArray<UFlareResourceCatalogEntry*> ResourceList = MenuManager->GetGame()->GetResourceCatalog()->GetResourceList();
+	if (TargetSector == NULL)
+	{
+		return;
+	}
+
+	// Snapshot the resource data once, the sort and the rows only read it
+	UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
+	const TArray<WorldHelper::FlareResourceStats>& Stats = GameWorld->GetSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
+	SnapshotDate = GameWorld->GetDate();
+	ResourceRows.Empty();
+
+	for (UFlareResourceCatalogEntry* Entry : MenuManager->GetGame()->GetResourceCatalog()->GetResourceList())
+	{
+		FResourceRow Row;
+		Row.Resource = &Entry->Data;
+		Row.Stats = Stats[Entry->Data.CatalogIndex];
+		Row.Price = TargetSector->GetResourcePrice(Row.Resource, EFlareResourcePriceContext::Default);
+		Row.LastPrice = TargetSector->GetResourcePrice(Row.Resource, EFlareResourcePriceContext::Default, 30);
+		Row.PrecisePrice = TargetSector->GetPreciseResourcePrice(Row.Resource);
+		Row.Variation = (((float)Row.Price) / ((float)Row.LastPrice) - 1);
+		ResourceRows.Add(Row);
+	}
 
 	// Apply the current sort
-	ResourceList.Sort([this](UFlareResourceCatalogEntry& R1, UFlareResourceCatalogEntry& R2)
+	ResourceRows.Sort([this](const FResourceRow& R1, const FResourceRow& R2)
 	{
 		bool Result = false;
 
-		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(this->TargetSector, IncludeTradingHubsButton->IsActive());
-		int64 ResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default);
-		int64 ResourcePrice2 = this->TargetSector->GetResourcePrice(&R2.Data, EFlareResourcePriceContext::Default);
-		int64 LastResourcePrice1 = this->TargetSector->GetResourcePrice(&R1.Data, EFlareResourcePriceContext::Default, 30);
-		int64 LastResourcePrice2 = this->TargetSector->GetResourcePrice(&R2.Data, EFlareResourcePriceContext::Default, 30);
-		float Variation1 = (((float)ResourcePrice1) / ((float)LastResourcePrice1) - 1);
-		float Variation2 = (((float)ResourcePrice2) / ((float)LastResourcePrice2) - 1);
-
-		// Apply sort
 		switch (this->CurrentSortType)
 		{
 		case EFlareEconomySort::ES_Resource:
-			Result = R1.Data.DisplayIndex > R2.Data.DisplayIndex;
+			Result = R1.Resource->DisplayIndex > R2.Resource->DisplayIndex;
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats[&R1.Data].Production > Stats[&R2.Data].Production);
+			Result = (R1.Stats.Production > R2.Stats.Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats[&R1.Data].Consumption > Stats[&R2.Data].Consumption);
+			Result = (R1.Stats.Consumption > R2.Stats.Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats[&R1.Data].Stock > Stats[&R2.Data].Stock);
+			Result = (R1.Stats.Stock > R2.Stats.Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats[&R1.Data].Capacity > Stats[&R2.Data].Capacity);
+			Result = (R1.Stats.Capacity > R2.Stats.Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
-			Result = ResourcePrice1 > ResourcePrice2;
+			Result = R1.Price > R2.Price;
 			break;
 		case EFlareEconomySort::ES_Variation:
-			Result = Variation1 > Variation2;
+			Result = R1.Variation > R2.Variation;
 			break;
 		case EFlareEconomySort::ES_Transport:
-			Result = R1.Data.TransportFee > R2.Data.TransportFee;
+			Result = R1.Resource->TransportFee > R2.Resource->TransportFee;
 			break;
 		}
 
@@ -375,9 +390,10 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 	});
 
 	// Resource prices
-	for (int32 ResourceIndex = 0; ResourceIndex < ResourceList.Num(); ResourceIndex++)
+	for (int32 ResourceIndex = 0; ResourceIndex < ResourceRows.Num(); ResourceIndex++)
 	{
-		FFlareResourceDescription& Resource = ResourceList[ResourceIndex]->Data;
+		const FResourceRow& Row = ResourceRows[ResourceIndex];
+		FFlareResourceDescription& Resource = *Row.Resource;
 		ResourcePriceList->AddSlot()
 		.Padding(FMargin(1))
 		[
@@ -419,7 +435,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourceProductionInfo, &Resource)
+						.Text(GetResourceProductionInfo(Row))
 					]
 				]
 
@@ -435,7 +451,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourceConsumptionInfo, &Resource)
+						.Text(GetResourceConsumptionInfo(Row))
 					]
 				]
 
@@ -451,7 +467,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourceStockInfo, &Resource)
+						.Text(GetResourceStockInfo(Row))
 					]
 				]
 
@@ -467,7 +483,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourceCapacityInfo, &Resource)
+						.Text(GetResourceCapacityInfo(Row))
 					]
 				]
 
@@ -483,8 +499,8 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.ColorAndOpacity(this, &SFlareResourcePricesMenu::GetPriceColor, &Resource)
-						.Text(this, &SFlareResourcePricesMenu::GetResourcePriceInfo, &Resource)
+						.ColorAndOpacity(GetPriceColor(Row))
+						.Text(GetResourcePriceInfo(Row))
 					]
 				]
 
@@ -500,7 +516,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourcePriceVariationInfo, &Resource)
+						.Text(GetResourcePriceVariationInfo(Row))
 					]
 				]
 
@@ -516,7 +532,7 @@ void SFlareResourcePricesMenu::GenerateResourceList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareResourcePricesMenu::GetResourceTransportFeeInfo, &Resource)
+						.Text(GetResourceTransportFeeInfo(Row))
 					]
 				]
 
@@ -545,9 +561,21 @@ void SFlareResourcePricesMenu::Exit()
 	SetEnabled(false);
 	SetVisibility(EVisibility::Collapsed);
 	ResourcePriceList->ClearChildren();
+	ResourceRows.Empty();
 	TargetSector = NULL;
 }
 
+void SFlareResourcePricesMenu::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Days passed since the snapshot
+	if (IsEnabled() && TargetSector && MenuManager->GetGame()->GetGameWorld()->GetDate() != SnapshotDate)
+	{
+		GenerateResourceList();
+	}
+}
+
 
 /*----------------------------------------------------
 	Callbacks
@@ -597,7 +625,7 @@ FText SFlareResourcePricesMenu::GetSectorName() const
 	return LOCTEXT("NoSectorSelected", "No sector selected");
 }
 
-FSlateColor SFlareResourcePricesMenu::GetPriceColor(FFlareResourceDescription* Resource) const
+FSlateColor SFlareResourcePricesMenu::GetPriceColor(const FResourceRow& Row) const
 {
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 	if (TargetSector)
@@ -606,9 +634,7 @@ FSlateColor SFlareResourcePricesMenu::GetPriceColor(FFlareResourceDescription* R
 		FLinearColor MeanPriceColor = Theme.NeutralColor;
 		FLinearColor LowPriceColor = Theme.EnemyColor;
 
-		float ResourcePrice = TargetSector->GetPreciseResourcePrice(Resource);
-
-		float PriceRatio = (ResourcePrice - Resource->MinPrice) / (float) (Resource->MaxPrice - Resource->MinPrice);
+		float PriceRatio = (Row.PrecisePrice - Row.Resource->MinPrice) / (float) (Row.Resource->MaxPrice - Row.Resource->MinPrice);
 
 		if(PriceRatio  > 0.5)
 		{
@@ -630,92 +656,82 @@ void SFlareResourcePricesMenu::OnShowWorldInfosClicked(FFlareResourceDescription
 	MenuManager->OpenMenu(EFlareMenu::MENU_WorldEconomy, Data);
 }
 
-FText SFlareResourcePricesMenu::GetResourceProductionInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourceProductionInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Production, &Format));
+			FText::AsNumber(Row.Stats.Production, &Format));
 	}
 
 	return FText();
 }
 
-FText SFlareResourcePricesMenu::GetResourceConsumptionInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourceConsumptionInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Consumption, &Format));
+			FText::AsNumber(Row.Stats.Consumption, &Format));
 	}
 
 	return FText();
 }
 
-FText SFlareResourcePricesMenu::GetResourceStockInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourceStockInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Stock));
+			FText::AsNumber(Row.Stats.Stock));
 	}
 
 	return FText();
 }
 
 
-FText SFlareResourcePricesMenu::GetResourceCapacityInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourceCapacityInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(TargetSector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[Resource].Capacity));
+			FText::AsNumber(Row.Stats.Capacity));
 	}
 
 	return FText();
 }
 
-FText SFlareResourcePricesMenu::GetResourcePriceInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourcePriceInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
 		FNumberFormattingOptions MoneyFormat;
 		MoneyFormat.MaximumFractionalDigits = 2;
 
-		int64 ResourcePrice = TargetSector->GetResourcePrice(Resource, EFlareResourcePriceContext::Default);
-
 		return FText::Format(LOCTEXT("ResourceMainPriceFormat", "{0} credits"),
-			FText::AsNumber(ResourcePrice / 100.0f, &MoneyFormat));
+			FText::AsNumber(Row.Price / 100.0f, &MoneyFormat));
 	}
 
 	return FText();
 }
 
-FText SFlareResourcePricesMenu::GetResourcePriceVariationInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourcePriceVariationInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
 		FNumberFormattingOptions MoneyFormat;
 		MoneyFormat.MaximumFractionalDigits = 2;
 
-		int32 MeanDuration = 30;
-		int64 ResourcePrice = TargetSector->GetResourcePrice(Resource, EFlareResourcePriceContext::Default);
-		int64 LastResourcePrice = TargetSector->GetResourcePrice(Resource, EFlareResourcePriceContext::Default, MeanDuration);
-
-		if(ResourcePrice != LastResourcePrice)
+		if(Row.Price != Row.LastPrice)
 		{
-			float Variation = (((float) ResourcePrice) / ((float) LastResourcePrice) - 1);
+			float Variation = Row.Variation;
 
 			if(FMath::Abs(Variation) >= 0.0001)
 			{
@@ -733,7 +749,7 @@ FText SFlareResourcePricesMenu::GetResourcePriceVariationInfo(FFlareResourceDesc
 	return FText();
 }
 
-FText SFlareResourcePricesMenu::GetResourceTransportFeeInfo(FFlareResourceDescription* Resource) const
+FText SFlareResourcePricesMenu::GetResourceTransportFeeInfo(const FResourceRow& Row) const
 {
 	if (TargetSector)
 	{
@@ -741,7 +757,7 @@ FText SFlareResourcePricesMenu::GetResourceTransportFeeInfo(FFlareResourceDescri
 		MoneyFormat.MaximumFractionalDigits = 2;
 
 		return FText::Format(LOCTEXT("ResourceMainPriceFormat", "{0} credits"),
-			FText::AsNumber(Resource->TransportFee / 100.0f, &MoneyFormat));
+			FText::AsNumber(Row.Resource->TransportFee / 100.0f, &MoneyFormat));
 	}
 
 	return FText();
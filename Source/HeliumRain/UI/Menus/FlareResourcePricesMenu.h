@@ -4,6 +4,7 @@
 #include "../Components/FlareButton.h"
 #include "../Components/FlareDropList.h"
 #include "../FlareUITypes.h"
+#include "../../Game/FlareWorldHelper.h"
 
 
 class AFlareMenuManager;
@@ -43,11 +44,26 @@ public:
 	/** Exit this menu */
 	void Exit();
 
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Snapshot the resource data of the target sector and build the list */
 	void GenerateResourceList();
 
 
 protected:
 
+	/** Economy data of a resource in the target sector, computed when the list is generated */
+	struct FResourceRow
+	{
+		FFlareResourceDescription*              Resource;
+		WorldHelper::FlareResourceStats         Stats;
+		int64                                   Price;
+		int64                                   LastPrice;
+		float                                   PrecisePrice;
+		float                                   Variation;
+	};
+
+
 	/*----------------------------------------------------
 		Callbacks
 	----------------------------------------------------*/
@@ -60,31 +76,31 @@ protected:
 
 	FText GetSectorName() const;
 
-	FSlateColor GetPriceColor(FFlareResourceDescription* Resource) const;
+	FSlateColor GetPriceColor(const FResourceRow& Row) const;
 
 	/** On show world infos clicked */
 	void OnShowWorldInfosClicked(FFlareResourceDescription* Resource);
 	
 	/** Get the resource production info */
-	FText GetResourceProductionInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourceProductionInfo(const FResourceRow& Row) const;
 
 	/** Get the resource consumption info */
-	FText GetResourceConsumptionInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourceConsumptionInfo(const FResourceRow& Row) const;
 
 	/** Get the resource stock info */
-	FText GetResourceStockInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourceStockInfo(const FResourceRow& Row) const;
 
 	/** Get the resource capacity info */
-	FText GetResourceCapacityInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourceCapacityInfo(const FResourceRow& Row) const;
 
 	/** Get the resource price info */
-	FText GetResourcePriceInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourcePriceInfo(const FResourceRow& Row) const;
 
 	/** Get the resource price variation info */
-	FText GetResourcePriceVariationInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourcePriceVariationInfo(const FResourceRow& Row) const;
 
 	/** Get the resource transport fee info */
-	FText GetResourceTransportFeeInfo(FFlareResourceDescription* Resource) const;
+	FText GetResourceTransportFeeInfo(const FResourceRow& Row) const;
 
 	TSharedRef<SWidget> OnGenerateSectorComboLine(UFlareSimulatedSector* Sector);
 	void OnSectorComboLineSelectionChanged(UFlareSimulatedSector* Sector, ESelectInfo::Type SelectInfo);
@@ -103,6 +119,8 @@ protected:
 	TWeakObjectPtr<class AFlareMenuManager>         MenuManager;
 	UFlareSimulatedSector*                          TargetSector;
 	TArray<UFlareSimulatedSector*>                  KnownSectors;
+	TArray<FResourceRow>                            ResourceRows;
+	int64                                           SnapshotDate;
 
 	// Slate data
 	TSharedPtr<SVerticalBox>                        ResourcePriceList;
@@ -20,6 +20,8 @@
 void SFlareWorldEconomyMenu::Construct(const FArguments& InArgs)
 {
 	MenuManager = InArgs._MenuManager;
+	TargetResource = NULL;
+	SnapshotDate = 0;
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 
 	// Build structure
@@ -348,7 +350,10 @@ void SFlareWorldEconomyMenu::Enter(FFlareResourceDescription* Resource, UFlareSi
 	{
 		TargetResource = Resource;
 	}
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
+
+	// Damages in the active sector are not tracked by the resource stats snapshot
+	MenuManager->GetGame()->GetGameWorld()->InvalidateResourceStats();
+	WorldStats = MenuManager->GetGame()->GetGameWorld()->GetWorldResourceStats(IncludeTradingHubsButton->IsActive());
 
 	// Default state
 	IsCurrentSortDescending = false;
@@ -378,47 +383,52 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 		return;
 	}
 
-	// Get the sector list
-	TArray<UFlareSimulatedSector*>& Sectors = MenuManager->GetPC()->GetCompany()->GetVisitedSectors();
+	// Snapshot the sector data once, the sort and the rows only read it
+	UFlareWorld* GameWorld = MenuManager->GetGame()->GetGameWorld();
+	bool IncludeTradingHubs = IncludeTradingHubsButton->IsActive();
+	SnapshotDate = GameWorld->GetDate();
+	SectorRows.Empty();
+
+	for (UFlareSimulatedSector* Sector : MenuManager->GetPC()->GetCompany()->GetVisitedSectors())
+	{
+		FSectorRow Row;
+		Row.Sector = Sector;
+		Row.Stats = GameWorld->GetSectorResourceStats(Sector, IncludeTradingHubs)[TargetResource->CatalogIndex];
+		Row.Price = Sector->GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
+		Row.LastPrice = Sector->GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, 30);
+		Row.PrecisePrice = Sector->GetPreciseResourcePrice(TargetResource);
+		Row.Variation = (((float)Row.Price) / ((float)Row.LastPrice) - 1);
+		Row.SectorName = Sector->GetSectorName().ToString();
+		SectorRows.Add(Row);
+	}
 
 	// Apply the current sort
-	Sectors.Sort([this](UFlareSimulatedSector& S1, UFlareSimulatedSector& S2)
+	SectorRows.Sort([this](const FSectorRow& S1, const FSectorRow& S2)
 	{
 		bool Result = false;
 
-		// Get sorting data
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats1 = SectorHelper::ComputeSectorResourceStats(&S1, IncludeTradingHubsButton->IsActive());
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats2 = SectorHelper::ComputeSectorResourceStats(&S2, IncludeTradingHubsButton->IsActive());
-		int64 ResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
-		int64 ResourcePrice2 = S2.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
-		int64 LastResourcePrice1 = S1.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, 30);
-		int64 LastResourcePrice2 = S2.GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, 30);
-		float Variation1 = (((float)ResourcePrice1) / ((float)LastResourcePrice1) - 1);
-		float Variation2 = (((float)ResourcePrice2) / ((float)LastResourcePrice2) - 1);
-
-		// Apply sort
 		switch (this->CurrentSortType)
 		{
 		case EFlareEconomySort::ES_Sector:
-			Result = S1.GetSectorName().ToString() > S2.GetSectorName().ToString();
+			Result = S1.SectorName > S2.SectorName;
 			break;
 		case EFlareEconomySort::ES_Production:
-			Result = (Stats1[this->TargetResource].Production > Stats2[this->TargetResource].Production);
+			Result = (S1.Stats.Production > S2.Stats.Production);
 			break;
 		case EFlareEconomySort::ES_Consumption:
-			Result = (Stats1[this->TargetResource].Consumption > Stats2[this->TargetResource].Consumption);
+			Result = (S1.Stats.Consumption > S2.Stats.Consumption);
 			break;
 		case EFlareEconomySort::ES_Stock:
-			Result = (Stats1[this->TargetResource].Stock > Stats2[this->TargetResource].Stock);
+			Result = (S1.Stats.Stock > S2.Stats.Stock);
 			break;
 		case EFlareEconomySort::ES_Needs:
-			Result = (Stats1[this->TargetResource].Capacity > Stats2[this->TargetResource].Capacity);
+			Result = (S1.Stats.Capacity > S2.Stats.Capacity);
 			break;
 		case EFlareEconomySort::ES_Price:
-			Result = ResourcePrice1 > ResourcePrice2;
+			Result = S1.Price > S2.Price;
 			break;
 		case EFlareEconomySort::ES_Variation:
-			Result = Variation1 > Variation2;
+			Result = S1.Variation > S2.Variation;
 			break;
 		}
 
@@ -426,9 +436,10 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 	});
 
 	// Sector list
-	for (int32 SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	for (int32 SectorIndex = 0; SectorIndex < SectorRows.Num(); SectorIndex++)
 	{
-		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+		const FSectorRow& Row = SectorRows[SectorIndex];
+		UFlareSimulatedSector* Sector = Row.Sector;
 
 		SectorList->AddSlot()
 		.Padding(FMargin(0))
@@ -451,8 +462,8 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(SFlareButton)
 						.Width(ECONOMY_TABLE_BUTTON_LARGE)
-						.Text(this, &SFlareWorldEconomyMenu::GetSectorText, Sector)
-						.Color(this, &SFlareWorldEconomyMenu::GetSectorTextColor, Sector)
+						.Text(GetSectorText(Sector))
+						.Color(GetSectorTextColor(Sector))
 						.Icon(FFlareStyleSet::GetIcon("Travel"))
 						.OnClicked(this, &SFlareWorldEconomyMenu::OnOpenSector, Sector)
 					]
@@ -470,7 +481,7 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourceProductionInfo, Sector)
+						.Text(GetResourceProductionInfo(Row))
 					]
 				]
 
@@ -486,7 +497,7 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourceConsumptionInfo, Sector)
+						.Text(GetResourceConsumptionInfo(Row))
 					]
 				]
 
@@ -502,7 +513,7 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourceStockInfo, Sector)
+						.Text(GetResourceStockInfo(Row))
 					]
 				]
 
@@ -518,7 +529,7 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourceCapacityInfo, Sector)
+						.Text(GetResourceCapacityInfo(Row))
 					]
 				]
 
@@ -534,8 +545,8 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.ColorAndOpacity(this, &SFlareWorldEconomyMenu::GetPriceColor, Sector)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourcePriceInfo, Sector)
+						.ColorAndOpacity(GetPriceColor(Row))
+						.Text(GetResourcePriceInfo(Row))
 					]
 				]
 
@@ -551,7 +562,7 @@ void SFlareWorldEconomyMenu::GenerateSectorList()
 					[
 						SNew(STextBlock)
 						.TextStyle(&Theme.TextFont)
-						.Text(this, &SFlareWorldEconomyMenu::GetResourcePriceVariationInfo, Sector, TSharedPtr<int32>(new int32(30)))
+						.Text(GetResourcePriceVariationInfo(Row))
 					]
 				]
 
@@ -582,6 +593,19 @@ void SFlareWorldEconomyMenu::Exit()
 	SetEnabled(false);
 	SetVisibility(EVisibility::Collapsed);
 	SectorList->ClearChildren();
+	SectorRows.Empty();
+}
+
+void SFlareWorldEconomyMenu::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Days passed since the snapshot
+	if (IsEnabled() && TargetResource && MenuManager->GetGame()->GetGameWorld()->GetDate() != SnapshotDate)
+	{
+		WorldStats = MenuManager->GetGame()->GetGameWorld()->GetWorldResourceStats(IncludeTradingHubsButton->IsActive());
+		GenerateSectorList();
+	}
 }
 
 
@@ -623,7 +647,7 @@ void SFlareWorldEconomyMenu::ToggleSortType(EFlareEconomySort::Type Type)
 	GenerateSectorList();
 }
 
-FSlateColor SFlareWorldEconomyMenu::GetPriceColor(UFlareSimulatedSector* Sector) const
+FSlateColor SFlareWorldEconomyMenu::GetPriceColor(const FSectorRow& Row) const
 {
 	const FFlareStyleCatalog& Theme = FFlareStyleSet::GetDefaultTheme();
 	if (TargetResource)
@@ -633,9 +657,7 @@ FSlateColor SFlareWorldEconomyMenu::GetPriceColor(UFlareSimulatedSector* Sector)
 		FLinearColor MeanPriceColor = Theme.NeutralColor;
 		FLinearColor LowPriceColor = Theme.EnemyColor;
 
-		float ResourcePrice = Sector->GetPreciseResourcePrice(TargetResource);
-
-		float PriceRatio = (ResourcePrice - TargetResource->MinPrice) / (float)(TargetResource->MaxPrice - TargetResource->MinPrice);
+		float PriceRatio = (Row.PrecisePrice - TargetResource->MinPrice) / (float)(TargetResource->MaxPrice - TargetResource->MinPrice);
 
 		if (PriceRatio > 0.5)
 		{
@@ -686,14 +708,14 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 {
 	if (TargetResource)
 	{
-		if (WorldStats.Contains(TargetResource))
+		if (WorldStats.IsValidIndex(TargetResource->CatalogIndex))
 		{
 			FNumberFormattingOptions Format;
 			Format.MaximumFractionalDigits = 1;
 
 			// Balance info
 			FText BalanceText;
-			float Balance = WorldStats[TargetResource].Balance;
+			float Balance = WorldStats[TargetResource->CatalogIndex].Balance;
 			if (Balance > 0)
 			{
 				BalanceText = FText::Format(LOCTEXT("BalanceInfoPlusFormat", "+{0} / day"),
@@ -708,11 +730,11 @@ FText SFlareWorldEconomyMenu::GetResourceInfo() const
 
 			FText Part1 = FText::Format(LOCTEXT("StockInfoFormatPart1", "\u2022Transport fee: {0} credits\n\u2022 Worldwide stock: {1}\n\u2022 Worldwide needs: {2}\n"),
 										UFlareGameTools::DisplayMoney(TargetResource->TransportFee),
-										FText::AsNumber(WorldStats[TargetResource].Stock),
-										FText::AsNumber(WorldStats[TargetResource].Capacity));
+										FText::AsNumber(WorldStats[TargetResource->CatalogIndex].Stock),
+										FText::AsNumber(WorldStats[TargetResource->CatalogIndex].Capacity));
 			FText Part2 = FText::Format(LOCTEXT("StockInfoFormatPart2", "\u2022 Worldwide production: {0} / day\n\u2022 Worldwide usage: {1} / day\n"),
-										FText::AsNumber(WorldStats[TargetResource].Production, &Format),
-										FText::AsNumber(WorldStats[TargetResource].Consumption, &Format));
+										FText::AsNumber(WorldStats[TargetResource->CatalogIndex].Production, &Format),
+										FText::AsNumber(WorldStats[TargetResource->CatalogIndex].Consumption, &Format));
 
 			// Generate info
 			return FText::Format(LOCTEXT("StockInfoFormat",
@@ -738,91 +760,82 @@ FSlateColor SFlareWorldEconomyMenu::GetSectorTextColor(UFlareSimulatedSector* Se
 	return Sector->GetSectorFriendlynessColor(MenuManager->GetPC()->GetCompany());
 }
 
-FText SFlareWorldEconomyMenu::GetResourceProductionInfo(UFlareSimulatedSector* Sector) const
+FText SFlareWorldEconomyMenu::GetResourceProductionInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainProductionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Production, &Format));
+			FText::AsNumber(Row.Stats.Production, &Format));
 	}
 
 	return FText();
 }
 
-FText SFlareWorldEconomyMenu::GetResourceConsumptionInfo(UFlareSimulatedSector* Sector) const
+FText SFlareWorldEconomyMenu::GetResourceConsumptionInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
 		FNumberFormattingOptions Format;
 		Format.MaximumFractionalDigits = 1;
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainConsumptionFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Consumption, &Format));
+			FText::AsNumber(Row.Stats.Consumption, &Format));
 	}
 
 	return FText();
 }
 
-FText SFlareWorldEconomyMenu::GetResourceStockInfo(UFlareSimulatedSector* Sector) const
+FText SFlareWorldEconomyMenu::GetResourceStockInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainStockFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Stock));
+			FText::AsNumber(Row.Stats.Stock));
 	}
 
 	return FText();
 }
 
 
-FText SFlareWorldEconomyMenu::GetResourceCapacityInfo(UFlareSimulatedSector* Sector) const
+FText SFlareWorldEconomyMenu::GetResourceCapacityInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
 
-		TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> Stats = SectorHelper::ComputeSectorResourceStats(Sector, IncludeTradingHubsButton->IsActive());
 		return FText::Format(LOCTEXT("ResourceMainCapacityFormat", "{0}"),
-			FText::AsNumber(Stats[TargetResource].Capacity));
+			FText::AsNumber(Row.Stats.Capacity));
 	}
 
 	return FText();
 }
 
-FText SFlareWorldEconomyMenu::GetResourcePriceInfo(UFlareSimulatedSector* Sector) const
+FText SFlareWorldEconomyMenu::GetResourcePriceInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
 		FNumberFormattingOptions MoneyFormat;
 		MoneyFormat.MaximumFractionalDigits = 2;
 
-		int64 ResourcePrice = Sector->GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
-
 		return FText::Format(LOCTEXT("ResourceMainPriceFormat", "{0} credits"),
-			FText::AsNumber(ResourcePrice / 100.0f, &MoneyFormat));
+			FText::AsNumber(Row.Price / 100.0f, &MoneyFormat));
 	}
 
 	return FText();
 }
 
-FText SFlareWorldEconomyMenu::GetResourcePriceVariationInfo(UFlareSimulatedSector* Sector, TSharedPtr<int32> MeanDuration) const
+FText SFlareWorldEconomyMenu::GetResourcePriceVariationInfo(const FSectorRow& Row) const
 {
 	if (TargetResource)
 	{
 		FNumberFormattingOptions MoneyFormat;
 		MoneyFormat.MaximumFractionalDigits = 2;
 
-		int64 ResourcePrice = Sector->GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default);
-		int64 LastResourcePrice = Sector->GetResourcePrice(TargetResource, EFlareResourcePriceContext::Default, *MeanDuration);
-
-		if(ResourcePrice != LastResourcePrice)
+		if(Row.Price != Row.LastPrice)
 		{
-			float Variation = (((float) ResourcePrice) / ((float) LastResourcePrice) - 1);
+			float Variation = Row.Variation;
 
 			if(FMath::Abs(Variation) >= 0.0001)
 			{
@@ -903,8 +916,8 @@ void SFlareWorldEconomyMenu::OnOpenSectorPrices(UFlareSimulatedSector* Sector)
 
 void SFlareWorldEconomyMenu::OnIncludeTradingHubsToggle()
 {
+	WorldStats = MenuManager->GetGame()->GetGameWorld()->GetWorldResourceStats(IncludeTradingHubsButton->IsActive());
 	GenerateSectorList();
-	WorldStats = WorldHelper::ComputeWorldResourceStats(MenuManager->GetGame(), IncludeTradingHubsButton->IsActive());
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,6 +3,7 @@
 #include "../../Flare.h"
 #include "../Components/FlareButton.h"
 #include "../Components/FlareDropList.h"
+#include "../../Game/FlareWorld.h"
 #include "../../Game/FlareWorldHelper.h"
 #include "../../Data/FlareResourceCatalogEntry.h"
 #include "../FlareUITypes.h"
@@ -44,11 +45,27 @@ public:
 	/** Exit this menu */
 	void Exit();
 
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Snapshot the sector data of the target resource and build the list */
 	void GenerateSectorList();
 
 
 protected:
 
+	/** Economy data of a sector for the target resource, computed when the list is generated */
+	struct FSectorRow
+	{
+		UFlareSimulatedSector*                  Sector;
+		WorldHelper::FlareResourceStats         Stats;
+		int64                                   Price;
+		int64                                   LastPrice;
+		float                                   PrecisePrice;
+		float                                   Variation;
+		FString                                 SectorName;
+	};
+
+
 	/*----------------------------------------------------
 		Callbacks
 	----------------------------------------------------*/
@@ -59,7 +76,7 @@ protected:
 	/** Set the current sort type to use */
 	void ToggleSortType(EFlareEconomySort::Type Type);
 
-	FSlateColor GetPriceColor(UFlareSimulatedSector* Sector) const;
+	FSlateColor GetPriceColor(const FSectorRow& Row) const;
 
 	/** Get the resource price info */
 	FText GetResourceDescription() const;
@@ -80,22 +97,22 @@ protected:
 	FSlateColor GetSectorTextColor(UFlareSimulatedSector* Sector) const;
 
 	/** Get the resource production info */
-	FText GetResourceProductionInfo(UFlareSimulatedSector* Sector) const;
+	FText GetResourceProductionInfo(const FSectorRow& Row) const;
 
 	/** Get the resource consumption info */
-	FText GetResourceConsumptionInfo(UFlareSimulatedSector* Sector) const;
+	FText GetResourceConsumptionInfo(const FSectorRow& Row) const;
 
 	/** Get the resource stock info */
-	FText GetResourceStockInfo(UFlareSimulatedSector* Sector) const;
+	FText GetResourceStockInfo(const FSectorRow& Row) const;
 
 	/** Get the resource capacity info */
-	FText GetResourceCapacityInfo(UFlareSimulatedSector* Sector) const;
+	FText GetResourceCapacityInfo(const FSectorRow& Row) const;
 
 	/** Get the resource price info */
-	FText GetResourcePriceInfo(UFlareSimulatedSector* Sector) const;
+	FText GetResourcePriceInfo(const FSectorRow& Row) const;
 
 	/** Get the resource price variation info */
-	FText GetResourcePriceVariationInfo(UFlareSimulatedSector* Sector, TSharedPtr<int32> MeanDuration) const;
+	FText GetResourcePriceVariationInfo(const FSectorRow& Row) const;
 
 	TSharedRef<SWidget> OnGenerateResourceComboLine(UFlareResourceCatalogEntry* Item);
 	void OnResourceComboLineSelectionChanged(UFlareResourceCatalogEntry* Item, ESelectInfo::Type SelectInfo);
@@ -117,7 +134,9 @@ protected:
 	// Target data
 	TWeakObjectPtr<class AFlareMenuManager>         MenuManager;
 	FFlareResourceDescription*                      TargetResource;
-	TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldStats;
+	TArray<WorldHelper::FlareResourceStats> WorldStats;
+	TArray<FSectorRow>                              SectorRows;
+	int64                                           SnapshotDate;
 
 	// Slate data
 	TSharedPtr<SVerticalBox>                        SectorList;